@@ -63,6 +63,7 @@
 #include "libavutil/time.h"
 #include "libavutil/thread.h"
 #include "libavutil/threadmessage.h"
+#include "libavutil/threadpool.h"
 #include "libavcodec/mathops.h"
 #include "libavformat/os_support.h"
 
@@ -494,7 +495,11 @@ static void ffmpeg_cleanup(int ret)
 
     if (do_benchmark) {
         int maxrss = getmaxrss() / 1024;
+        uint64_t allocated, reused;
         av_log(NULL, AV_LOG_INFO, "bench: maxrss=%ikB\n", maxrss);
+        av_buffer_get_alloc_stats(&allocated, &reused);
+        av_log(NULL, AV_LOG_INFO, "bench: buffer objects allocated=%"PRIu64" reused=%"PRIu64"\n",
+               allocated, reused);
     }
 
     for (i = 0; i < nb_filtergraphs; i++) {
@@ -632,6 +637,7 @@ static void ffmpeg_cleanup(int ret)
     av_freep(&output_files);
 
     uninit_opts();
+    av_thread_pool_uninit();
 
     avformat_network_deinit();
 
@@ -4057,8 +4063,11 @@ static int init_input_thread(int i)
     if (f->ctx->pb ? !f->ctx->pb->seekable :
         strcmp(f->ctx->iformat->name, "lavfi"))
         f->non_blocking = 1;
-    ret = av_thread_message_queue_alloc(&f->in_thread_queue,
-                                        f->thread_queue_size, sizeof(AVPacket));
+    /* packets are only sent by the input thread and only received by the
+     * main thread */
+    ret = av_thread_message_queue_alloc2(&f->in_thread_queue,
+                                         f->thread_queue_size, sizeof(AVPacket),
+                                         AV_THREAD_MESSAGE_QUEUE_FLAG_SPSC);
     if (ret < 0)
         return ret;
 
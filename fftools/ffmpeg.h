@@ -609,6 +609,7 @@ extern char *videotoolbox_pixfmt;
 
 extern int filter_nbthreads;
 extern int filter_complex_nbthreads;
+extern int filter_prewarm_frames;
 extern int vstats_version;
 
 extern const AVIOInterruptCB int_cb;
@@ -41,6 +41,7 @@
 #include "libavutil/parseutils.h"
 #include "libavutil/pixdesc.h"
 #include "libavutil/pixfmt.h"
+#include "libavutil/threadpool.h"
 
 #define DEFAULT_PASS_LOGFILENAME_PREFIX "ffmpeg2pass"
 
@@ -170,6 +171,7 @@ int frame_bits_per_raw_sample = 0;
 float max_error_rate  = 2.0/3;
 int filter_nbthreads = 0;
 int filter_complex_nbthreads = 0;
+int filter_prewarm_frames = 0;
 int vstats_version = 2;
 
 
@@ -3169,6 +3171,17 @@ static int opt_filter_complex(void *optctx, const char *opt, const char *arg)
     return 0;
 }
 
+static int opt_thread_pool(void *optctx, const char *opt, const char *arg)
+{
+    int nb_threads = parse_number_or_die(opt, arg, OPT_INT, 0, INT_MAX);
+    int ret = av_thread_pool_init(nb_threads, 0);
+
+    if (ret < 0)
+        av_log(NULL, AV_LOG_ERROR, "Could not start the shared thread pool: %s\n",
+               av_err2str(ret));
+    return ret;
+}
+
 static int opt_filter_complex_script(void *optctx, const char *opt, const char *arg)
 {
     uint8_t *graph_desc = read_file(arg);
@@ -3529,6 +3542,8 @@ const OptionDef options[] = {
         "set stream filtergraph", "filter_graph" },
     { "filter_threads",  HAS_ARG | OPT_INT,                          { &filter_nbthreads },
         "number of non-complex filter threads" },
+    { "thread_pool",    HAS_ARG | OPT_EXPERT,                        { .func_arg = opt_thread_pool },
+        "run the slice threading of all codecs and filters on one shared pool of threads", "nb_threads" },
     { "filter_script",  HAS_ARG | OPT_STRING | OPT_SPEC | OPT_OUTPUT, { .off = OFFSET(filter_scripts) },
         "read stream filtergraph description from a file", "filename" },
     { "reinit_filter",  HAS_ARG | OPT_INT | OPT_SPEC | OPT_INPUT,    { .off = OFFSET(reinit_filters) },
@@ -3537,6 +3552,8 @@ const OptionDef options[] = {
         "create a complex filtergraph", "graph_description" },
     { "filter_complex_threads", HAS_ARG | OPT_INT,                   { &filter_complex_nbthreads },
         "number of threads for -filter_complex" },
+    { "filter_prewarm_frames", HAS_ARG | OPT_INT | OPT_EXPERT,       { &filter_prewarm_frames },
+        "number of frames to preallocate in the frame pool of each filter link", "number" },
     { "lavfi",          HAS_ARG | OPT_EXPERT,                        { .func_arg = opt_filter_complex },
         "create a complex filtergraph", "graph_description" },
     { "filter_complex_script", HAS_ARG | OPT_EXPERT,                 { .func_arg = opt_filter_complex_script },
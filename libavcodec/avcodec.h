@@ -2352,6 +2352,19 @@ typedef struct AVCodecContext {
      * - encoding: set by user
      */
     int export_side_data;
+
+    /**
+     * Number of frames to preallocate in the internal frame pool of the
+     * default get_buffer2() implementation whenever it is (re)created for
+     * a new frame size or format. The memory of these frames is touched
+     * from the decoding thread, so the first frames do not pay for page
+     * faults and, with a first-touch NUMA policy, end up on the node of
+     * that thread. 0 disables prewarming.
+     *
+     * - decoding: set by user
+     * - encoding: unused
+     */
+    int prewarm_frames;
 } AVCodecContext;
 
 #if FF_API_CODEC_GET_SET
@@ -1522,6 +1522,12 @@ static int update_frame_pool(AVCodecContext *avctx, AVFrame *frame)
         pool->width  = frame->width;
         pool->height = frame->height;
 
+        for (i = 0; i < 4 && pool->pools[i]; i++) {
+            ret = av_buffer_pool_prewarm(pool->pools[i], avctx->prewarm_frames);
+            if (ret < 0)
+                goto fail;
+        }
+
         break;
         }
     case AVMEDIA_TYPE_AUDIO: {
@@ -1536,6 +1542,12 @@ static int update_frame_pool(AVCodecContext *avctx, AVFrame *frame)
             goto fail;
         }
 
+        /* planar frames take one buffer per plane from the same pool */
+        ret = av_buffer_pool_prewarm(pool->pools[0],
+                                     FFMIN((int64_t)avctx->prewarm_frames * planes, INT_MAX));
+        if (ret < 0)
+            goto fail;
+
         pool->format     = frame->format;
         pool->planes     = planes;
         pool->channels   = ch;
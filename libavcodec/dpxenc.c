@@ -31,6 +31,8 @@ typedef struct DPXContext {
     int num_components;
     int descriptor;
     int planar;
+    AVBufferPool *pool;
+    int pool_size;
 } DPXContext;
 
 static av_cold int encode_init(AVCodecContext *avctx)
@@ -196,7 +198,8 @@ static int encode_frame(AVCodecContext *avctx, AVPacket *pkt,
         need_align = size - len;
         size *= avctx->height;
     }
-    if ((ret = ff_alloc_packet2(avctx, pkt, size + HEADER_SIZE, 0)) < 0)
+    if ((ret = ff_alloc_packet_pool(avctx, pkt, &s->pool, &s->pool_size,
+                                    size + HEADER_SIZE)) < 0)
         return ret;
     buf = pkt->data;
 
@@ -276,6 +279,15 @@ static int encode_frame(AVCodecContext *avctx, AVPacket *pkt,
     return 0;
 }
 
+static av_cold int encode_close(AVCodecContext *avctx)
+{
+    DPXContext *s = avctx->priv_data;
+
+    av_buffer_pool_uninit(&s->pool);
+
+    return 0;
+}
+
 AVCodec ff_dpx_encoder = {
     .name           = "dpx",
     .long_name      = NULL_IF_CONFIG_SMALL("DPX (Digital Picture Exchange) image"),
@@ -284,6 +296,9 @@ AVCodec ff_dpx_encoder = {
     .priv_data_size = sizeof(DPXContext),
     .init           = encode_init,
     .encode2        = encode_frame,
+    .close          = encode_close,
+    .capabilities   = AV_CODEC_CAP_FRAME_THREADS,
+    .caps_internal  = FF_CODEC_CAP_PACKET_POOL,
     .pix_fmts       = (const enum AVPixelFormat[]){
         AV_PIX_FMT_GRAY8,
         AV_PIX_FMT_RGB24,    AV_PIX_FMT_RGBA, AV_PIX_FMT_ABGR,
@@ -70,6 +70,41 @@ int ff_alloc_packet2(AVCodecContext *avctx, AVPacket *avpkt, int64_t size, int64
     }
 }
 
+int ff_alloc_packet_pool(AVCodecContext *avctx, AVPacket *avpkt,
+                         AVBufferPool **pool, int *pool_size, int64_t size)
+{
+    AVBufferRef *buf;
+
+    if (avpkt->data)
+        return ff_alloc_packet2(avctx, avpkt, size, size);
+
+    if (size < 0 || size > INT_MAX - AV_INPUT_BUFFER_PADDING_SIZE) {
+        av_log(avctx, AV_LOG_ERROR, "Invalid minimum required packet size %"PRId64" (max allowed is %d)\n",
+               size, INT_MAX - AV_INPUT_BUFFER_PADDING_SIZE);
+        return AVERROR(EINVAL);
+    }
+
+    if (!*pool || *pool_size != size) {
+        av_buffer_pool_uninit(pool);
+        *pool = av_buffer_pool_init(size + AV_INPUT_BUFFER_PADDING_SIZE, NULL);
+        if (!*pool)
+            return AVERROR(ENOMEM);
+        *pool_size = size;
+    }
+
+    buf = av_buffer_pool_get(*pool);
+    if (!buf)
+        return AVERROR(ENOMEM);
+
+    av_init_packet(avpkt);
+    avpkt->buf  = buf;
+    avpkt->data = buf->data;
+    avpkt->size = size;
+    memset(avpkt->data + size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+
+    return 0;
+}
+
 /**
  * Pad last frame with silence.
  */
@@ -230,7 +265,8 @@ int attribute_align_arg avcodec_encode_audio2(AVCodecContext *avctx,
     }
 
     if (!ret) {
-        if (needs_realloc && avpkt->data) {
+        if (needs_realloc && avpkt->data &&
+            !(avctx->codec->caps_internal & FF_CODEC_CAP_PACKET_POOL)) {
             ret = av_buffer_realloc(&avpkt->buf, avpkt->size + AV_INPUT_BUFFER_PADDING_SIZE);
             if (ret >= 0)
                 avpkt->data = avpkt->buf->data;
@@ -328,7 +364,8 @@ int attribute_align_arg avcodec_encode_video2(AVCodecContext *avctx,
         if (!*got_packet_ptr)
             avpkt->size = 0;
 
-        if (needs_realloc && avpkt->data) {
+        if (needs_realloc && avpkt->data &&
+            !(avctx->codec->caps_internal & FF_CODEC_CAP_PACKET_POOL)) {
             ret = av_buffer_realloc(&avpkt->buf, avpkt->size + AV_INPUT_BUFFER_PADDING_SIZE);
             if (ret >= 0)
                 avpkt->data = avpkt->buf->data;
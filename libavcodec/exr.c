@@ -51,33 +51,13 @@
 #include "bswapdsp.h"
 #endif
 
+#include "exr.h"
 #include "exrdsp.h"
 #include "get_bits.h"
 #include "internal.h"
 #include "mathops.h"
 #include "thread.h"
 
-enum ExrCompr {
-    EXR_RAW,
-    EXR_RLE,
-    EXR_ZIP1,
-    EXR_ZIP16,
-    EXR_PIZ,
-    EXR_PXR24,
-    EXR_B44,
-    EXR_B44A,
-    EXR_DWA,
-    EXR_DWB,
-    EXR_UNKN,
-};
-
-enum ExrPixelType {
-    EXR_UINT,
-    EXR_HALF,
-    EXR_FLOAT,
-    EXR_UNKNOWN,
-};
-
 enum ExrTileLevelMode {
     EXR_TILE_LEVEL_ONE,
     EXR_TILE_LEVEL_MIPMAP,
@@ -288,9 +268,6 @@ static int rle_uncompress(EXRContext *ctx, const uint8_t *src, int compressed_si
     return 0;
 }
 
-#define USHORT_RANGE (1 << 16)
-#define BITMAP_SIZE  (1 << 13)
-
 static uint16_t reverse_lut(const uint8_t *bitmap, uint16_t *lut)
 {
     int i, k = 0;
@@ -314,10 +291,7 @@ static void apply_lut(const uint16_t *lut, uint16_t *dst, int dsize)
         dst[i] = lut[dst[i]];
 }
 
-#define HUF_ENCBITS 16  // literal (value) bit length
 #define HUF_DECBITS 14  // decoding bit size (>= 8)
-
-#define HUF_ENCSIZE ((1 << HUF_ENCBITS) + 1)  // encoding table size
 #define HUF_DECSIZE (1 << HUF_DECBITS)        // decoding table size
 #define HUF_DECMASK (HUF_DECSIZE - 1)
 
@@ -350,11 +324,6 @@ static void huf_canonical_code_table(uint64_t *hcode)
     }
 }
 
-#define SHORT_ZEROCODE_RUN  59
-#define LONG_ZEROCODE_RUN   63
-#define SHORTEST_LONG_RUN   (2 + LONG_ZEROCODE_RUN - SHORT_ZEROCODE_RUN)
-#define LONGEST_LONG_RUN    (255 + SHORTEST_LONG_RUN)
-
 static int huf_unpack_enc_table(GetByteContext *gb,
                                 int32_t im, int32_t iM, uint64_t *hcode)
 {
@@ -0,0 +1,57 @@
+/*
+ * OpenEXR definitions shared by the decoder and the encoder
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVCODEC_EXR_H
+#define AVCODEC_EXR_H
+
+enum ExrCompr {
+    EXR_RAW,
+    EXR_RLE,
+    EXR_ZIP1,
+    EXR_ZIP16,
+    EXR_PIZ,
+    EXR_PXR24,
+    EXR_B44,
+    EXR_B44A,
+    EXR_DWA,
+    EXR_DWB,
+    EXR_UNKN,
+};
+
+enum ExrPixelType {
+    EXR_UINT,
+    EXR_HALF,
+    EXR_FLOAT,
+    EXR_UNKNOWN,
+};
+
+/* PIZ */
+#define USHORT_RANGE (1 << 16)
+#define BITMAP_SIZE  (1 << 13)
+
+#define HUF_ENCBITS 16  // literal (value) bit length
+#define HUF_ENCSIZE ((1 << HUF_ENCBITS) + 1)  // encoding table size
+
+#define SHORT_ZEROCODE_RUN  59
+#define LONG_ZEROCODE_RUN   63
+#define SHORTEST_LONG_RUN   (2 + LONG_ZEROCODE_RUN - SHORT_ZEROCODE_RUN)
+#define LONGEST_LONG_RUN    (255 + SHORTEST_LONG_RUN)
+
+#endif /* AVCODEC_EXR_H */
@@ -0,0 +1,877 @@
+/*
+ * OpenEXR image format
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * OpenEXR encoder
+ *
+ * Writes single part scanline images. The scanline blocks of a frame are
+ * compressed independently, in parallel when slice threading is enabled.
+ */
+
+#include <zlib.h>
+
+#include "libavutil/avassert.h"
+#include "libavutil/intfloat.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/opt.h"
+#include "libavutil/pixdesc.h"
+
+#include "avcodec.h"
+#include "bytestream.h"
+#include "exr.h"
+#include "huffman.h"
+#include "internal.h"
+#include "put_bits.h"
+
+/* upper bound of the header size, including the channel list */
+#define HEADER_SIZE 512
+
+typedef struct EXRBlock {
+    int64_t offset; ///< of the space reserved for the block in the packet
+    int bound;      ///< size of that space
+    int size;
+    int ret;
+} EXRBlock;
+
+typedef struct EXRThreadData {
+    uint8_t *uncompressed_data;
+    unsigned int uncompressed_size;
+
+    uint8_t *tmp;
+    unsigned int tmp_size;
+
+    /* PIZ */
+    uint8_t *bitmap;
+    uint16_t *lut;
+    uint64_t *freq;
+    uint8_t *len;
+    uint64_t *code;
+
+    /* ZIP */
+    z_stream zstream;
+    int zstream_inited;
+} EXRThreadData;
+
+typedef struct EXRContext {
+    const AVClass *class;
+
+    int compression;
+    int pixel_type;
+
+    int planes;
+    const char *ch_names;
+    const uint8_t *ch_planes;
+    int scanline_height;
+    int nb_blocks;
+    int nb_threads;
+
+    const AVFrame *frame;
+    uint8_t *pkt_data;
+    EXRBlock *blocks;
+    EXRThreadData *thread_data;
+
+    AVBufferPool *pool;
+    int pool_size;
+
+    uint16_t basetable[512];
+    uint8_t shifttable[512];
+} EXRContext;
+
+/* channels are stored in alphabetical order */
+static const char    abgr_names[]  = "ABGR";
+static const uint8_t abgr_planes[] = { 3, 1, 0, 2 };
+static const char    bgr_names[]   = "BGR";
+static const uint8_t bgr_planes[]  = { 1, 0, 2 };
+static const char    y_names[]     = "Y";
+static const uint8_t y_planes[]    = { 0 };
+
+/* The tables give the half exponent bits and the shift that turns the
+ * 24-bit float significand, including the implicit bit, into the half
+ * significand. For normals, the implicit bit adds one to the exponent. */
+static av_cold void init_half_tables(EXRContext *s)
+{
+    int i;
+
+    for (i = 0; i < 256; i++) {
+        int e = i - 127;
+
+        if (e < -25) {          /* flush to zero */
+            s->basetable[i]          = 0x0000;
+            s->shifttable[i]         = 25;
+        } else if (e < -14) {   /* denormals */
+            s->basetable[i]          = 0x0000;
+            s->shifttable[i]         = -e - 1;
+        } else if (e <= 15) {   /* normals lose precision */
+            s->basetable[i]          = (e + 14) << 10;
+            s->shifttable[i]         = 13;
+        } else {                /* overflow, infinity and NaN */
+            s->basetable[i]          = 0x7C00;
+            s->shifttable[i]         = 25;
+        }
+        s->basetable[i | 0x100]  = s->basetable[i] | 0x8000;
+        s->shifttable[i | 0x100] = s->shifttable[i];
+    }
+}
+
+/* rounds to nearest even like OpenEXR, a carry out of the significand
+ * bumps the exponent, up to infinity */
+static inline uint16_t float2half(const EXRContext *s, uint32_t f)
+{
+    int idx      = f >> 23;
+    int shift    = s->shifttable[idx];
+    uint32_t man = f & 0x007FFFFF;
+
+    /* keep NaNs quiet, the set bits might all be shifted out */
+    if ((f & 0x7FFFFFFF) > 0x7F800000)
+        return s->basetable[idx] | 0x0200 | man >> 13;
+
+    man |= 0x00800000;
+    return s->basetable[idx] +
+           ((man + (1 << (shift - 1)) - 1 + ((man >> shift) & 1)) >> shift);
+}
+
+static av_cold int encode_init(AVCodecContext *avctx)
+{
+    EXRContext *s = avctx->priv_data;
+    int i;
+
+    switch (avctx->pix_fmt) {
+    case AV_PIX_FMT_GBRPF32:
+        s->planes    = 3;
+        s->ch_names  = bgr_names;
+        s->ch_planes = bgr_planes;
+        break;
+    case AV_PIX_FMT_GBRAPF32:
+        s->planes    = 4;
+        s->ch_names  = abgr_names;
+        s->ch_planes = abgr_planes;
+        break;
+    case AV_PIX_FMT_GRAYF32:
+        s->planes    = 1;
+        s->ch_names  = y_names;
+        s->ch_planes = y_planes;
+        break;
+    default:
+        av_assert0(0);
+    }
+
+    switch (s->compression) {
+    case EXR_RAW:
+    case EXR_RLE:
+    case EXR_ZIP1:
+        s->scanline_height = 1;
+        break;
+    case EXR_ZIP16:
+        s->scanline_height = 16;
+        break;
+    case EXR_PIZ:
+        s->scanline_height = 32;
+        break;
+    default:
+        av_assert0(0);
+    }
+
+    if (s->pixel_type == EXR_HALF)
+        init_half_tables(s);
+
+    s->nb_blocks  = (avctx->height + s->scanline_height - 1) / s->scanline_height;
+    s->nb_threads = avctx->active_thread_type & FF_THREAD_SLICE ?
+                    FFMAX(avctx->thread_count, 1) : 1;
+
+    s->blocks      = av_mallocz_array(s->nb_blocks,  sizeof(*s->blocks));
+    s->thread_data = av_mallocz_array(s->nb_threads, sizeof(*s->thread_data));
+    if (!s->blocks || !s->thread_data)
+        return AVERROR(ENOMEM);
+
+    if (s->compression == EXR_PIZ) {
+        for (i = 0; i < s->nb_threads; i++) {
+            EXRThreadData *td = &s->thread_data[i];
+
+            td->bitmap = av_malloc(BITMAP_SIZE);
+            td->lut    = av_malloc_array(USHORT_RANGE, sizeof(*td->lut));
+            td->freq   = av_malloc_array(HUF_ENCSIZE,  sizeof(*td->freq));
+            td->len    = av_malloc(HUF_ENCSIZE);
+            td->code   = av_malloc_array(HUF_ENCSIZE,  sizeof(*td->code));
+            if (!td->bitmap || !td->lut || !td->freq || !td->len || !td->code)
+                return AVERROR(ENOMEM);
+        }
+    } else if (s->compression == EXR_ZIP1 || s->compression == EXR_ZIP16) {
+        /* one deflate state per thread, reset for every block */
+        for (i = 0; i < s->nb_threads; i++) {
+            EXRThreadData *td = &s->thread_data[i];
+
+            if (deflateInit(&td->zstream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+                av_log(avctx, AV_LOG_ERROR, "Deflate init error\n");
+                return AVERROR_EXTERNAL;
+            }
+            td->zstream_inited = 1;
+        }
+    }
+
+    return 0;
+}
+
+static av_cold int encode_close(AVCodecContext *avctx)
+{
+    EXRContext *s = avctx->priv_data;
+    int i;
+
+    av_freep(&s->blocks);
+    av_buffer_pool_uninit(&s->pool);
+
+    for (i = 0; s->thread_data && i < s->nb_threads; i++) {
+        EXRThreadData *td = &s->thread_data[i];
+
+        av_freep(&td->uncompressed_data);
+        av_freep(&td->tmp);
+        av_freep(&td->bitmap);
+        av_freep(&td->lut);
+        av_freep(&td->freq);
+        av_freep(&td->len);
+        av_freep(&td->code);
+        if (td->zstream_inited)
+            deflateEnd(&td->zstream);
+    }
+    av_freep(&s->thread_data);
+
+    return 0;
+}
+
+/* the block is stored line by line, each line holding the channels in order */
+static void fill_block(EXRContext *s, uint8_t *dst, int y0, int lines, int width)
+{
+    const AVFrame *frame = s->frame;
+    int x, y, c;
+
+    for (y = y0; y < y0 + lines; y++) {
+        for (c = 0; c < s->planes; c++) {
+            int p = s->ch_planes[c];
+            const uint32_t *src = (const uint32_t *)(frame->data[p] + y * frame->linesize[p]);
+
+            if (s->pixel_type == EXR_HALF) {
+                for (x = 0; x < width; x++)
+                    AV_WL16(dst + 2 * x, float2half(s, src[x]));
+                dst += 2 * width;
+            } else {
+                for (x = 0; x < width; x++)
+                    AV_WL32(dst + 4 * x, src[x]);
+                dst += 4 * width;
+            }
+        }
+    }
+}
+
+/* inverse of ExrDSPContext.predictor() and .reorder_pixels() */
+static void reorder_and_predict(uint8_t *dst, const uint8_t *src, int size)
+{
+    int half_size = size / 2;
+    uint8_t *t1 = dst;
+    uint8_t *t2 = dst + half_size;
+    int i, p;
+
+    for (i = 0; i < half_size; i++) {
+        *t1++ = *src++;
+        *t2++ = *src++;
+    }
+
+    p = dst[0];
+    for (i = 1; i < size; i++) {
+        int d = dst[i] - p + 128;
+        p = dst[i];
+        dst[i] = d;
+    }
+}
+
+#define MIN_RUN_LENGTH 3
+#define MAX_RUN_LENGTH 127
+
+static int rle_compress(uint8_t *dst, const uint8_t *src, int size)
+{
+    const uint8_t *run_start = src;
+    const uint8_t *run_end   = src + 1;
+    const uint8_t *end       = src + size;
+    uint8_t *out = dst;
+
+    while (run_start < end) {
+        while (run_end < end && *run_start == *run_end &&
+               run_end - run_start - 1 < MAX_RUN_LENGTH)
+            run_end++;
+
+        if (run_end - run_start >= MIN_RUN_LENGTH) {
+            *out++ = (run_end - run_start) - 1;
+            *out++ = *run_start;
+            run_start = run_end;
+        } else {
+            while (run_end < end &&
+                   ((run_end + 1 >= end || run_end[0] != run_end[1]) ||
+                    (run_end + 2 >= end || run_end[1] != run_end[2])) &&
+                   run_end - run_start < MAX_RUN_LENGTH)
+                run_end++;
+
+            *out++ = run_start - run_end;
+            while (run_start < run_end)
+                *out++ = *run_start++;
+        }
+
+        run_end++;
+    }
+
+    return out - dst;
+}
+
+static inline void wenc14(uint16_t a, uint16_t b, uint16_t *l, uint16_t *h)
+{
+    int16_t as = a;
+    int16_t bs = b;
+
+    *l = (as + bs) >> 1;
+    *h = as - bs;
+}
+
+#define NBITS      16
+#define A_OFFSET  (1 << (NBITS - 1))
+#define M_OFFSET  (1 << (NBITS - 1))
+#define MOD_MASK  ((1 << NBITS) - 1)
+
+static inline void wenc16(uint16_t a, uint16_t b, uint16_t *l, uint16_t *h)
+{
+    int ao = (a + A_OFFSET) & MOD_MASK;
+    int m  = (ao + b) >> 1;
+    int d  = ao - b;
+
+    if (d < 0)
+        m = (m + M_OFFSET) & MOD_MASK;
+
+    *l = m;
+    *h = d & MOD_MASK;
+}
+
+/* inverse of wav_decode() in the decoder */
+static void wav_encode(uint16_t *in, int nx, int ox, int ny, int oy, uint16_t mx)
+{
+    int w14 = (mx < (1 << 14));
+    int n   = (nx > ny) ? ny : nx;
+    int p   = 1;
+    int p2  = 2;
+
+    while (p2 <= n) {
+        uint16_t *py = in;
+        uint16_t *ey = in + oy * (ny - p2);
+        uint16_t i00, i01, i10, i11;
+        int oy1 = oy * p;
+        int oy2 = oy * p2;
+        int ox1 = ox * p;
+        int ox2 = ox * p2;
+
+        for (; py <= ey; py += oy2) {
+            uint16_t *px = py;
+            uint16_t *ex = py + ox * (nx - p2);
+
+            for (; px <= ex; px += ox2) {
+                uint16_t *p01 = px + ox1;
+                uint16_t *p10 = px + oy1;
+                uint16_t *p11 = p10 + ox1;
+
+                if (w14) {
+                    wenc14(*px,  *p01, &i00, &i01);
+                    wenc14(*p10, *p11, &i10, &i11);
+                    wenc14(i00, i10, px,  p10);
+                    wenc14(i01, i11, p01, p11);
+                } else {
+                    wenc16(*px,  *p01, &i00, &i01);
+                    wenc16(*p10, *p11, &i10, &i11);
+                    wenc16(i00, i10, px,  p10);
+                    wenc16(i01, i11, p01, p11);
+                }
+            }
+
+            if (nx & p) {
+                uint16_t *p10 = px + oy1;
+
+                if (w14)
+                    wenc14(*px, *p10, &i00, p10);
+                else
+                    wenc16(*px, *p10, &i00, p10);
+
+                *px = i00;
+            }
+        }
+
+        if (ny & p) {
+            uint16_t *px = py;
+            uint16_t *ex = py + ox * (nx - p2);
+
+            for (; px <= ex; px += ox2) {
+                uint16_t *p01 = px + ox1;
+
+                if (w14)
+                    wenc14(*px, *p01, &i00, p01);
+                else
+                    wenc16(*px, *p01, &i00, p01);
+
+                *px = i00;
+            }
+        }
+
+        p   = p2;
+        p2 <<= 1;
+    }
+}
+
+/* inverse of reverse_lut() in the decoder */
+static uint16_t forward_lut(const uint8_t *bitmap, uint16_t *lut)
+{
+    int i, k = 0;
+
+    for (i = 0; i < USHORT_RANGE; i++) {
+        if (i == 0 || (bitmap[i >> 3] & (1 << (i & 7))))
+            lut[i] = k++;
+        else
+            lut[i] = 0;
+    }
+
+    return k - 1;
+}
+
+/* same canonical code assignment as huf_canonical_code_table() */
+static void huf_canonical_code_table(const uint8_t *len, uint64_t *code)
+{
+    uint64_t c, n[59] = { 0 };
+    int i;
+
+    for (i = 0; i < HUF_ENCSIZE; i++)
+        n[len[i]]++;
+
+    c = 0;
+    for (i = 58; i > 0; i--) {
+        uint64_t nc = (c + n[i]) >> 1;
+        n[i] = c;
+        c    = nc;
+    }
+
+    for (i = 0; i < HUF_ENCSIZE; i++)
+        code[i] = len[i] ? n[len[i]]++ : 0;
+}
+
+static void huf_pack_enc_table(PutBitContext *pb, const uint8_t *len, int im, int iM)
+{
+    for (; im <= iM; im++) {
+        if (!len[im]) {
+            int zerun = 1;
+
+            while (im < iM && zerun < LONGEST_LONG_RUN && !len[im + 1]) {
+                im++;
+                zerun++;
+            }
+
+            if (zerun >= SHORTEST_LONG_RUN) {
+                put_bits(pb, 6, LONG_ZEROCODE_RUN);
+                put_bits(pb, 8, zerun - SHORTEST_LONG_RUN);
+                continue;
+            } else if (zerun >= 2) {
+                put_bits(pb, 6, SHORT_ZEROCODE_RUN + zerun - 2);
+                continue;
+            }
+        }
+        put_bits(pb, 6, len[im]);
+    }
+}
+
+static void huf_send_code(PutBitContext *pb, const EXRThreadData *td,
+                          int sym, int run, int rlc)
+{
+    int len = td->len[sym];
+
+    if (len + td->len[rlc] + 8 < len * run) {
+        put_bits(pb, len, td->code[sym]);
+        put_bits(pb, td->len[rlc], td->code[rlc]);
+        put_bits(pb, 8, run);
+    } else {
+        while (run-- >= 0)
+            put_bits(pb, len, td->code[sym]);
+    }
+}
+
+static int huf_compress(EXRThreadData *td, const uint16_t *src, int nb,
+                        uint8_t *dst, int dst_size)
+{
+    PutBitContext pb;
+    int i, im, iM, ret, table_size, nb_bits, sym, run;
+
+    if (dst_size < 20)
+        return AVERROR_BUG;
+
+    memset(td->freq, 0, HUF_ENCSIZE * sizeof(*td->freq));
+    for (i = 0; i < nb; i++)
+        td->freq[src[i]]++;
+
+    for (im = 0; !td->freq[im]; im++)
+        ;
+    for (iM = USHORT_RANGE - 1; !td->freq[iM]; iM--)
+        ;
+    /* pseudo-symbol for run lengths */
+    td->freq[++iM] = 1;
+
+    memset(td->len, 0, HUF_ENCSIZE);
+    ret = ff_huff_gen_len_table(td->len + im, td->freq + im, iM - im + 1, 1);
+    if (ret < 0)
+        return ret;
+    for (i = im; i <= iM; i++)
+        if (!td->freq[i])
+            td->len[i] = 0;
+    huf_canonical_code_table(td->len, td->code);
+
+    init_put_bits(&pb, dst + 20, dst_size - 20);
+    huf_pack_enc_table(&pb, td->len, im, iM);
+    flush_put_bits(&pb);
+    table_size = put_bits_count(&pb) >> 3;
+
+    init_put_bits(&pb, dst + 20 + table_size, dst_size - 20 - table_size);
+    sym = src[0];
+    run = 0;
+    for (i = 1; i < nb; i++) {
+        if (src[i] == sym && run < 255) {
+            run++;
+        } else {
+            huf_send_code(&pb, td, sym, run, iM);
+            run = 0;
+        }
+        sym = src[i];
+    }
+    huf_send_code(&pb, td, sym, run, iM);
+    nb_bits = put_bits_count(&pb);
+    flush_put_bits(&pb);
+
+    AV_WL32(dst,      im);
+    AV_WL32(dst +  4, iM);
+    AV_WL32(dst +  8, table_size);
+    AV_WL32(dst + 12, nb_bits);
+    AV_WL32(dst + 16, 0);
+
+    return 20 + table_size + put_bits_count(&pb) / 8;
+}
+
+static int piz_compress(EXRContext *s, EXRThreadData *td, const uint8_t *src,
+                        int lines, int width, uint8_t *dst, int dst_size)
+{
+    int half_size = s->pixel_type == EXR_HALF ? 1 : 2;
+    int nb        = width * lines * half_size * s->planes;
+    uint16_t *tmp = (uint16_t *)td->tmp;
+    uint16_t *ptr, maxval;
+    int min_non_zero, max_non_zero;
+    int i, j, c, y, ret;
+    uint8_t *out = dst;
+
+    /* the wavelet transform works on one channel at a time */
+    ptr = tmp;
+    for (c = 0; c < s->planes; c++) {
+        for (y = 0; y < lines; y++) {
+            const uint8_t *line = src + (y * s->planes + c) * width * half_size * 2;
+
+            for (i = 0; i < width * half_size; i++)
+                *ptr++ = AV_RL16(line + 2 * i);
+        }
+    }
+
+    memset(td->bitmap, 0, BITMAP_SIZE);
+    for (i = 0; i < nb; i++)
+        td->bitmap[tmp[i] >> 3] |= 1 << (tmp[i] & 7);
+    /* zero is not explicitly stored */
+    td->bitmap[0] &= ~1;
+
+    min_non_zero = BITMAP_SIZE - 1;
+    max_non_zero = 0;
+    for (i = 0; i < BITMAP_SIZE; i++) {
+        if (td->bitmap[i]) {
+            min_non_zero = FFMIN(min_non_zero, i);
+            max_non_zero = i;
+        }
+    }
+
+    maxval = forward_lut(td->bitmap, td->lut);
+    for (i = 0; i < nb; i++)
+        tmp[i] = td->lut[tmp[i]];
+
+    ptr = tmp;
+    for (c = 0; c < s->planes; c++) {
+        for (j = 0; j < half_size; j++)
+            wav_encode(ptr + j, width, half_size, lines, width * half_size, maxval);
+        ptr += width * lines * half_size;
+    }
+
+    bytestream_put_le16(&out, min_non_zero);
+    bytestream_put_le16(&out, max_non_zero);
+    if (min_non_zero <= max_non_zero)
+        bytestream_put_buffer(&out, td->bitmap + min_non_zero,
+                              max_non_zero - min_non_zero + 1);
+
+    ret = huf_compress(td, tmp, nb, out + 4, dst_size - (out - dst) - 4);
+    if (ret < 0)
+        return ret;
+    bytestream_put_le32(&out, ret);
+
+    return out - dst + ret;
+}
+
+static int block_lines(AVCodecContext *avctx, int block)
+{
+    EXRContext *s = avctx->priv_data;
+
+    return FFMIN(s->scanline_height, avctx->height - block * s->scanline_height);
+}
+
+/* the most a block can take, compressed or stored uncompressed */
+static int64_t block_bound(AVCodecContext *avctx, int lines)
+{
+    EXRContext *s = avctx->priv_data;
+    int64_t size  = (int64_t)avctx->width * s->planes * lines *
+                    (s->pixel_type == EXR_HALF ? 2 : 4);
+
+    switch (s->compression) {
+    case EXR_RLE:
+        return size + size / MAX_RUN_LENGTH + 2;
+    case EXR_ZIP1:
+    case EXR_ZIP16:
+        return compressBound(size);
+    case EXR_PIZ:
+        return 2 * size + BITMAP_SIZE + HUF_ENCSIZE + 64;
+    default:
+        return size;
+    }
+}
+
+static int encode_block(AVCodecContext *avctx, void *arg, int jobnr, int threadnr)
+{
+    EXRContext *s     = avctx->priv_data;
+    EXRThreadData *td = &s->thread_data[threadnr];
+    EXRBlock *b       = &s->blocks[jobnr];
+    uint8_t *dst      = s->pkt_data + b->offset;
+    int y0            = jobnr * s->scanline_height;
+    int lines         = block_lines(avctx, jobnr);
+    int line_size     = avctx->width * s->planes * (s->pixel_type == EXR_HALF ? 2 : 4);
+    int size          = line_size * lines;
+
+    if (s->compression == EXR_RAW) {
+        fill_block(s, dst, y0, lines, avctx->width);
+        b->size = size;
+        return b->ret = 0;
+    }
+
+    av_fast_padded_malloc(&td->uncompressed_data, &td->uncompressed_size, size);
+    av_fast_padded_malloc(&td->tmp, &td->tmp_size, size);
+    if (!td->uncompressed_data || !td->tmp)
+        return b->ret = AVERROR(ENOMEM);
+
+    fill_block(s, td->uncompressed_data, y0, lines, avctx->width);
+
+    switch (s->compression) {
+    case EXR_RLE:
+        reorder_and_predict(td->tmp, td->uncompressed_data, size);
+        b->size = rle_compress(dst, td->tmp, size);
+        break;
+    case EXR_ZIP1:
+    case EXR_ZIP16:
+        reorder_and_predict(td->tmp, td->uncompressed_data, size);
+        if (deflateReset(&td->zstream) != Z_OK)
+            return b->ret = AVERROR_EXTERNAL;
+        td->zstream.next_in   = td->tmp;
+        td->zstream.avail_in  = size;
+        td->zstream.next_out  = dst;
+        td->zstream.avail_out = b->bound;
+        if (deflate(&td->zstream, Z_FINISH) != Z_STREAM_END)
+            return b->ret = AVERROR_EXTERNAL;
+        b->size = td->zstream.total_out;
+        break;
+    case EXR_PIZ:
+        b->size = piz_compress(s, td, td->uncompressed_data, lines,
+                               avctx->width, dst, b->bound);
+        if (b->size < 0)
+            return b->ret = b->size;
+        break;
+    }
+
+    /* blocks which do not shrink are stored uncompressed */
+    if (b->size >= size) {
+        memcpy(dst, td->uncompressed_data, size);
+        b->size = size;
+    }
+
+    return b->ret = 0;
+}
+
+static void put_attribute(PutByteContext *pb, const char *name,
+                          const char *type, int size)
+{
+    bytestream2_put_buffer(pb, name, strlen(name) + 1);
+    bytestream2_put_buffer(pb, type, strlen(type) + 1);
+    bytestream2_put_le32(pb, size);
+}
+
+static int encode_frame(AVCodecContext *avctx, AVPacket *pkt,
+                        const AVFrame *frame, int *got_packet)
+{
+    EXRContext *s = avctx->priv_data;
+    PutByteContext pb;
+    int64_t packet_size, offset, pos;
+    float sar = 1.0f;
+    int i, ret;
+
+    /* the blocks are compressed straight into the packet, each into space
+     * for its worst case, and moved together afterwards */
+    packet_size = HEADER_SIZE;
+    for (i = 0; i < s->nb_blocks; i++) {
+        int64_t bound = block_bound(avctx, block_lines(avctx, i));
+        if (bound > INT_MAX)
+            return AVERROR(EINVAL);
+        s->blocks[i].bound = bound;
+        packet_size += 16 + bound;
+    }
+
+    if ((ret = ff_alloc_packet_pool(avctx, pkt, &s->pool, &s->pool_size,
+                                    packet_size)) < 0)
+        return ret;
+    bytestream2_init_writer(&pb, pkt->data, pkt->size);
+
+    bytestream2_put_le32(&pb, 20000630);
+    bytestream2_put_byte(&pb, 2);
+    bytestream2_put_le24(&pb, 0);
+
+    put_attribute(&pb, "channels", "chlist", s->planes * 18 + 1);
+    for (i = 0; i < s->planes; i++) {
+        bytestream2_put_byte(&pb, s->ch_names[i]);
+        bytestream2_put_byte(&pb, 0);
+        bytestream2_put_le32(&pb, s->pixel_type);
+        bytestream2_put_le32(&pb, 0); /* pLinear and reserved */
+        bytestream2_put_le32(&pb, 1); /* xSampling */
+        bytestream2_put_le32(&pb, 1); /* ySampling */
+    }
+    bytestream2_put_byte(&pb, 0);
+
+    put_attribute(&pb, "compression", "compression", 1);
+    bytestream2_put_byte(&pb, s->compression);
+
+    put_attribute(&pb, "dataWindow", "box2i", 16);
+    bytestream2_put_le32(&pb, 0);
+    bytestream2_put_le32(&pb, 0);
+    bytestream2_put_le32(&pb, avctx->width  - 1);
+    bytestream2_put_le32(&pb, avctx->height - 1);
+
+    put_attribute(&pb, "displayWindow", "box2i", 16);
+    bytestream2_put_le32(&pb, 0);
+    bytestream2_put_le32(&pb, 0);
+    bytestream2_put_le32(&pb, avctx->width  - 1);
+    bytestream2_put_le32(&pb, avctx->height - 1);
+
+    put_attribute(&pb, "lineOrder", "lineOrder", 1);
+    bytestream2_put_byte(&pb, 0); /* increasing y */
+
+    if (avctx->sample_aspect_ratio.num && avctx->sample_aspect_ratio.den)
+        sar = av_q2d(avctx->sample_aspect_ratio);
+    put_attribute(&pb, "pixelAspectRatio", "float", 4);
+    bytestream2_put_le32(&pb, av_float2int(sar));
+
+    put_attribute(&pb, "screenWindowCenter", "v2f", 8);
+    bytestream2_put_le64(&pb, 0);
+
+    put_attribute(&pb, "screenWindowWidth", "float", 4);
+    bytestream2_put_le32(&pb, av_float2int(1.0f));
+
+    bytestream2_put_byte(&pb, 0); /* end of header */
+
+    offset = bytestream2_tell_p(&pb);
+    pos    = offset + 8LL * s->nb_blocks;
+    for (i = 0; i < s->nb_blocks; i++) {
+        s->blocks[i].offset = pos + 8;
+        pos += 8 + s->blocks[i].bound;
+    }
+
+    s->frame    = frame;
+    s->pkt_data = pkt->data;
+    avctx->execute2(avctx, encode_block, NULL, NULL, s->nb_blocks);
+    s->frame    = NULL;
+    s->pkt_data = NULL;
+
+    pos = offset + 8LL * s->nb_blocks;
+    for (i = 0; i < s->nb_blocks; i++) {
+        EXRBlock *b = &s->blocks[i];
+
+        if (b->ret < 0) {
+            av_packet_unref(pkt);
+            return b->ret;
+        }
+
+        /* a block always ends up at or before its reserved space */
+        AV_WL64(pkt->data + offset + 8 * i, pos);
+        AV_WL32(pkt->data + pos,     i * s->scanline_height);
+        AV_WL32(pkt->data + pos + 4, b->size);
+        if (pos + 8 != b->offset)
+            memmove(pkt->data + pos + 8, pkt->data + b->offset, b->size);
+        pos += 8 + b->size;
+    }
+
+    av_shrink_packet(pkt, pos);
+    pkt->flags |= AV_PKT_FLAG_KEY;
+    *got_packet = 1;
+
+    return 0;
+}
+
+#define OFFSET(x) offsetof(EXRContext, x)
+#define VE AV_OPT_FLAG_VIDEO_PARAM | AV_OPT_FLAG_ENCODING_PARAM
+static const AVOption options[] = {
+    { "compression", "set compression type", OFFSET(compression), AV_OPT_TYPE_INT, { .i64 = EXR_ZIP16 }, EXR_RAW, EXR_PIZ, VE, "compr" },
+    { "none",  "none",                     0, AV_OPT_TYPE_CONST, { .i64 = EXR_RAW   }, 0, 0, VE, "compr" },
+    { "rle",   "run-length encoding",      0, AV_OPT_TYPE_CONST, { .i64 = EXR_RLE   }, 0, 0, VE, "compr" },
+    { "zip1",  "zlib, one scanline",       0, AV_OPT_TYPE_CONST, { .i64 = EXR_ZIP1  }, 0, 0, VE, "compr" },
+    { "zip16", "zlib, 16 scanlines",       0, AV_OPT_TYPE_CONST, { .i64 = EXR_ZIP16 }, 0, 0, VE, "compr" },
+    { "piz",   "wavelet and Huffman coding", 0, AV_OPT_TYPE_CONST, { .i64 = EXR_PIZ }, 0, 0, VE, "compr" },
+    { "format", "set pixel type", OFFSET(pixel_type), AV_OPT_TYPE_INT, { .i64 = EXR_FLOAT }, EXR_HALF, EXR_FLOAT, VE, "pixel" },
+    { "half",  "16-bit floating point",    0, AV_OPT_TYPE_CONST, { .i64 = EXR_HALF  }, 0, 0, VE, "pixel" },
+    { "float", "32-bit floating point",    0, AV_OPT_TYPE_CONST, { .i64 = EXR_FLOAT }, 0, 0, VE, "pixel" },
+    { NULL },
+};
+
+static const AVClass exr_class = {
+    .class_name = "exr",
+    .item_name  = av_default_item_name,
+    .option     = options,
+    .version    = LIBAVUTIL_VERSION_INT,
+};
+
+AVCodec ff_exr_encoder = {
+    .name           = "exr",
+    .long_name      = NULL_IF_CONFIG_SMALL("OpenEXR image"),
+    .type           = AVMEDIA_TYPE_VIDEO,
+    .id             = AV_CODEC_ID_EXR,
+    .priv_data_size = sizeof(EXRContext),
+    .priv_class     = &exr_class,
+    .init           = encode_init,
+    .encode2        = encode_frame,
+    .close          = encode_close,
+    .capabilities   = AV_CODEC_CAP_FRAME_THREADS | AV_CODEC_CAP_SLICE_THREADS,
+    .caps_internal  = FF_CODEC_CAP_INIT_THREADSAFE | FF_CODEC_CAP_INIT_CLEANUP |
+                      FF_CODEC_CAP_PACKET_POOL,
+    .pix_fmts       = (const enum AVPixelFormat[]) {
+        AV_PIX_FMT_GRAYF32,
+        AV_PIX_FMT_GBRPF32,
+        AV_PIX_FMT_GBRAPF32,
+        AV_PIX_FMT_NONE },
+};
@@ -43,18 +43,42 @@
 
 #define DEFAULT_TRANSPARENCY_INDEX 0x1f
 
+/**
+ * Everything needed to encode one frame independently of the others.
+ */
+typedef struct GIFEncodeJob {
+    AVFrame *frame;                     ///< frame to encode
+    AVFrame *ref;                       ///< previous frame, if used
+    const uint32_t *palette;            ///< local palette to write, or NULL
+    int64_t frame_number;
+    LZWState *lzw;
+    uint8_t *buf;                       ///< LZW output
+    uint8_t *tmpl;                      ///< temporary line buffer
+    uint8_t *outbuf;                    ///< encoded frame
+    int out_size;
+    int ret;
+} GIFEncodeJob;
+
 typedef struct GIFContext {
     const AVClass *class;
-    LZWState *lzw;
-    uint8_t *buf;
     int buf_size;
+    int outbuf_size;
     AVFrame *last_frame;
     int flags;
     int image;
     uint32_t palette[AVPALETTE_COUNT];  ///< local reference palette for !pal8
     int palette_loaded;
     int transparent_index;
-    uint8_t *tmpl;                      ///< temporary line buffer
+
+    /**
+     * Ring of jobs: with slice threads, frames are queued until every job
+     * holds one, then they are all encoded in parallel.
+     */
+    GIFEncodeJob *jobs;
+    int nb_jobs;
+    int next_job;                       ///< index of the next job to output
+    int nb_encoded;                     ///< encoded jobs waiting for output
+    int nb_queued;                      ///< queued jobs waiting for encoding
 } GIFContext;
 
 enum {
@@ -197,16 +221,16 @@ static void gif_crop_translucent(AVCodecContext *avctx,
 }
 
 static void gif_crop_opaque(AVCodecContext *avctx,
-                            const uint32_t *palette,
+                            const uint32_t *palette, const AVFrame *last_frame,
                             const uint8_t *buf, const int linesize,
                             int *width, int *height, int *x_start, int *y_start)
 {
     GIFContext *s = avctx->priv_data;
 
     /* Crop image */
-    if ((s->flags & GF_OFFSETTING) && s->last_frame && !palette) {
-        const uint8_t *ref = s->last_frame->data[0];
-        const int ref_linesize = s->last_frame->linesize[0];
+    if ((s->flags & GF_OFFSETTING) && last_frame && !palette) {
+        const uint8_t *ref = last_frame->data[0];
+        const int ref_linesize = last_frame->linesize[0];
         int x_end = avctx->width  - 1,
             y_end = avctx->height - 1;
 
@@ -255,28 +279,29 @@ static void gif_crop_opaque(AVCodecContext *avctx,
     }
 }
 
-static int gif_image_write_image(AVCodecContext *avctx,
-                                 uint8_t **bytestream, uint8_t *end,
-                                 const uint32_t *palette,
-                                 const uint8_t *buf, const int linesize,
-                                 AVPacket *pkt)
+static int gif_image_write_image(AVCodecContext *avctx, GIFEncodeJob *job,
+                                 uint8_t **bytestream, uint8_t *end)
 {
     GIFContext *s = avctx->priv_data;
+    const uint32_t *palette    = job->palette;
+    const AVFrame *last_frame  = job->ref->buf[0] ? job->ref : NULL;
+    const uint8_t *buf         = job->frame->data[0];
+    const int linesize         = job->frame->linesize[0];
     int disposal, len = 0, height = avctx->height, width = avctx->width, x, y;
     int x_start = 0, y_start = 0, trans = s->transparent_index;
-    int bcid = -1, honor_transparency = (s->flags & GF_TRANSDIFF) && s->last_frame && !palette;
+    int bcid = -1, honor_transparency = (s->flags & GF_TRANSDIFF) && last_frame && !palette;
     const uint8_t *ptr;
 
-    if (!s->image && avctx->frame_number && is_image_translucent(avctx, buf, linesize)) {
+    if (!s->image && job->frame_number && is_image_translucent(avctx, buf, linesize)) {
         gif_crop_translucent(avctx, buf, linesize, &width, &height, &x_start, &y_start);
         honor_transparency = 0;
         disposal = GCE_DISPOSAL_BACKGROUND;
     } else {
-        gif_crop_opaque(avctx, palette, buf, linesize, &width, &height, &x_start, &y_start);
+        gif_crop_opaque(avctx, palette, last_frame, buf, linesize, &width, &height, &x_start, &y_start);
         disposal = GCE_DISPOSAL_INPLACE;
     }
 
-    if (s->image || !avctx->frame_number) { /* GIF header */
+    if (s->image || !job->frame_number) { /* GIF header */
         const uint32_t *global_palette = palette ? palette : s->palette;
         const AVRational sar = avctx->sample_aspect_ratio;
         int64_t aspect = 0;
@@ -343,32 +368,32 @@ static int gif_image_write_image(AVCodecContext *avctx,
 
     bytestream_put_byte(bytestream, 0x08);
 
-    ff_lzw_encode_init(s->lzw, s->buf, s->buf_size,
+    ff_lzw_encode_init(job->lzw, job->buf, s->buf_size,
                        12, FF_LZW_GIF, put_bits);
 
     ptr = buf + y_start*linesize + x_start;
     if (honor_transparency) {
-        const int ref_linesize = s->last_frame->linesize[0];
-        const uint8_t *ref = s->last_frame->data[0] + y_start*ref_linesize + x_start;
+        const int ref_linesize = last_frame->linesize[0];
+        const uint8_t *ref = last_frame->data[0] + y_start*ref_linesize + x_start;
 
         for (y = 0; y < height; y++) {
-            memcpy(s->tmpl, ptr, width);
+            memcpy(job->tmpl, ptr, width);
             for (x = 0; x < width; x++)
                 if (ref[x] == ptr[x])
-                    s->tmpl[x] = trans;
-            len += ff_lzw_encode(s->lzw, s->tmpl, width);
+                    job->tmpl[x] = trans;
+            len += ff_lzw_encode(job->lzw, job->tmpl, width);
             ptr += linesize;
             ref += ref_linesize;
         }
     } else {
         for (y = 0; y < height; y++) {
-            len += ff_lzw_encode(s->lzw, ptr, width);
+            len += ff_lzw_encode(job->lzw, ptr, width);
             ptr += linesize;
         }
     }
-    len += ff_lzw_encode_flush(s->lzw, flush_put_bits);
+    len += ff_lzw_encode_flush(job->lzw, flush_put_bits);
 
-    ptr = s->buf;
+    ptr = job->buf;
     while (len > 0) {
         int size = FFMIN(255, len);
         bytestream_put_byte(bytestream, size);
@@ -385,6 +410,7 @@ static int gif_image_write_image(AVCodecContext *avctx,
 static av_cold int gif_encode_init(AVCodecContext *avctx)
 {
     GIFContext *s = avctx->priv_data;
+    int i;
 
     if (avctx->width > 65535 || avctx->height > 65535) {
         av_log(avctx, AV_LOG_ERROR, "GIF does not support resolutions above 65535x65535\n");
@@ -393,12 +419,26 @@ static av_cold int gif_encode_init(AVCodecContext *avctx)
 
     s->transparent_index = -1;
 
-    s->lzw = av_mallocz(ff_lzw_encode_state_size);
-    s->buf_size = avctx->width*avctx->height*2 + 1000;
-    s->buf = av_malloc(s->buf_size);
-    s->tmpl = av_malloc(avctx->width);
-    if (!s->tmpl || !s->buf || !s->lzw)
+    s->buf_size    = avctx->width*avctx->height*2 + 1000;
+    s->outbuf_size = avctx->width*avctx->height*7/5 + AV_INPUT_BUFFER_MIN_SIZE;
+    s->nb_jobs     = avctx->active_thread_type & FF_THREAD_SLICE ?
+                     FFMAX(avctx->thread_count, 1) : 1;
+    s->jobs = av_mallocz_array(s->nb_jobs, sizeof(*s->jobs));
+    if (!s->jobs)
         return AVERROR(ENOMEM);
+    for (i = 0; i < s->nb_jobs; i++) {
+        GIFEncodeJob *job = &s->jobs[i];
+
+        job->frame  = av_frame_alloc();
+        job->ref    = av_frame_alloc();
+        job->lzw    = av_mallocz(ff_lzw_encode_state_size);
+        job->buf    = av_malloc(s->buf_size);
+        job->tmpl   = av_malloc(avctx->width);
+        job->outbuf = av_malloc(s->outbuf_size);
+        if (!job->frame || !job->ref || !job->lzw || !job->buf ||
+            !job->tmpl || !job->outbuf)
+            return AVERROR(ENOMEM);
+    }
 
     if (avpriv_set_systematic_pal2(s->palette, avctx->pix_fmt) < 0)
         av_assert0(avctx->pix_fmt == AV_PIX_FMT_PAL8);
@@ -406,21 +446,21 @@ static av_cold int gif_encode_init(AVCodecContext *avctx)
     return 0;
 }
 
-static int gif_encode_frame(AVCodecContext *avctx, AVPacket *pkt,
-                            const AVFrame *pict, int *got_packet)
+static int gif_queue_frame(AVCodecContext *avctx, const AVFrame *pict)
 {
     GIFContext *s = avctx->priv_data;
-    uint8_t *outbuf_ptr, *end;
+    GIFEncodeJob *job = &s->jobs[(s->next_job + s->nb_encoded + s->nb_queued) % s->nb_jobs];
     const uint32_t *palette = NULL;
     int ret;
 
-    if ((ret = ff_alloc_packet2(avctx, pkt, avctx->width*avctx->height*7/5 + AV_INPUT_BUFFER_MIN_SIZE, 0)) < 0)
+    ret = av_frame_ref(job->frame, pict);
+    if (ret < 0)
         return ret;
-    outbuf_ptr = pkt->data;
-    end        = pkt->data + pkt->size;
 
+    /* everything depending on the previous frames is decided here, in
+     * coding order, so the jobs can then run in any order */
     if (avctx->pix_fmt == AV_PIX_FMT_PAL8) {
-        palette = (uint32_t*)pict->data[1];
+        palette = (uint32_t*)job->frame->data[1];
 
         if (!s->palette_loaded) {
             memcpy(s->palette, palette, AVPALETTE_SIZE);
@@ -430,39 +470,101 @@ static int gif_encode_frame(AVCodecContext *avctx, AVPacket *pkt,
             palette = NULL;
         }
     }
-
-    gif_image_write_image(avctx, &outbuf_ptr, end, palette,
-                          pict->data[0], pict->linesize[0], pkt);
-    if (!s->last_frame && !s->image) {
-        s->last_frame = av_frame_alloc();
-        if (!s->last_frame)
-            return AVERROR(ENOMEM);
-    }
+    job->palette      = palette;
+    job->frame_number = avctx->frame_number;
 
     if (!s->image) {
+        if (s->last_frame) {
+            ret = av_frame_ref(job->ref, s->last_frame);
+            if (ret < 0)
+                return ret;
+        } else {
+            s->last_frame = av_frame_alloc();
+            if (!s->last_frame)
+                return AVERROR(ENOMEM);
+        }
         av_frame_unref(s->last_frame);
-        ret = av_frame_ref(s->last_frame, (AVFrame*)pict);
+        ret = av_frame_ref(s->last_frame, pict);
         if (ret < 0)
             return ret;
     }
 
-    pkt->size   = outbuf_ptr - pkt->data;
-    if (s->image || !avctx->frame_number)
-        pkt->flags |= AV_PKT_FLAG_KEY;
-    *got_packet = 1;
-
+    s->nb_queued++;
     return 0;
 }
 
+static int gif_encode_job(AVCodecContext *avctx, void *arg, int jobnr, int threadnr)
+{
+    GIFContext *s = avctx->priv_data;
+    GIFEncodeJob *job = &s->jobs[(s->next_job + jobnr) % s->nb_jobs];
+    uint8_t *outbuf_ptr = job->outbuf;
+
+    job->ret = gif_image_write_image(avctx, job, &outbuf_ptr,
+                                     job->outbuf + s->outbuf_size);
+    job->out_size = outbuf_ptr - job->outbuf;
+    return job->ret;
+}
+
+static int gif_encode_frame(AVCodecContext *avctx, AVPacket *pkt,
+                            const AVFrame *pict, int *got_packet)
+{
+    GIFContext *s = avctx->priv_data;
+    GIFEncodeJob *job;
+    int ret;
+
+    if (pict) {
+        ret = gif_queue_frame(avctx, pict);
+        if (ret < 0)
+            return ret;
+    }
+
+    if (!s->nb_encoded && s->nb_queued && (s->nb_queued == s->nb_jobs || !pict)) {
+        avctx->execute2(avctx, gif_encode_job, NULL, NULL, s->nb_queued);
+        s->nb_encoded = s->nb_queued;
+        s->nb_queued  = 0;
+    }
+
+    if (!s->nb_encoded)
+        return 0;
+
+    job = &s->jobs[s->next_job];
+    s->next_job = (s->next_job + 1) % s->nb_jobs;
+    s->nb_encoded--;
+
+    ret = job->ret;
+    if (ret >= 0)
+        ret = ff_alloc_packet2(avctx, pkt, job->out_size, 0);
+    if (ret >= 0) {
+        memcpy(pkt->data, job->outbuf, job->out_size);
+        pkt->pts = pkt->dts = job->frame->pts;
+        if (s->image || !job->frame_number)
+            pkt->flags |= AV_PKT_FLAG_KEY;
+        *got_packet = 1;
+    }
+    av_frame_unref(job->frame);
+    av_frame_unref(job->ref);
+
+    return ret;
+}
+
 static int gif_encode_close(AVCodecContext *avctx)
 {
     GIFContext *s = avctx->priv_data;
+    int i;
 
-    av_freep(&s->lzw);
-    av_freep(&s->buf);
+    for (i = 0; s->jobs && i < s->nb_jobs; i++) {
+        GIFEncodeJob *job = &s->jobs[i];
+
+        av_frame_free(&job->frame);
+        av_frame_free(&job->ref);
+        av_freep(&job->lzw);
+        av_freep(&job->buf);
+        av_freep(&job->tmpl);
+        av_freep(&job->outbuf);
+    }
+    av_freep(&s->jobs);
     s->buf_size = 0;
     av_frame_free(&s->last_frame);
-    av_freep(&s->tmpl);
     return 0;
 }
 
@@ -492,6 +594,8 @@ AVCodec ff_gif_encoder = {
     .init           = gif_encode_init,
     .encode2        = gif_encode_frame,
     .close          = gif_encode_close,
+    .capabilities   = AV_CODEC_CAP_DELAY | AV_CODEC_CAP_SLICE_THREADS,
+    .caps_internal  = FF_CODEC_CAP_INIT_CLEANUP,
     .pix_fmts       = (const enum AVPixelFormat[]){
         AV_PIX_FMT_RGB8, AV_PIX_FMT_BGR8, AV_PIX_FMT_RGB4_BYTE, AV_PIX_FMT_BGR4_BYTE,
         AV_PIX_FMT_GRAY8, AV_PIX_FMT_PAL8, AV_PIX_FMT_NONE
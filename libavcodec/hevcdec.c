@@ -2466,10 +2466,12 @@ static int hls_decode_entry(AVCodecContext *avctxt, void *isFilterThread)
 
         ctb_addr_ts++;
         ff_hevc_save_states(s, ctb_addr_ts);
-        ff_hevc_hls_filters(s, x_ctb, y_ctb, ctb_size);
+        if (!s->deferred_filter)
+            ff_hevc_hls_filters(s, x_ctb, y_ctb, ctb_size);
     }
 
-    if (x_ctb + ctb_size >= s->ps.sps->width &&
+    if (!s->deferred_filter &&
+        x_ctb + ctb_size >= s->ps.sps->width &&
         y_ctb + ctb_size >= s->ps.sps->height)
         ff_hevc_hls_filter(s, x_ctb, y_ctb, ctb_size);
 
@@ -2568,6 +2570,26 @@ error:
     return ret;
 }
 
+static int alloc_thread_contexts(HEVCContext *s)
+{
+    int i;
+
+    for (i = 1; i < s->threads_number; i++) {
+        if (s->sList[i])
+            continue;
+        s->sList[i]      = av_malloc(sizeof(HEVCContext));
+        s->HEVClcList[i] = av_mallocz(sizeof(HEVCLocalContext));
+        if (!s->sList[i] || !s->HEVClcList[i]) {
+            av_freep(&s->sList[i]);
+            av_freep(&s->HEVClcList[i]);
+            return AVERROR(ENOMEM);
+        }
+        memcpy(s->sList[i], s, sizeof(HEVCContext));
+        s->sList[i]->HEVClc = s->HEVClcList[i];
+    }
+    return 0;
+}
+
 static int hls_slice_data_wpp(HEVCContext *s, const H2645NAL *nal)
 {
     const uint8_t *data = nal->data;
@@ -2596,14 +2618,9 @@ static int hls_slice_data_wpp(HEVCContext *s, const H2645NAL *nal)
 
     ff_alloc_entries(s->avctx, s->sh.num_entry_point_offsets + 1);
 
-    if (!s->sList[1]) {
-        for (i = 1; i < s->threads_number; i++) {
-            s->sList[i] = av_malloc(sizeof(HEVCContext));
-            memcpy(s->sList[i], s, sizeof(HEVCContext));
-            s->HEVClcList[i] = av_mallocz(sizeof(HEVCLocalContext));
-            s->sList[i]->HEVClc = s->HEVClcList[i];
-        }
-    }
+    res = alloc_thread_contexts(s);
+    if (res < 0)
+        goto error;
 
     offset = (lc->gb.index >> 3);
 
@@ -2666,6 +2683,56 @@ error:
     return res;
 }
 
+static int hls_filter_row(AVCodecContext *avctxt, void *arg, int ctb_row, int self_id)
+{
+    HEVCContext *s1 = avctxt->priv_data;
+    HEVCContext *s  = s1->sList[self_id];
+    int ctb_size    = 1 << s->ps.sps->log2_ctb_size;
+    int y_ctb       = ctb_row << s->ps.sps->log2_ctb_size;
+    int thread      = ctb_row % s->threads_number;
+    int x_ctb;
+
+    /* filtering a CTB touches the pixels and the SAO state of its
+     * neighbours, so stay SHIFT_CTB_WPP CTBs behind the row above */
+    for (x_ctb = 0; x_ctb < s->ps.sps->width; x_ctb += ctb_size) {
+        ff_thread_await_progress2(avctxt, ctb_row, thread, SHIFT_CTB_WPP);
+        ff_hevc_hls_filter(s, x_ctb, y_ctb, ctb_size);
+        ff_thread_report_progress2(avctxt, ctb_row, thread, 1);
+    }
+    ff_thread_report_progress2(avctxt, ctb_row, thread, SHIFT_CTB_WPP);
+
+    return 0;
+}
+
+/**
+ * Run deblocking and SAO on a frame whose slices have all been decoded
+ * with deferred_filter set, one CTB row per slice thread job.
+ */
+static void hevc_filter_frame(HEVCContext *s)
+{
+    const HEVCSPS *sps = s->ps.sps;
+    int ctb_size       = 1 << sps->log2_ctb_size;
+    int i, x, y;
+
+    s->deferred_filter = 0;
+
+    if (ff_alloc_entries(s->avctx, sps->ctb_height) < 0 ||
+        alloc_thread_contexts(s) < 0) {
+        for (y = 0; y < sps->height; y += ctb_size)
+            for (x = 0; x < sps->width; x += ctb_size)
+                ff_hevc_hls_filter(s, x, y, ctb_size);
+        return;
+    }
+
+    for (i = 1; i < s->threads_number; i++) {
+        memcpy(s->sList[i], s, sizeof(HEVCContext));
+        s->sList[i]->HEVClc = s->HEVClcList[i];
+    }
+
+    ff_reset_entries(s->avctx);
+    s->avctx->execute2(s->avctx, hls_filter_row, NULL, NULL, sps->ctb_height);
+}
+
 static int set_side_data(HEVCContext *s)
 {
     AVFrame *out = s->ref->frame;
@@ -2854,6 +2921,13 @@ static int hevc_frame_start(HEVCContext *s)
     if (!s->avctx->hwaccel)
         ff_thread_finish_setup(s->avctx);
 
+    /* Without WPP the CTB rows have to be parsed in order, but the in-loop
+     * filters can still run in parallel once the whole frame is decoded. */
+    s->deferred_filter = s->parallel_filter && s->threads_number > 1 &&
+                         !s->ps.pps->entropy_coding_sync_enabled_flag &&
+                         !s->avctx->hwaccel &&
+                         s->avctx->skip_loop_filter < AVDISCARD_NONREF;
+
     return 0;
 
 fail:
@@ -3103,6 +3177,9 @@ static int decode_nal_units(HEVCContext *s, const uint8_t *buf, int length)
     }
 
 fail:
+    if (s->deferred_filter)
+        hevc_filter_frame(s);
+
     if (s->ref && s->threads_type == FF_THREAD_FRAME)
         ff_thread_report_progress(&s->ref->tf, INT_MAX, 0);
 
@@ -3547,6 +3624,8 @@ static const AVOption options[] = {
         AV_OPT_TYPE_BOOL, {.i64 = 0}, 0, 1, PAR },
     { "strict-displaywin", "stricly apply default display window size", OFFSET(apply_defdispwin),
         AV_OPT_TYPE_BOOL, {.i64 = 0}, 0, 1, PAR },
+    { "parallel_filter", "run the in-loop filters on slice threads for streams without WPP", OFFSET(parallel_filter),
+        AV_OPT_TYPE_BOOL, {.i64 = 0}, 0, 1, PAR },
     { NULL },
 };
 
@@ -555,6 +555,10 @@ typedef struct HEVCContext {
     int enable_parallel_tiles;
     atomic_int wpp_err;
 
+    int parallel_filter;    ///< AVOption: filter CTB rows in parallel without WPP
+    int deferred_filter;    ///< in-loop filters of the current frame run
+                            ///< after all its slices are decoded
+
     const uint8_t *data;
 
     H2645Packet pkt;
@@ -60,7 +60,7 @@ int ff_huff_gen_len_table(uint8_t *dst, const uint64_t *stats, int stats_size, i
     HeapElem *h  = av_malloc_array(sizeof(*h), stats_size);
     int *up      = av_malloc_array(sizeof(*up) * 2, stats_size);
     uint8_t *len = av_malloc_array(sizeof(*len) * 2, stats_size);
-    uint16_t *map= av_malloc_array(sizeof(*map), stats_size);
+    int *map     = av_malloc_array(sizeof(*map), stats_size);
     int offset, i, next;
     int size = 0;
     int ret = 0;
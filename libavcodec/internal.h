@@ -73,6 +73,12 @@
  * uses ff_thread_report/await_progress().
  */
 #define FF_CODEC_CAP_ALLOCATE_PROGRESS      (1 << 6)
+/**
+ * The encoder allocates its packets with ff_alloc_packet_pool(), and may
+ * return them shrunk. The generic code will not try to shrink their buffers,
+ * which cannot be done without a copy for a pooled buffer.
+ */
+#define FF_CODEC_CAP_PACKET_POOL            (1 << 7)
 
 /**
  * AVCodec.codec_tags termination value
@@ -250,6 +256,23 @@ void ff_color_frame(AVFrame *frame, const int color[4]);
  */
 int ff_alloc_packet2(AVCodecContext *avctx, AVPacket *avpkt, int64_t size, int64_t min_size);
 
+/**
+ * Allocate a packet of exactly size bytes from a buffer pool.
+ *
+ * This is meant for encoders producing large packets of a known size, which
+ * would otherwise be allocated and copied for every packet. The pool is
+ * (re)created whenever size differs from the size it was created for, and
+ * must be freed with av_buffer_pool_uninit() by the caller.
+ * If avpkt->data is already set, this behaves like ff_alloc_packet2().
+ * Encoders using it should set FF_CODEC_CAP_PACKET_POOL.
+ *
+ * @param pool      the pool to allocate from, may point to NULL
+ * @param pool_size the packet size the pool was created for
+ * @return          non negative on success, negative error code on failure
+ */
+int ff_alloc_packet_pool(AVCodecContext *avctx, AVPacket *avpkt,
+                         AVBufferPool **pool, int *pool_size, int64_t size);
+
 /**
  * Rescale from sample rate to AVCodecContext.time_base.
  */
@@ -38,6 +38,12 @@ typedef struct LLVidEncDSPContext {
 
     void (*sub_left_predict)(uint8_t *dst, uint8_t *src,
                           ptrdiff_t stride, ptrdiff_t width, int height);
+
+    /**
+     * Sum of the absolute values of w bytes read as signed integers,
+     * as used by the PNG filter selection heuristic.
+     */
+    int (*sum_abs_int8)(const uint8_t *src, intptr_t w);
 } LLVidEncDSPContext;
 
 void ff_llvidencdsp_init(LLVidEncDSPContext *c);
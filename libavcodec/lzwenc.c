@@ -32,25 +32,25 @@
 
 #define LZW_MAXBITS 12
 #define LZW_SIZTABLE (1<<LZW_MAXBITS)
-#define LZW_HASH_SIZE 16411
-#define LZW_HASH_SHIFT 6
+#define LZW_HASH_BITS 13
+#define LZW_HASH_SIZE (1 << LZW_HASH_BITS)
+#define LZW_GEN_SHIFT 20
 
 #define LZW_PREFIX_EMPTY -1
-#define LZW_PREFIX_FREE -2
-
-/** One code in hash table */
-typedef struct Code{
-    /// Hash code of prefix, LZW_PREFIX_EMPTY if empty prefix, or LZW_PREFIX_FREE if no code
-    int hash_prefix;
-    int code;               ///< LZW code
-    uint8_t suffix;         ///< Last character in code block
-}Code;
 
 /** LZW encode state */
 typedef struct LZWEncodeState {
     int clear_code;          ///< Value of clear code
     int end_code;            ///< Value of end code
-    Code tab[LZW_HASH_SIZE]; ///< Hash table
+    /**
+     * Hash table of the strings longer than one character, keyed by
+     * generation << LZW_GEN_SHIFT | prefix code << 8 | last character.
+     * Entries of older generations are free, so clearing the table only
+     * needs a new generation.
+     */
+    uint32_t tab_key[LZW_HASH_SIZE];
+    uint16_t tab_code[LZW_HASH_SIZE]; ///< LZW code of the hash table entries
+    uint32_t generation;     ///< Generation of the table, shifted by LZW_GEN_SHIFT
     int tabsize;             ///< Number of values in hash table
     int bits;                ///< Actual bits code
     int bufsize;             ///< Size of output buffer
@@ -67,42 +67,13 @@ typedef struct LZWEncodeState {
 const int ff_lzw_encode_state_size = sizeof(LZWEncodeState);
 
 /**
- * Hash function adding character
- * @param head LZW code for prefix
- * @param add Character to add
- * @return New hash value
+ * Hash function
+ * @param key prefix code and last character of the string
+ * @return Hash value
  */
-static inline int hash(int head, const int add)
+static inline int hash(uint32_t key)
 {
-    head ^= (add << LZW_HASH_SHIFT);
-    if (head >= LZW_HASH_SIZE)
-        head -= LZW_HASH_SIZE;
-    av_assert2(head >= 0 && head < LZW_HASH_SIZE);
-    return head;
-}
-
-/**
- * Hash function calculates next hash value
- * @param head Actual hash code
- * @param offset Offset calculated by hashOffset
- * @return New hash value
- */
-static inline int hashNext(int head, const int offset)
-{
-    head -= offset;
-    if(head < 0)
-        head += LZW_HASH_SIZE;
-    return head;
-}
-
-/**
- * Hash function calculates hash offset
- * @param head Actual hash code
- * @return Hash offset
- */
-static inline int hashOffset(const int head)
-{
-    return head ? LZW_HASH_SIZE - head : 1;
+    return (key * 2654435761U) >> (32 - LZW_HASH_BITS);
 }
 
 /**
@@ -120,20 +91,19 @@ static inline void writeCode(LZWEncodeState * s, int c)
 /**
  * Find LZW code for block
  * @param s LZW state
- * @param c Last character in block
- * @param hash_prefix LZW code for prefix
- * @return LZW code for block or -1 if not found in table
+ * @param key Prefix code and last character of the block
+ * @return Position of the block in the hash table, or the free position
+ *         where it should be added
  */
-static inline int findCode(LZWEncodeState * s, uint8_t c, int hash_prefix)
+static inline int findCode(LZWEncodeState * s, uint32_t key)
 {
-    int h = hash(FFMAX(hash_prefix, 0), c);
-    int hash_offset = hashOffset(h);
+    int h = hash(key);
 
-    while (s->tab[h].hash_prefix != LZW_PREFIX_FREE) {
-        if ((s->tab[h].suffix == c)
-            && (s->tab[h].hash_prefix == hash_prefix))
+    key |= s->generation;
+    while (s->tab_key[h] >= s->generation) {
+        if (s->tab_key[h] == key)
             return h;
-        h = hashNext(h, hash_offset);
+        h = (h + 1) & (LZW_HASH_SIZE - 1);
     }
 
     return h;
@@ -142,15 +112,13 @@ static inline int findCode(LZWEncodeState * s, uint8_t c, int hash_prefix)
 /**
  * Add block to LZW code table
  * @param s LZW state
- * @param c Last character in block
- * @param hash_prefix LZW code for prefix
- * @param hash_code LZW code for bytes block
+ * @param key Prefix code and last character of the block
+ * @param h Free position in the hash table
  */
-static inline void addCode(LZWEncodeState * s, uint8_t c, int hash_prefix, int hash_code)
+static inline void addCode(LZWEncodeState * s, uint32_t key, int h)
 {
-    s->tab[hash_code].code = s->tabsize;
-    s->tab[hash_code].suffix = c;
-    s->tab[hash_code].hash_prefix = hash_prefix;
+    s->tab_key[h]  = s->generation | key;
+    s->tab_code[h] = s->tabsize;
 
     s->tabsize++;
 
@@ -164,18 +132,12 @@ static inline void addCode(LZWEncodeState * s, uint8_t c, int hash_prefix, int h
  */
 static void clearTable(LZWEncodeState * s)
 {
-    int i, h;
-
     writeCode(s, s->clear_code);
     s->bits = 9;
-    for (i = 0; i < LZW_HASH_SIZE; i++) {
-        s->tab[i].hash_prefix = LZW_PREFIX_FREE;
-    }
-    for (i = 0; i < 256; i++) {
-        h = hash(0, i);
-        s->tab[h].code = i;
-        s->tab[h].suffix = i;
-        s->tab[h].hash_prefix = LZW_PREFIX_EMPTY;
+    s->generation += 1U << LZW_GEN_SHIFT;
+    if (!s->generation) {
+        memset(s->tab_key, 0, sizeof(s->tab_key));
+        s->generation = 1U << LZW_GEN_SHIFT;
     }
     s->tabsize = 258;
 }
@@ -215,6 +177,8 @@ void ff_lzw_encode_init(LZWEncodeState *s, uint8_t *outbuf, int outsize,
     s->bits = 9;
     s->mode = mode;
     s->put_bits = lzw_put_bits;
+    memset(s->tab_key, 0, sizeof(s->tab_key));
+    s->generation = 0;
 }
 
 /**
@@ -237,15 +201,26 @@ int ff_lzw_encode(LZWEncodeState * s, const uint8_t * inbuf, int insize)
 
     for (i = 0; i < insize; i++) {
         uint8_t c = *inbuf++;
-        int code = findCode(s, c, s->last_code);
-        if (s->tab[code].hash_prefix == LZW_PREFIX_FREE) {
-            writeCode(s, s->last_code);
-            addCode(s, c, s->last_code, code);
-            code= hash(0, c);
+        uint32_t key;
+        int h;
+
+        /* single characters are their own codes */
+        if (s->last_code == LZW_PREFIX_EMPTY) {
+            s->last_code = c;
+            continue;
         }
-        s->last_code = s->tab[code].code;
-        if (s->tabsize >= s->maxcode - 1) {
-            clearTable(s);
+
+        key = s->last_code << 8 | c;
+        h   = findCode(s, key);
+        if (s->tab_key[h] != (s->generation | key)) {
+            writeCode(s, s->last_code);
+            addCode(s, key, h);
+            s->last_code = c;
+            if (s->tabsize >= s->maxcode - 1) {
+                clearTable(s);
+            }
+        } else {
+            s->last_code = s->tab_code[h];
         }
     }
 
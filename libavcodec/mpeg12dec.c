@@ -1096,8 +1096,32 @@ static int mpeg_decode_update_thread_context(AVCodecContext *avctx,
     if (err)
         return err;
 
-    if (!ctx->mpeg_enc_ctx_allocated)
+    if (!ctx->mpeg_enc_ctx_allocated) {
         memcpy(s + 1, s1 + 1, sizeof(Mpeg1Context) - sizeof(MpegEncContext));
+        ctx->a53_caption      = NULL;
+        ctx->a53_caption_size = 0;
+    } else {
+        /* sequence level state the source thread may have parsed since */
+        ctx->save_aspect          = ctx_from->save_aspect;
+        ctx->save_width           = ctx_from->save_width;
+        ctx->save_height          = ctx_from->save_height;
+        ctx->save_progressive_seq = ctx_from->save_progressive_seq;
+        ctx->rc_buffer_size       = ctx_from->rc_buffer_size;
+        ctx->frame_rate_ext       = ctx_from->frame_rate_ext;
+        ctx->sync                 = ctx_from->sync;
+        ctx->tmpgexs              = ctx_from->tmpgexs;
+    }
+
+    s->aspect_ratio_info = s1->aspect_ratio_info;
+    s->frame_rate_index  = s1->frame_rate_index;
+    s->bit_rate          = s1->bit_rate;
+    s->swap_uv           = s1->swap_uv;
+    /* the GOP timecode is exported with the frame of the packet it was in */
+    s->timecode_frame_start = -1;
+    memcpy(s->intra_matrix,        s1->intra_matrix,        sizeof(s->intra_matrix));
+    memcpy(s->inter_matrix,        s1->inter_matrix,        sizeof(s->inter_matrix));
+    memcpy(s->chroma_intra_matrix, s1->chroma_intra_matrix, sizeof(s->chroma_intra_matrix));
+    memcpy(s->chroma_inter_matrix, s1->chroma_inter_matrix, sizeof(s->chroma_inter_matrix));
 
     if (!(s->pict_type == AV_PICTURE_TYPE_B || s->low_delay))
         s->picture_number++;
@@ -1666,9 +1690,6 @@ static int mpeg_field_start(MpegEncContext *s, const uint8_t *buf, int buf_size)
             *sd->data   = s1->afd;
             s1->has_afd = 0;
         }
-
-        if (HAVE_THREADS && (avctx->active_thread_type & FF_THREAD_FRAME))
-            ff_thread_finish_setup(avctx);
     } else { // second field
         int i;
 
@@ -1693,6 +1714,13 @@ static int mpeg_field_start(MpegEncContext *s, const uint8_t *buf, int buf_size)
         }
     }
 
+    /* The next frame thread copies first_field and the picture pointers,
+     * so for field pictures it may only start once the second field has
+     * been set up. */
+    if (HAVE_THREADS && (avctx->active_thread_type & FF_THREAD_FRAME) &&
+        !s->first_field)
+        ff_thread_finish_setup(avctx);
+
     if (avctx->hwaccel) {
         if ((ret = avctx->hwaccel->start_frame(avctx, buf, buf_size)) < 0)
             return ret;
@@ -1701,6 +1729,17 @@ static int mpeg_field_start(MpegEncContext *s, const uint8_t *buf, int buf_size)
     return 0;
 }
 
+/**
+ * Mark a picture whose second field never arrived as complete, frame
+ * threads decoding later pictures may be waiting for it.
+ */
+static void mpeg_finish_lone_field(MpegEncContext *s)
+{
+    if (HAVE_THREADS && (s->avctx->active_thread_type & FF_THREAD_FRAME) &&
+        s->first_field && s->current_picture_ptr)
+        ff_thread_report_progress(&s->current_picture_ptr->tf, INT_MAX, 0);
+}
+
 #define DECODE_SLICE_ERROR -1
 #define DECODE_SLICE_OK     0
 
@@ -1862,7 +1901,10 @@ static int mpeg_decode_slice(MpegEncContext *s, int mb_y,
             int left;
 
             ff_mpeg_draw_horiz_band(s, mb_size * (s->mb_y >> field_pic), mb_size);
-            ff_mpv_report_decode_progress(s);
+            /* the rows of a first field are not usable as a reference
+             * before the other field has been decoded */
+            if (!field_pic || !s->first_field)
+                ff_mpv_report_decode_progress(s);
 
             s->mb_x  = 0;
             s->mb_y += 1 << field_pic;
@@ -2620,6 +2662,7 @@ static int decode_chunks(AVCodecContext *avctx, AVFrame *picture,
             break;
         case GOP_START_CODE:
             if (last_code == 0) {
+                mpeg_finish_lone_field(s2);
                 s2->first_field = 0;
                 mpeg_decode_gop(avctx, buf_ptr, input_size);
                 s->sync = 1;
@@ -2651,6 +2694,7 @@ static int decode_chunks(AVCodecContext *avctx, AVFrame *picture,
                     av_log(s2->avctx, AV_LOG_WARNING, "invalid frame_pred_frame_dct\n");
 
                 if (s2->picture_structure == PICT_FRAME) {
+                    mpeg_finish_lone_field(s2);
                     s2->first_field = 0;
                     s2->v_edge_pos  = 16 * s2->mb_height;
                 } else {
@@ -2846,6 +2890,11 @@ static int mpeg_decode_frame(AVCodecContext *avctx, void *data,
 
     ret = decode_chunks(avctx, picture, got_output, buf, buf_size);
     if (ret<0 || *got_output) {
+        /* do not leave other frame threads waiting for an unfinished
+         * reference picture */
+        if (ret < 0 && s2->current_picture_ptr &&
+            HAVE_THREADS && (avctx->active_thread_type & FF_THREAD_FRAME))
+            ff_thread_report_progress(&s2->current_picture_ptr->tf, INT_MAX, 0);
         s2->current_picture_ptr = NULL;
 
         if (s2->timecode_frame_start != -1 && *got_output) {
@@ -2926,11 +2975,13 @@ AVCodec ff_mpeg2video_decoder = {
     .decode         = mpeg_decode_frame,
     .capabilities   = AV_CODEC_CAP_DRAW_HORIZ_BAND | AV_CODEC_CAP_DR1 |
                       AV_CODEC_CAP_TRUNCATED | AV_CODEC_CAP_DELAY |
-                      AV_CODEC_CAP_SLICE_THREADS,
-    .caps_internal  = FF_CODEC_CAP_SKIP_FRAME_FILL_PARAM,
+                      AV_CODEC_CAP_SLICE_THREADS | AV_CODEC_CAP_FRAME_THREADS,
+    .caps_internal  = FF_CODEC_CAP_SKIP_FRAME_FILL_PARAM |
+                      FF_CODEC_CAP_ALLOCATE_PROGRESS,
     .flush          = flush,
     .max_lowres     = 3,
     .profiles       = NULL_IF_CONFIG_SMALL(ff_mpeg2_video_profiles),
+    .update_thread_context = ONLY_IF_THREADS_ENABLED(mpeg_decode_update_thread_context),
     .hw_configs     = (const AVCodecHWConfigInternal*[]) {
 #if CONFIG_MPEG2_DXVA2_HWACCEL
                         HWACCEL_DXVA2(mpeg2),
@@ -1363,135 +1363,177 @@ static int encode_frame(AVCodecContext *c, AVFrame *frame)
     return size;
 }
 
-static int estimate_best_b_count(MpegEncContext *s)
+typedef struct BCountEstimate {
+    MpegEncContext *s;
+    const AVCodec *codec;
+    int width, height;
+    int p_lambda, b_lambda, lambda2;
+    int64_t rd[MAX_B_FRAMES + 1];
+} BCountEstimate;
+
+static int shrink_input_frame(AVCodecContext *avctx, void *arg, int i, int threadnr)
 {
-    const AVCodec *codec = avcodec_find_encoder(s->avctx->codec_id);
+    BCountEstimate *e = arg;
+    MpegEncContext *s = e->s;
     const int scale = s->brd_scale;
-    int width  = s->width  >> scale;
-    int height = s->height >> scale;
-    int i, j, out_size, p_lambda, b_lambda, lambda2;
-    int64_t best_rd  = INT64_MAX;
-    int best_b_count = -1;
-    int ret = 0;
+    Picture *pre_input_ptr = i ? s->input_picture[i - 1] : s->next_picture_ptr;
+    uint8_t *data[4];
+    int p;
 
-    av_assert0(scale >= 0 && scale <= 3);
+    if (!pre_input_ptr || (i && !s->input_picture[i - 1]))
+        return 0;
 
-    //emms_c();
-    //s->next_picture_ptr->quality;
-    p_lambda = s->last_lambda_for[AV_PICTURE_TYPE_P];
-    //p_lambda * FFABS(s->avctx->b_quant_factor) + s->avctx->b_quant_offset;
-    b_lambda = s->last_lambda_for[AV_PICTURE_TYPE_B];
-    if (!b_lambda) // FIXME we should do this somewhere else
-        b_lambda = p_lambda;
-    lambda2  = (b_lambda * b_lambda + (1 << FF_LAMBDA_SHIFT) / 2) >>
-               FF_LAMBDA_SHIFT;
+    memcpy(data, pre_input_ptr->f->data, sizeof(data));
+    if (!pre_input_ptr->shared && i) {
+        data[0] += INPLACE_OFFSET;
+        data[1] += INPLACE_OFFSET;
+        data[2] += INPLACE_OFFSET;
+    }
 
-    for (i = 0; i < s->max_b_frames + 2; i++) {
-        Picture pre_input, *pre_input_ptr = i ? s->input_picture[i - 1] :
-                                                s->next_picture_ptr;
-        uint8_t *data[4];
-
-        if (pre_input_ptr && (!i || s->input_picture[i - 1])) {
-            pre_input = *pre_input_ptr;
-            memcpy(data, pre_input_ptr->f->data, sizeof(data));
-
-            if (!pre_input.shared && i) {
-                data[0] += INPLACE_OFFSET;
-                data[1] += INPLACE_OFFSET;
-                data[2] += INPLACE_OFFSET;
-            }
+    for (p = 0; p < 3; p++)
+        s->mpvencdsp.shrink[scale](s->tmp_frames[i]->data[p],
+                                   s->tmp_frames[i]->linesize[p],
+                                   data[p],
+                                   pre_input_ptr->f->linesize[p],
+                                   e->width  >> !!p,
+                                   e->height >> !!p);
 
-            s->mpvencdsp.shrink[scale](s->tmp_frames[i]->data[0],
-                                       s->tmp_frames[i]->linesize[0],
-                                       data[0],
-                                       pre_input.f->linesize[0],
-                                       width, height);
-            s->mpvencdsp.shrink[scale](s->tmp_frames[i]->data[1],
-                                       s->tmp_frames[i]->linesize[1],
-                                       data[1],
-                                       pre_input.f->linesize[1],
-                                       width >> 1, height >> 1);
-            s->mpvencdsp.shrink[scale](s->tmp_frames[i]->data[2],
-                                       s->tmp_frames[i]->linesize[2],
-                                       data[2],
-                                       pre_input.f->linesize[2],
-                                       width >> 1, height >> 1);
+    return 0;
+}
+
+/**
+ * Trial encode the downscaled lookahead frames with j B-frames between
+ * each pair of reference frames and store the resulting RD cost in e->rd[j].
+ * Every candidate uses its own encoder and its own references to the
+ * shared downscaled frames, so the candidates can run concurrently.
+ */
+static int encode_b_count_candidate(AVCodecContext *avctx, void *arg, int j, int threadnr)
+{
+    BCountEstimate *e = arg;
+    MpegEncContext *s = e->s;
+    AVFrame *frames[MAX_B_FRAMES + 2] = { NULL };
+    AVCodecContext *c;
+    int64_t rd = 0;
+    int i, out_size, ret;
+
+    c = avcodec_alloc_context3(NULL);
+    if (!c)
+        return AVERROR(ENOMEM);
+
+    c->width        = e->width;
+    c->height       = e->height;
+    c->flags        = AV_CODEC_FLAG_QSCALE | AV_CODEC_FLAG_PSNR;
+    c->flags       |= s->avctx->flags & AV_CODEC_FLAG_QPEL;
+    c->mb_decision  = s->avctx->mb_decision;
+    c->me_cmp       = s->avctx->me_cmp;
+    c->mb_cmp       = s->avctx->mb_cmp;
+    c->me_sub_cmp   = s->avctx->me_sub_cmp;
+    c->pix_fmt      = AV_PIX_FMT_YUV420P;
+    c->time_base    = s->avctx->time_base;
+    c->max_b_frames = s->max_b_frames;
+
+    ret = avcodec_open2(c, e->codec, NULL);
+    if (ret < 0)
+        goto fail;
+
+    for (i = 0; i < s->max_b_frames + 2; i++) {
+        frames[i] = av_frame_clone(s->tmp_frames[i]);
+        if (!frames[i]) {
+            ret = AVERROR(ENOMEM);
+            goto fail;
         }
     }
 
-    for (j = 0; j < s->max_b_frames + 1; j++) {
-        AVCodecContext *c;
-        int64_t rd = 0;
+    frames[0]->pict_type = AV_PICTURE_TYPE_I;
+    frames[0]->quality   = 1 * FF_QP2LAMBDA;
 
-        if (!s->input_picture[j])
-            break;
+    out_size = encode_frame(c, frames[0]);
+    if (out_size < 0) {
+        ret = out_size;
+        goto fail;
+    }
 
-        c = avcodec_alloc_context3(NULL);
-        if (!c)
-            return AVERROR(ENOMEM);
+    //rd += (out_size * lambda2) >> FF_LAMBDA_SHIFT;
 
-        c->width        = width;
-        c->height       = height;
-        c->flags        = AV_CODEC_FLAG_QSCALE | AV_CODEC_FLAG_PSNR;
-        c->flags       |= s->avctx->flags & AV_CODEC_FLAG_QPEL;
-        c->mb_decision  = s->avctx->mb_decision;
-        c->me_cmp       = s->avctx->me_cmp;
-        c->mb_cmp       = s->avctx->mb_cmp;
-        c->me_sub_cmp   = s->avctx->me_sub_cmp;
-        c->pix_fmt      = AV_PIX_FMT_YUV420P;
-        c->time_base    = s->avctx->time_base;
-        c->max_b_frames = s->max_b_frames;
-
-        ret = avcodec_open2(c, codec, NULL);
-        if (ret < 0)
-            goto fail;
+    for (i = 0; i < s->max_b_frames + 1; i++) {
+        int is_p = i % (j + 1) == j || i == s->max_b_frames;
 
-        s->tmp_frames[0]->pict_type = AV_PICTURE_TYPE_I;
-        s->tmp_frames[0]->quality   = 1 * FF_QP2LAMBDA;
+        frames[i + 1]->pict_type = is_p ?
+                                   AV_PICTURE_TYPE_P : AV_PICTURE_TYPE_B;
+        frames[i + 1]->quality   = is_p ? e->p_lambda : e->b_lambda;
 
-        out_size = encode_frame(c, s->tmp_frames[0]);
+        out_size = encode_frame(c, frames[i + 1]);
         if (out_size < 0) {
             ret = out_size;
             goto fail;
         }
 
-        //rd += (out_size * lambda2) >> FF_LAMBDA_SHIFT;
+        rd += (out_size * e->lambda2) >> (FF_LAMBDA_SHIFT - 3);
+    }
+
+    /* get the delayed frames */
+    out_size = encode_frame(c, NULL);
+    if (out_size < 0) {
+        ret = out_size;
+        goto fail;
+    }
+    rd += (out_size * e->lambda2) >> (FF_LAMBDA_SHIFT - 3);
 
-        for (i = 0; i < s->max_b_frames + 1; i++) {
-            int is_p = i % (j + 1) == j || i == s->max_b_frames;
+    rd += c->error[0] + c->error[1] + c->error[2];
 
-            s->tmp_frames[i + 1]->pict_type = is_p ?
-                                     AV_PICTURE_TYPE_P : AV_PICTURE_TYPE_B;
-            s->tmp_frames[i + 1]->quality   = is_p ? p_lambda : b_lambda;
+    e->rd[j] = rd;
 
-            out_size = encode_frame(c, s->tmp_frames[i + 1]);
-            if (out_size < 0) {
-                ret = out_size;
-                goto fail;
-            }
+fail:
+    for (i = 0; i < FF_ARRAY_ELEMS(frames); i++)
+        av_frame_free(&frames[i]);
+    avcodec_free_context(&c);
+    return ret;
+}
 
-            rd += (out_size * lambda2) >> (FF_LAMBDA_SHIFT - 3);
-        }
+static int estimate_best_b_count(MpegEncContext *s)
+{
+    BCountEstimate e = { 0 };
+    int ret[MAX_B_FRAMES + 2];
+    int64_t best_rd  = INT64_MAX;
+    int best_b_count = -1;
+    int j, count;
 
-        /* get the delayed frames */
-        out_size = encode_frame(c, NULL);
-        if (out_size < 0) {
-            ret = out_size;
-            goto fail;
-        }
-        rd += (out_size * lambda2) >> (FF_LAMBDA_SHIFT - 3);
+    av_assert0(s->brd_scale >= 0 && s->brd_scale <= 3);
 
-        rd += c->error[0] + c->error[1] + c->error[2];
+    e.s      = s;
+    e.codec  = avcodec_find_encoder(s->avctx->codec_id);
+    e.width  = s->width  >> s->brd_scale;
+    e.height = s->height >> s->brd_scale;
 
-        if (rd < best_rd) {
-            best_rd = rd;
+    //emms_c();
+    //s->next_picture_ptr->quality;
+    e.p_lambda = s->last_lambda_for[AV_PICTURE_TYPE_P];
+    //p_lambda * FFABS(s->avctx->b_quant_factor) + s->avctx->b_quant_offset;
+    e.b_lambda = s->last_lambda_for[AV_PICTURE_TYPE_B];
+    if (!e.b_lambda) // FIXME we should do this somewhere else
+        e.b_lambda = e.p_lambda;
+    e.lambda2  = (e.b_lambda * e.b_lambda + (1 << FF_LAMBDA_SHIFT) / 2) >>
+                 FF_LAMBDA_SHIFT;
+
+    s->avctx->execute2(s->avctx, shrink_input_frame, &e, NULL,
+                       s->max_b_frames + 2);
+
+    for (count = 0; count < s->max_b_frames + 1; count++)
+        if (!s->input_picture[count])
+            break;
+
+    /* The candidates are independent, so with slice threading they are
+     * encoded concurrently; the choice is made in candidate order below,
+     * which keeps the result identical to a serial search. */
+    s->avctx->execute2(s->avctx, encode_b_count_candidate, &e, ret, count);
+
+    for (j = 0; j < count; j++) {
+        if (ret[j] < 0)
+            return ret[j];
+        if (e.rd[j] < best_rd) {
+            best_rd = e.rd[j];
             best_b_count = j;
         }
-
-fail:
-        avcodec_free_context(&c);
-        if (ret < 0)
-            return ret;
     }
 
     return best_b_count;
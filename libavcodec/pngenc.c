@@ -45,6 +45,16 @@ typedef struct APNGFctlChunk {
     uint8_t dispose_op, blend_op;
 } APNGFctlChunk;
 
+typedef struct PNGEncBand {
+    z_stream zstream;
+    uint8_t *buf;                ///< compressed data of the band
+    unsigned buf_size;
+    int len;
+    uLong adler;                 ///< Adler-32 of the uncompressed band data
+    uLong in_len;
+    int ret;
+} PNGEncBand;
+
 typedef struct PNGEncContext {
     AVClass *class;
     LLVidEncDSPContext llvidencdsp;
@@ -57,6 +67,13 @@ typedef struct PNGEncContext {
 
     z_stream zstream;
     uint8_t buf[IOBUF_SIZE];
+    int zlib_header;             ///< zlib stream header matching zstream's settings
+
+    // slice threading: row bands deflated independently
+    PNGEncBand *bands;
+    int nb_bands;
+    int nb_active_bands;
+
     int dpi;                     ///< Physical pixel density, in dots per inch, if set
     int dpm;                     ///< Physical pixel density, in dots per meter, if set
 
@@ -199,15 +216,12 @@ static uint8_t *png_choose_filter(PNGEncContext *s, uint8_t *dst,
     if (!top && pred)
         pred = PNG_FILTER_VALUE_SUB;
     if (pred == PNG_FILTER_VALUE_MIXED) {
-        int i;
         int cost, bcost = INT_MAX;
         uint8_t *buf1 = dst, *buf2 = dst + size + 16;
         for (pred = 0; pred < 5; pred++) {
             png_filter_row(s, buf1 + 1, pred, src, top, size, bpp);
             buf1[0] = pred;
-            cost = 0;
-            for (i = 0; i <= size; i++)
-                cost += abs((int8_t) buf1[i]);
+            cost = s->llvidencdsp.sum_abs_int8(buf1, size + 1);
             if (cost < bcost) {
                 bcost = cost;
                 FFSWAP(uint8_t *, buf1, buf2);
@@ -521,6 +535,155 @@ the_end:
     return ret;
 }
 
+static int png_band_deflate(PNGEncBand *b, const uint8_t *data, int size,
+                            int flush)
+{
+    int ret;
+
+    b->zstream.next_in  = data;
+    b->zstream.avail_in = size;
+    for (;;) {
+        if (!b->zstream.avail_out) {
+            int len      = b->zstream.next_out - b->buf;
+            uint8_t *buf = av_fast_realloc(b->buf, &b->buf_size, len + IOBUF_SIZE);
+            if (!buf)
+                return AVERROR(ENOMEM);
+            b->buf               = buf;
+            b->zstream.next_out  = buf + len;
+            b->zstream.avail_out = b->buf_size - len;
+        }
+        ret = deflate(&b->zstream, flush);
+        if (ret == Z_STREAM_ERROR)
+            return AVERROR_EXTERNAL;
+        if (flush == Z_FINISH ? ret == Z_STREAM_END
+                              : !b->zstream.avail_in && b->zstream.avail_out)
+            return 0;
+    }
+}
+
+static int encode_band(AVCodecContext *avctx, void *arg, int jobnr, int threadnr)
+{
+    PNGEncContext *s       = avctx->priv_data;
+    const AVFrame *const p = arg;
+    PNGEncBand *b          = &s->bands[jobnr];
+    int y_start  = p->height *  jobnr      / s->nb_active_bands;
+    int y_end    = p->height * (jobnr + 1) / s->nb_active_bands;
+    int row_size = (p->width * s->bits_per_pixel + 7) >> 3;
+    int bpp      = s->bits_per_pixel >> 3;
+    uint8_t *crow_base = NULL;
+    uint8_t *dict      = NULL;
+    uint8_t *crow_buf, *crow, *ptr, *top, *buf;
+    int y, ret;
+
+    crow_base = av_malloc((row_size + 32) << (s->filter_type == PNG_FILTER_VALUE_MIXED));
+    if (!crow_base) {
+        ret = AVERROR(ENOMEM);
+        goto the_end;
+    }
+    // pixel data should be aligned, but there's a control byte before it
+    crow_buf = crow_base + 15;
+
+    deflateReset(&b->zstream);
+    buf = av_fast_realloc(b->buf, &b->buf_size,
+                          deflateBound(&b->zstream, (y_end - y_start) * (row_size + 1)) + 16);
+    if (!buf) {
+        ret = AVERROR(ENOMEM);
+        goto the_end;
+    }
+    b->buf = buf;
+
+    /* the first band starts with the zlib header */
+    b->zstream.next_out  = b->buf    + (jobnr ? 0 : 2);
+    b->zstream.avail_out = b->buf_size - (jobnr ? 0 : 2);
+    b->adler  = adler32(0L, Z_NULL, 0);
+    b->in_len = (y_end - y_start) * (row_size + 1);
+
+    if (y_start) {
+        /* The rows before the band directly precede it in the zlib stream,
+         * prime the window with them to keep the compression ratio. */
+        int dict_start = FFMAX(y_start - (32768 + row_size) / (row_size + 1), 0);
+        int dict_size  = (y_start - dict_start) * (row_size + 1);
+
+        dict = av_malloc(dict_size);
+        if (!dict) {
+            ret = AVERROR(ENOMEM);
+            goto the_end;
+        }
+        top = dict_start ? p->data[0] + (dict_start - 1) * p->linesize[0] : NULL;
+        for (y = dict_start; y < y_start; y++) {
+            ptr  = p->data[0] + y * p->linesize[0];
+            crow = png_choose_filter(s, crow_buf, ptr, top, row_size, bpp);
+            memcpy(dict + (y - dict_start) * (row_size + 1), crow, row_size + 1);
+            top = ptr;
+        }
+        if (deflateSetDictionary(&b->zstream, dict, dict_size) != Z_OK) {
+            ret = AVERROR_EXTERNAL;
+            goto the_end;
+        }
+    }
+
+    top = y_start ? p->data[0] + (y_start - 1) * p->linesize[0] : NULL;
+    for (y = y_start; y < y_end; y++) {
+        ptr  = p->data[0] + y * p->linesize[0];
+        crow = png_choose_filter(s, crow_buf, ptr, top, row_size, bpp);
+        b->adler = adler32(b->adler, crow, row_size + 1);
+        ret = png_band_deflate(b, crow, row_size + 1, Z_NO_FLUSH);
+        if (ret < 0)
+            goto the_end;
+        top = ptr;
+    }
+
+    /* all but the last band end on a byte boundary, so the bands can be
+     * concatenated into a single deflate stream */
+    ret = png_band_deflate(b, NULL, 0, y_end == p->height ? Z_FINISH : Z_SYNC_FLUSH);
+    if (ret < 0)
+        goto the_end;
+    b->len = b->zstream.next_out - b->buf;
+
+the_end:
+    av_free(crow_base);
+    av_free(dict);
+    b->ret = ret;
+    return ret;
+}
+
+static int encode_frame_bands(AVCodecContext *avctx, const AVFrame *pict)
+{
+    PNGEncContext *s = avctx->priv_data;
+    PNGEncBand *last;
+    uLong adler;
+    uint8_t *buf;
+    int i;
+
+    s->nb_active_bands = FFMIN(s->nb_bands, pict->height);
+    avctx->execute2(avctx, encode_band, (void *)pict, NULL, s->nb_active_bands);
+
+    adler = s->bands[0].adler;
+    for (i = 0; i < s->nb_active_bands; i++) {
+        if (s->bands[i].ret < 0)
+            return s->bands[i].ret;
+        if (i)
+            adler = adler32_combine(adler, s->bands[i].adler, s->bands[i].in_len);
+    }
+
+    AV_WB16(s->bands[0].buf, s->zlib_header);
+    last = &s->bands[s->nb_active_bands - 1];
+    buf  = av_fast_realloc(last->buf, &last->buf_size, last->len + 4);
+    if (!buf)
+        return AVERROR(ENOMEM);
+    last->buf = buf;
+    AV_WB32(last->buf + last->len, adler);
+    last->len += 4;
+
+    for (i = 0; i < s->nb_active_bands; i++) {
+        if (s->bytestream_end - s->bytestream < s->bands[i].len + 12)
+            return AVERROR_BUG;
+        png_write_image_data(avctx, s->bands[i].buf, s->bands[i].len);
+    }
+
+    return 0;
+}
+
 static int encode_png(AVCodecContext *avctx, AVPacket *pkt,
                       const AVFrame *pict, int *got_packet)
 {
@@ -553,7 +716,10 @@ static int encode_png(AVCodecContext *avctx, AVPacket *pkt,
     if (ret < 0)
         return ret;
 
-    ret = encode_frame(avctx, pict);
+    if (s->bands)
+        ret = encode_frame_bands(avctx, pict);
+    else
+        ret = encode_frame(avctx, pict);
     if (ret < 0)
         return ret;
 
@@ -989,7 +1155,7 @@ static int encode_apng(AVCodecContext *avctx, AVPacket *pkt,
 static av_cold int png_enc_init(AVCodecContext *avctx)
 {
     PNGEncContext *s = avctx->priv_data;
-    int compression_level;
+    int compression_level, i;
 
     switch (avctx->pix_fmt) {
     case AV_PIX_FMT_RGBA:
@@ -1092,14 +1258,49 @@ FF_ENABLE_DEPRECATION_WARNINGS
     if (deflateInit2(&s->zstream, compression_level, Z_DEFLATED, 15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
         return -1;
 
+    if (avctx->codec_id == AV_CODEC_ID_PNG && !s->is_progressive &&
+        avctx->active_thread_type & FF_THREAD_SLICE && avctx->thread_count > 1) {
+        int level_flags;
+
+        s->bands = av_mallocz_array(avctx->thread_count, sizeof(*s->bands));
+        if (!s->bands)
+            return AVERROR(ENOMEM);
+        for (i = 0; i < avctx->thread_count; i++) {
+            z_stream *zstream = &s->bands[i].zstream;
+
+            zstream->zalloc = ff_png_zalloc;
+            zstream->zfree  = ff_png_zfree;
+            zstream->opaque = NULL;
+            /* raw deflate, the zlib wrapper is written once for all bands */
+            if (deflateInit2(zstream, compression_level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                return -1;
+            s->nb_bands++;
+        }
+
+        /* same header as deflate() writes for a 32K window */
+        if (compression_level == Z_DEFAULT_COMPRESSION)
+            compression_level = 6;
+        level_flags = compression_level < 2 ? 0 :
+                      compression_level < 6 ? 1 :
+                      compression_level == 6 ? 2 : 3;
+        s->zlib_header  = (Z_DEFLATED + ((15 - 8) << 4)) << 8 | level_flags << 6;
+        s->zlib_header += 31 - s->zlib_header % 31;
+    }
+
     return 0;
 }
 
 static av_cold int png_enc_close(AVCodecContext *avctx)
 {
     PNGEncContext *s = avctx->priv_data;
+    int i;
 
     deflateEnd(&s->zstream);
+    for (i = 0; i < s->nb_bands; i++) {
+        deflateEnd(&s->bands[i].zstream);
+        av_freep(&s->bands[i].buf);
+    }
+    av_freep(&s->bands);
     av_frame_free(&s->last_frame);
     av_frame_free(&s->prev_frame);
     av_freep(&s->last_frame_packet);
@@ -1146,7 +1347,8 @@ AVCodec ff_png_encoder = {
     .init           = png_enc_init,
     .close          = png_enc_close,
     .encode2        = encode_png,
-    .capabilities   = AV_CODEC_CAP_FRAME_THREADS,
+    .capabilities   = AV_CODEC_CAP_FRAME_THREADS | AV_CODEC_CAP_SLICE_THREADS,
+    .caps_internal  = FF_CODEC_CAP_INIT_CLEANUP,
     .pix_fmts       = (const enum AVPixelFormat[]) {
         AV_PIX_FMT_RGB24, AV_PIX_FMT_RGBA,
         AV_PIX_FMT_RGB48BE, AV_PIX_FMT_RGBA64BE,
@@ -23,6 +23,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include "libavutil/intreadwrite.h"
 #include "libavutil/opt.h"
 #include "libavutil/pixdesc.h"
 #include "avcodec.h"
@@ -32,6 +33,7 @@
 #include "bytestream.h"
 #include "internal.h"
 #include "proresdata.h"
+#include "proresencdsp.h"
 
 #define CFACTOR_Y422 2
 #define CFACTOR_Y444 3
@@ -220,6 +222,7 @@ struct TrellisNode {
 
 typedef struct ProresThreadData {
     DECLARE_ALIGNED(16, int16_t, blocks)[MAX_PLANES][64 * 4 * MAX_MBS_PER_SLICE];
+    DECLARE_ALIGNED(16, int16_t, levels)[64 * 4 * MAX_MBS_PER_SLICE];
     DECLARE_ALIGNED(16, uint16_t, emu_buf)[16 * 16];
     int16_t custom_q[64];
     int16_t custom_chroma_q[64];
@@ -241,6 +244,7 @@ typedef struct ProresContext {
     void (*fdct)(FDCTDSPContext *fdsp, const uint16_t *src,
                  ptrdiff_t linesize, int16_t *block);
     FDCTDSPContext fdsp;
+    ProresEncDSPContext dsp;
 
     const AVFrame *pic;
     int mb_width, mb_height;
@@ -350,13 +354,12 @@ static void get_alpha_data(ProresContext *ctx, const uint16_t *src,
     copy_w = FFMIN(w - x, slice_width);
     copy_h = FFMIN(h - y, 16);
     for (i = 0; i < copy_h; i++) {
-        memcpy(blocks, src, copy_w * sizeof(*src));
         if (abits == 8)
             for (j = 0; j < copy_w; j++)
-                blocks[j] >>= 2;
+                blocks[j] = src[j] >> 2;
         else
             for (j = 0; j < copy_w; j++)
-                blocks[j] = (blocks[j] << 6) | (blocks[j] >> 4);
+                blocks[j] = ((int16_t)src[j] << 6) | ((int16_t)src[j] >> 4);
         for (j = copy_w; j < slice_width; j++)
             blocks[j] = blocks[copy_w - 1];
         blocks += slice_width;
@@ -514,6 +517,26 @@ static void put_alpha_run(PutBitContext *pb, int run)
     }
 }
 
+/**
+ * Count the samples starting at idx that are equal to val.
+ * Alpha planes are mostly long runs, so compare four samples at a time.
+ */
+static av_always_inline int alpha_run_length(const uint16_t *blocks, int idx,
+                                             int num_coeffs, int val)
+{
+    const uint64_t pattern = (uint16_t)val * 0x0001000100010001ULL;
+    const int start = idx;
+
+    if (idx >= num_coeffs || blocks[idx] != (uint16_t)val)
+        return 0;
+    idx++;
+    while (idx + 4 <= num_coeffs && AV_RN64(blocks + idx) == pattern)
+        idx += 4;
+    while (idx < num_coeffs && blocks[idx] == (uint16_t)val)
+        idx++;
+    return idx - start;
+}
+
 // todo alpha quantisation for high quants
 static int encode_alpha_plane(ProresContext *ctx, PutBitContext *pb,
                               int mbs_per_slice, uint16_t *blocks,
@@ -530,17 +553,17 @@ static int encode_alpha_plane(ProresContext *ctx, PutBitContext *pb,
     cur = blocks[idx++];
     put_alpha_diff(pb, cur, prev, abits);
     prev = cur;
-    do {
+    while (idx < num_coeffs) {
+        run  = alpha_run_length(blocks, idx, num_coeffs, prev);
+        idx += run;
+        if (idx == num_coeffs)
+            break;
         cur = blocks[idx++];
-        if (cur != prev) {
-            put_alpha_run (pb, run);
-            put_alpha_diff(pb, cur, prev, abits);
-            prev = cur;
-            run  = 0;
-        } else {
-            run++;
-        }
-    } while (idx < num_coeffs);
+        put_alpha_run (pb, run);
+        put_alpha_diff(pb, cur, prev, abits);
+        prev = cur;
+        run  = 0;
+    }
     if (run)
         put_alpha_run(pb, run);
     flush_put_bits(pb);
@@ -690,9 +713,8 @@ static int estimate_dcs(int *error, int16_t *blocks, int blocks_per_slice,
     return bits;
 }
 
-static int estimate_acs(int *error, int16_t *blocks, int blocks_per_slice,
-                        int plane_size_factor,
-                        const uint8_t *scan, const int16_t *qmat)
+static int estimate_acs(const int16_t *levels, int blocks_per_slice,
+                        int plane_size_factor, const uint8_t *scan)
 {
     int idx, i;
     int run, level, run_cb, lev_cb;
@@ -706,8 +728,7 @@ static int estimate_acs(int *error, int16_t *blocks, int blocks_per_slice,
 
     for (i = 1; i < 64; i++) {
         for (idx = scan[i]; idx < max_coeffs; idx += 64) {
-            level   = blocks[idx] / qmat[scan[i]];
-            *error += FFABS(blocks[idx]) % qmat[scan[i]];
+            level = levels[idx];
             if (level) {
                 abs_level = FFABS(level);
                 bits += estimate_vlc(ff_prores_ac_codebook[run_cb], run);
@@ -737,9 +758,11 @@ static int estimate_slice_plane(ProresContext *ctx, int *error, int plane,
 
     blocks_per_slice = mbs_per_slice * blocks_per_mb;
 
-    bits  = estimate_dcs(error, td->blocks[plane], blocks_per_slice, qmat[0]);
-    bits += estimate_acs(error, td->blocks[plane], blocks_per_slice,
-                         plane_size_factor, ctx->scantable, qmat);
+    bits    = estimate_dcs(error, td->blocks[plane], blocks_per_slice, qmat[0]);
+    *error += ctx->dsp.quantize(td->levels, td->blocks[plane], qmat,
+                                blocks_per_slice);
+    bits   += estimate_acs(td->levels, blocks_per_slice,
+                           plane_size_factor, ctx->scantable);
 
     return FFALIGN(bits, 8);
 }
@@ -761,8 +784,9 @@ static int est_alpha_diff(int cur, int prev, int abits)
 
 static int estimate_alpha_plane(ProresContext *ctx,
                                 const uint16_t *src, ptrdiff_t linesize,
-                                int mbs_per_slice, int16_t *blocks)
+                                int mbs_per_slice, const int16_t *blocks)
 {
+    const uint16_t *ablocks = (const uint16_t *)blocks;
     const int abits = ctx->alpha_bits;
     const int mask  = (1 << abits) - 1;
     const int num_coeffs = mbs_per_slice * 256;
@@ -771,25 +795,25 @@ static int estimate_alpha_plane(ProresContext *ctx,
     int run = 0;
     int bits;
 
-    cur = blocks[idx++];
+    cur = ablocks[idx++];
     bits = est_alpha_diff(cur, prev, abits);
     prev = cur;
-    do {
-        cur = blocks[idx++];
-        if (cur != prev) {
-            if (!run)
-                bits++;
-            else if (run < 0x10)
-                bits += 4;
-            else
-                bits += 15;
-            bits += est_alpha_diff(cur, prev, abits);
-            prev = cur;
-            run  = 0;
-        } else {
-            run++;
-        }
-    } while (idx < num_coeffs);
+    while (idx < num_coeffs) {
+        run  = alpha_run_length(ablocks, idx, num_coeffs, prev);
+        idx += run;
+        if (idx == num_coeffs)
+            break;
+        cur = ablocks[idx++];
+        if (!run)
+            bits++;
+        else if (run < 0x10)
+            bits += 4;
+        else
+            bits += 15;
+        bits += est_alpha_diff(cur, prev, abits);
+        prev = cur;
+        run  = 0;
+    }
 
     if (run) {
         if (run < 0x10)
@@ -1204,6 +1228,7 @@ FF_ENABLE_DEPRECATION_WARNINGS
     ctx->scantable = interlaced ? ff_prores_interlaced_scan
                                 : ff_prores_progressive_scan;
     ff_fdctdsp_init(&ctx->fdsp, avctx);
+    ff_proresencdsp_init(&ctx->dsp);
 
     mps = ctx->mbs_per_slice;
     if (mps & (mps - 1)) {
@@ -0,0 +1,316 @@
+/*
+ * Bitstream reader and writer test and benchmark
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * Round-trip test for the get_bits.h, put_bits.h and golomb.h hot paths,
+ * with an optional speed test (-s) that also covers the CABAC decoder.
+ * This file is compiled a second time as bitstream-cached with
+ * CACHED_BITSTREAM_READER set, so the two bit readers can be compared.
+ */
+
+#include "config.h"
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CONFIG_CABAC
+#include "libavcodec/cabac.c"
+#endif
+
+#include "libavutil/lfg.h"
+#include "libavutil/log.h"
+#include "libavutil/mem.h"
+#include "libavutil/time.h"
+
+#include "libavcodec/avcodec.h"
+#include "libavcodec/get_bits.h"
+#include "libavcodec/golomb.h"
+#include "libavcodec/put_bits.h"
+
+#define COUNT    (1 << 16)
+#define BUF_SIZE (COUNT * 8)
+
+typedef struct BitstreamTest {
+    const char *name;
+    void (*init)(AVLFG *lfg, unsigned *val, uint8_t *len);
+    void (*write)(PutBitContext *pb, const unsigned *val, const uint8_t *len);
+    void (*read)(GetBitContext *gb, unsigned *val, const uint8_t *len);
+} BitstreamTest;
+
+static void init_bits(AVLFG *lfg, unsigned *val, uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++) {
+        len[i] = 1 + av_lfg_get(lfg) % 25;
+        val[i] = av_lfg_get(lfg) & ((1U << len[i]) - 1);
+    }
+}
+
+static void write_bits(PutBitContext *pb, const unsigned *val, const uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++)
+        put_bits(pb, len[i], val[i]);
+}
+
+static void read_bits(GetBitContext *gb, unsigned *val, const uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++)
+        val[i] = get_bits(gb, len[i]);
+}
+
+static void init_bits1(AVLFG *lfg, unsigned *val, uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++) {
+        len[i] = 1;
+        val[i] = av_lfg_get(lfg) & 1;
+    }
+}
+
+static void read_bits1(GetBitContext *gb, unsigned *val, const uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++)
+        val[i] = get_bits1(gb);
+}
+
+/* small values dominate, as they do in real streams; get_ue_golomb()
+ * only handles codes up to 8190 */
+static void init_ue_golomb(AVLFG *lfg, unsigned *val, uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++)
+        val[i] = av_lfg_get(lfg) & ((1U << av_lfg_get(lfg) % 13) - 1);
+}
+
+static void write_ue_golomb(PutBitContext *pb, const unsigned *val, const uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++)
+        set_ue_golomb(pb, val[i]);
+}
+
+static void read_ue_golomb(GetBitContext *gb, unsigned *val, const uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++)
+        val[i] = get_ue_golomb(gb);
+}
+
+static void init_se_golomb(AVLFG *lfg, unsigned *val, uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++) {
+        int v = av_lfg_get(lfg) & ((1U << av_lfg_get(lfg) % 13) - 1);
+        val[i] = av_lfg_get(lfg) & 1 ? -v : v;
+    }
+}
+
+static void write_se_golomb(PutBitContext *pb, const unsigned *val, const uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++)
+        set_se_golomb(pb, (int)val[i]);
+}
+
+static void read_se_golomb(GetBitContext *gb, unsigned *val, const uint8_t *len)
+{
+    int i;
+
+    for (i = 0; i < COUNT; i++)
+        val[i] = get_se_golomb(gb);
+}
+
+static const BitstreamTest tests[] = {
+    { "bits",      init_bits,      write_bits,      read_bits      },
+    { "bits1",     init_bits1,     write_bits,      read_bits1     },
+    { "ue_golomb", init_ue_golomb, write_ue_golomb, read_ue_golomb },
+    { "se_golomb", init_se_golomb, write_se_golomb, read_se_golomb },
+};
+
+static unsigned val_ref[COUNT], val_out[COUNT];
+static uint8_t len_ref[COUNT];
+
+static int write_stream(const BitstreamTest *t, uint8_t *buf)
+{
+    PutBitContext pb;
+
+    init_put_bits(&pb, buf, BUF_SIZE);
+    t->write(&pb, val_ref, len_ref);
+    flush_put_bits(&pb);
+
+    return put_bits_count(&pb);
+}
+
+static void read_stream(const BitstreamTest *t, const uint8_t *buf, int bits)
+{
+    GetBitContext gb;
+
+    init_get_bits(&gb, buf, bits);
+    t->read(&gb, val_out, len_ref);
+}
+
+/* run func for about a second, return the number of runs per second */
+#define SPEED_TEST(func, result)                                \
+    do {                                                        \
+        int64_t ti = av_gettime_relative(), ti1;                \
+        int it = 0;                                             \
+        do {                                                    \
+            func;                                               \
+            it++;                                               \
+            ti1 = av_gettime_relative() - ti;                   \
+        } while (ti1 < 1000000);                                \
+        result = it * 1000000.0 / ti1;                          \
+    } while (0)
+
+static int run_test(const BitstreamTest *t, AVLFG *lfg, uint8_t *buf, int speed)
+{
+    double write_rate, read_rate;
+    int i, bits;
+
+    t->init(lfg, val_ref, len_ref);
+    bits = write_stream(t, buf);
+    read_stream(t, buf, bits);
+
+    for (i = 0; i < COUNT; i++) {
+        if (val_out[i] != val_ref[i]) {
+            fprintf(stderr, "%s: symbol %d: expected %u, got %u\n",
+                    t->name, i, val_ref[i], val_out[i]);
+            return 1;
+        }
+    }
+
+    if (!speed)
+        return 0;
+
+    SPEED_TEST(write_stream(t, buf), write_rate);
+    SPEED_TEST(read_stream(t, buf, bits), read_rate);
+    printf("%-10s read: %7.1f Msym/s %7.1f Mbit/s  write: %7.1f Msym/s\n",
+           t->name, read_rate * COUNT / 1e6, read_rate * bits / 1e6,
+           write_rate * COUNT / 1e6);
+
+    return 0;
+}
+
+#if CONFIG_CABAC
+/* Any byte sequence is a valid CABAC stream, so random data is decoded
+ * with a set of adaptive contexts and interleaved bypass bins. */
+static int decode_cabac(const uint8_t *buf)
+{
+    CABACContext c;
+    uint8_t state[64];
+    int i, sum = 0;
+
+    for (i = 0; i < FF_ARRAY_ELEMS(state); i++)
+        state[i] = i;
+    if (ff_init_cabac_decoder(&c, buf, BUF_SIZE) < 0)
+        return 0;
+    for (i = 0; i < COUNT; i++) {
+        sum += get_cabac(&c, &state[i & 63]);
+        sum += get_cabac_bypass(&c);
+    }
+
+    return sum;
+}
+
+static void run_cabac_test(AVLFG *lfg, uint8_t *buf)
+{
+    volatile int av_unused sum;
+    double rate;
+    int i;
+
+    for (i = 0; i < BUF_SIZE; i++)
+        buf[i] = av_lfg_get(lfg);
+    SPEED_TEST(sum = decode_cabac(buf), rate);
+    printf("%-10s read: %7.1f Mbin/s\n", "cabac", rate * 2 * COUNT / 1e6);
+}
+#endif
+
+#if !HAVE_GETOPT
+#include "compat/getopt.c"
+#endif
+
+static void help(void)
+{
+    printf("usage: bitstream [-h] [-s]\n"
+           "-h     print this help\n"
+           "-s     speed test\n");
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t *buf;
+    AVLFG lfg;
+    int i, ret = 0, speed = 0;
+
+    for (;;) {
+        int c = getopt(argc, argv, "hs");
+        if (c == -1)
+            break;
+        switch (c) {
+        case 's':
+            speed = 1;
+            break;
+        default:
+            help();
+            return 1;
+        }
+    }
+
+    buf = av_malloc(BUF_SIZE + AV_INPUT_BUFFER_PADDING_SIZE);
+    if (!buf)
+        return 2;
+    memset(buf + BUF_SIZE, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+
+    if (speed)
+        printf("reader: %s\n", CACHED_BITSTREAM_READER ?
+               "64-bit cache" : "32-bit unaligned loads");
+
+    av_lfg_init(&lfg, 0xb175);
+    for (i = 0; i < FF_ARRAY_ELEMS(tests); i++)
+        ret |= run_test(&tests[i], &lfg, buf, speed);
+
+#if CONFIG_CABAC
+    if (speed)
+        run_cabac_test(&lfg, buf);
+#endif
+
+    av_free(buf);
+
+    return ret;
+}
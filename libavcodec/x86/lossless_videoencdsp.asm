@@ -192,3 +192,51 @@ cglobal sub_left_predict, 5,6,5, dst, src, stride, width, height, x
     dec  heightd
     jg .loop
     RET
+
+;--------------------------------------------------------------------------------------------------
+;int sum_abs_int8(const uint8_t *src, intptr_t w)
+;--------------------------------------------------------------------------------------------------
+
+INIT_XMM sse2
+cglobal sum_abs_int8, 2,5,4, src, w, x, tmp, sum
+    pxor             m0, m0
+    pxor             m3, m3
+    mov              xq, wq
+    and              xq, -mmsize
+    add            srcq, xq
+    neg              xq
+    jz .tail
+
+.loop:
+    movu             m1, [srcq + xq]
+    pxor             m2, m2
+    pcmpgtb          m2, m1 ; sign mask
+    pxor             m1, m2
+    psubb            m1, m2 ; |x|, -128 becomes 0x80
+    psadbw           m1, m3
+    paddq            m0, m1
+    add              xq, mmsize
+    jl .loop
+
+.tail:
+    xor            sumd, sumd
+    and              wq, mmsize - 1
+    jz .end
+
+.tail_loop:
+    movsx          tmpd, byte [srcq]
+    mov              xd, tmpd
+    sar              xd, 31
+    xor            tmpd, xd
+    sub            tmpd, xd
+    add            sumd, tmpd
+    inc            srcq
+    dec              wq
+    jg .tail_loop
+
+.end:
+    movhlps          m1, m0
+    paddq            m0, m1
+    movd            eax, m0
+    add             eax, sumd
+    RET
@@ -39,6 +39,8 @@ void ff_diff_bytes_avx2(uint8_t *dst, const uint8_t *src1, const uint8_t *src2,
 void ff_sub_left_predict_avx(uint8_t *dst, uint8_t *src,
                             ptrdiff_t stride, ptrdiff_t width, int height);
 
+int ff_sum_abs_int8_sse2(const uint8_t *src, intptr_t w);
+
 #if HAVE_INLINE_ASM
 
 static void sub_median_pred_mmxext(uint8_t *dst, const uint8_t *src1,
@@ -98,7 +100,8 @@ av_cold void ff_llvidencdsp_init_x86(LLVidEncDSPContext *c)
 #endif /* HAVE_INLINE_ASM */
 
     if (EXTERNAL_SSE2(cpu_flags)) {
-        c->diff_bytes = ff_diff_bytes_sse2;
+        c->diff_bytes   = ff_diff_bytes_sse2;
+        c->sum_abs_int8 = ff_sum_abs_int8_sse2;
     }
 
     if (EXTERNAL_AVX(cpu_flags)) {
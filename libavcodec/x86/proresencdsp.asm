@@ -0,0 +1,86 @@
+;******************************************************************************
+;* x86-SIMD-optimized functions for the ProRes encoder
+;*
+;* This file is part of FFmpeg.
+;*
+;* FFmpeg is free software; you can redistribute it and/or
+;* modify it under the terms of the GNU Lesser General Public
+;* License as published by the Free Software Foundation; either
+;* version 2.1 of the License, or (at your option) any later version.
+;*
+;* FFmpeg is distributed in the hope that it will be useful,
+;* but WITHOUT ANY WARRANTY; without even the implied warranty of
+;* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+;* Lesser General Public License for more details.
+;*
+;* You should have received a copy of the GNU Lesser General Public
+;* License along with FFmpeg; if not, write to the Free Software
+;* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+;******************************************************************************
+
+%include "libavutil/x86/x86util.asm"
+
+SECTION_RODATA
+
+pw_ac_mask: dw 0, -1, -1, -1, -1, -1, -1, -1
+
+SECTION .text
+
+cextern pw_1
+
+; Both operands are below 2^24 in magnitude, so the single precision
+; quotient truncates to the same value as the integer division.
+;
+; %1 = coefficient offset in bytes
+%macro QUANT8 1
+    mova              m0, [srcq + %1]
+    movu              m1, [qmatq + %1]
+    punpcklwd         m2, m0
+    punpckhwd         m3, m0
+    punpcklwd         m4, m1
+    punpckhwd         m5, m1
+    psrad             m2, 16
+    psrad             m3, 16
+    psrad             m4, 16
+    psrad             m5, 16
+    cvtdq2ps          m2, m2
+    cvtdq2ps          m3, m3
+    cvtdq2ps          m4, m4
+    cvtdq2ps          m5, m5
+    divps             m2, m4
+    divps             m3, m5
+    cvttps2dq         m2, m2
+    cvttps2dq         m3, m3
+    packssdw          m2, m3
+    mova     [dstq + %1], m2
+    ; the remainder has the sign of the coefficient and |rem| < qmat
+    pmullw            m2, m1
+    psubw             m0, m2
+    ABS1              m0, m3
+%if %1 == 0
+    pand              m0, [pw_ac_mask]
+%endif
+    pmaddwd           m0, m6
+    paddd             m7, m0
+%endmacro
+
+; int ff_prores_quantize(int16_t *dst, const int16_t *src,
+;                        const int16_t *qmat, int nb_blocks)
+INIT_XMM sse2
+cglobal prores_quantize, 4, 4, 8, dst, src, qmat, blocks
+    pxor              m7, m7
+    mova              m6, [pw_1]
+.loop:
+%assign i 0
+%rep 8
+    QUANT8 i
+%assign i i + mmsize
+%endrep
+    add             srcq, 128
+    add             dstq, 128
+    dec          blocksd
+    jg .loop
+
+    HADDD             m7, m0
+    movd             eax, m7
+    RET
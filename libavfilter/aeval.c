@@ -70,9 +70,13 @@ typedef struct EvalContext {
     uint64_t n;
     double var_values[VAR_VARS_NB];
     double *channel_values;
+    int uses_val;               ///< some expression reads the input with val()
     int64_t out_channel_layout;
 } EvalContext;
 
+/* number of samples evaluated by one av_expr_eval_row() call */
+#define ROW_CHUNK 256
+
 static double val(void *priv, double ch)
 {
     EvalContext *eval = priv;
@@ -164,6 +168,13 @@ static int parse_channel_expressions(AVFilterContext *ctx,
         goto end;
     }
 
+    eval->uses_val = 0;
+    for (i = 0; i < eval->nb_channels; i++) {
+        unsigned counter[1] = { 0 };
+        av_expr_count_func(eval->expr[i], counter, FF_ARRAY_ELEMS(counter), 1);
+        eval->uses_val |= !!counter[0];
+    }
+
 end:
     av_free(args1);
     return ret;
@@ -275,7 +286,7 @@ static int request_frame(AVFilterLink *outlink)
 {
     EvalContext *eval = outlink->src->priv;
     AVFrame *samplesref;
-    int i, j;
+    int i, j, k, ret;
     int64_t t = av_rescale(eval->n, AV_TIME_BASE, eval->sample_rate);
     int nb_samples;
 
@@ -293,14 +304,24 @@ static int request_frame(AVFilterLink *outlink)
     if (!samplesref)
         return AVERROR(ENOMEM);
 
-    /* evaluate expression for each single sample and for each channel */
-    for (i = 0; i < nb_samples; i++, eval->n++) {
-        eval->var_values[VAR_N] = eval->n;
-        eval->var_values[VAR_T] = eval->var_values[VAR_N] * (double)1/eval->sample_rate;
+    /* evaluate expression for each channel on a chunk of samples */
+    for (i = 0; i < nb_samples; i += ROW_CHUNK) {
+        const int n = FFMIN(nb_samples - i, ROW_CHUNK);
+        double ns[ROW_CHUNK], ts[ROW_CHUNK];
+        const double *rows[VAR_VARS_NB] = { [VAR_N] = ns, [VAR_T] = ts };
+
+        for (k = 0; k < n; k++, eval->n++) {
+            ns[k] = eval->n;
+            ts[k] = ns[k] * (double)1/eval->sample_rate;
+        }
 
         for (j = 0; j < eval->nb_channels; j++) {
-            *((double *) samplesref->extended_data[j] + i) =
-                av_expr_eval(eval->expr[j], eval->var_values, NULL);
+            ret = av_expr_eval_row(eval->expr[j], (double *)samplesref->extended_data[j] + i,
+                                   n, eval->var_values, rows, NULL);
+            if (ret < 0) {
+                av_frame_free(&samplesref);
+                return ret;
+            }
         }
     }
 
@@ -425,7 +446,7 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
     int nb_samples        = in->nb_samples;
     AVFrame *out;
     double t0;
-    int i, j;
+    int i, j, k, ret;
 
     out = ff_get_audio_buffer(outlink, nb_samples);
     if (!out) {
@@ -436,6 +457,35 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
 
     t0 = TS2T(in->pts, inlink->time_base);
 
+    if (!eval->uses_val) {
+        /* the expressions only depend on the time, evaluate each channel
+         * on a chunk of samples */
+        for (i = 0; i < nb_samples; i += ROW_CHUNK) {
+            const int n = FFMIN(nb_samples - i, ROW_CHUNK);
+            double ns[ROW_CHUNK], ts[ROW_CHUNK];
+            const double *rows[VAR_VARS_NB] = { [VAR_N] = ns, [VAR_T] = ts };
+
+            for (k = 0; k < n; k++, eval->n++) {
+                ns[k] = eval->n;
+                ts[k] = t0 + (i + k) * (double)1/inlink->sample_rate;
+            }
+
+            for (j = 0; j < outlink->channels; j++) {
+                eval->var_values[VAR_CH] = j;
+                ret = av_expr_eval_row(eval->expr[j], (double *)out->extended_data[j] + i,
+                                       n, eval->var_values, rows, eval);
+                if (ret < 0) {
+                    av_frame_free(&in);
+                    av_frame_free(&out);
+                    return ret;
+                }
+            }
+        }
+
+        av_frame_free(&in);
+        return ff_filter_frame(outlink, out);
+    }
+
     /* evaluate expression for each single sample and for each channel */
     for (i = 0; i < nb_samples; i++, eval->n++) {
         eval->var_values[VAR_N] = eval->n;
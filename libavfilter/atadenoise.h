@@ -37,6 +37,7 @@ typedef struct ATADenoiseDSPContext {
                        int thra, int thrb);
 } ATADenoiseDSPContext;
 
+void ff_atadenoise_init(ATADenoiseDSPContext *dsp, int depth, int algorithm);
 void ff_atadenoise_init_x86(ATADenoiseDSPContext *dsp, int depth, int algorithm);
 
 #endif /* AVFILTER_ATADENOISE_H */
@@ -47,6 +47,9 @@ AVFrame *ff_default_get_audio_buffer(AVFilterLink *link, int nb_samples)
                                                     nb_samples, link->format, BUFFER_ALIGN);
         if (!link->frame_pool)
             return NULL;
+        if (link->graph && link->graph->prewarm_frames > 0 &&
+            ff_frame_pool_prewarm(link->frame_pool, link->graph->prewarm_frames) < 0)
+            return NULL;
     } else {
         int pool_channels = 0;
         int pool_nb_samples = 0;
@@ -67,6 +70,9 @@ AVFrame *ff_default_get_audio_buffer(AVFilterLink *link, int nb_samples)
                                                         nb_samples, link->format, BUFFER_ALIGN);
             if (!link->frame_pool)
                 return NULL;
+            if (link->graph && link->graph->prewarm_frames > 0 &&
+                ff_frame_pool_prewarm(link->frame_pool, link->graph->prewarm_frames) < 0)
+                return NULL;
         }
     }
 
@@ -294,6 +294,16 @@ static void cqt_calc(FFTComplex *dst, const FFTComplex *src, const Coeffs *coeff
     }
 }
 
+void ff_showcqt_init(ShowCQTContext *s)
+{
+    s->cqt_align = 1;
+    s->cqt_calc = cqt_calc;
+    s->permute_coeffs = NULL;
+
+    if (ARCH_X86)
+        ff_showcqt_init_x86(s);
+}
+
 static int init_cqt(ShowCQTContext *s)
 {
     const char *var_names[] = { "timeclamp", "tc", "frequency", "freq", "f", NULL };
@@ -1402,9 +1412,7 @@ static int config_output(AVFilterLink *outlink)
         }
     }
 
-    s->cqt_align = 1;
-    s->cqt_calc = cqt_calc;
-    s->permute_coeffs = NULL;
+    ff_showcqt_init(s);
     s->draw_sono = draw_sono;
     if (s->format == AV_PIX_FMT_RGB24) {
         s->draw_bar = draw_bar_rgb;
@@ -1416,9 +1424,6 @@ static int config_output(AVFilterLink *outlink)
         s->update_sono = update_sono_yuv;
     }
 
-    if (ARCH_X86)
-        ff_showcqt_init_x86(s);
-
     if ((ret = init_cqt(s)) < 0)
         return ret;
 
@@ -122,6 +122,7 @@ typedef struct ShowCQTContext {
     char                *cscheme;
 } ShowCQTContext;
 
+void ff_showcqt_init(ShowCQTContext *s);
 void ff_showcqt_init_x86(ShowCQTContext *s);
 
 #endif
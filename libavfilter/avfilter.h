@@ -896,6 +896,15 @@ typedef struct AVFilterGraph {
 
     char *aresample_swr_opts; ///< swr options to use for the auto-inserted aresample filters, Access ONLY through AVOptions
 
+    /**
+     * Number of frames to preallocate in the frame pool of a link whenever
+     * it is (re)created, see av_buffer_pool_prewarm(). 0 disables
+     * prewarming.
+     *
+     * May be set by the caller before avfilter_graph_config().
+     */
+    int prewarm_frames;
+
     /**
      * Private fields
      *
@@ -56,6 +56,8 @@ static const AVOption filtergraph_options[] = {
         AV_OPT_TYPE_STRING, {.str = NULL}, 0, 0, F|V },
     {"aresample_swr_opts"   , "default aresample filter options"    , OFFSET(aresample_swr_opts)    ,
         AV_OPT_TYPE_STRING, {.str = NULL}, 0, 0, F|A },
+    { "prewarm_frames", "Number of frames to preallocate in the frame pool of each link",
+        OFFSET(prewarm_frames), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, INT_MAX, F|V|A },
     { NULL },
 };
 
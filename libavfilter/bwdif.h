@@ -37,6 +37,10 @@ typedef struct BWDIFContext {
                         int parity, int clip_max, int spat);
 } BWDIFContext;
 
+/**
+ * Set up the line filters for the bit depth of bwdif->yadif.csp.
+ */
+void ff_bwdif_init(BWDIFContext *bwdif);
 void ff_bwdif_init_x86(BWDIFContext *bwdif);
 
 #endif /* AVFILTER_BWDIF_H */
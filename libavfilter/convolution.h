@@ -60,5 +60,6 @@ typedef struct ConvolutionContext {
                       int dstride, int stride);
 } ConvolutionContext;
 
+void ff_convolution_init(ConvolutionContext *s, int depth);
 void ff_convolution_init_x86(ConvolutionContext *s);
 #endif
@@ -281,6 +281,23 @@ fail:
     return NULL;
 }
 
+int ff_frame_pool_prewarm(FFFramePool *pool, int nb_frames)
+{
+    int i, ret;
+
+    /* planar audio frames take one buffer per plane from the same pool */
+    if (pool->type == AVMEDIA_TYPE_AUDIO)
+        nb_frames = FFMIN((int64_t)nb_frames * pool->planes, INT_MAX);
+
+    for (i = 0; i < 4 && pool->pools[i]; i++) {
+        ret = av_buffer_pool_prewarm(pool->pools[i], nb_frames);
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 void ff_frame_pool_uninit(FFFramePool **pool)
 {
     int i;
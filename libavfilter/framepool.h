@@ -106,6 +106,13 @@ int ff_frame_pool_get_audio_config(FFFramePool *pool,
                                    int *align);
 
 
+/**
+ * Preallocate the buffers of nb_frames frames, see av_buffer_pool_prewarm().
+ *
+ * @return 0 on success, a negative AVERROR otherwise.
+ */
+int ff_frame_pool_prewarm(FFFramePool *pool, int nb_frames);
+
 /**
  * Allocate a new AVFrame, reussing old buffers from the pool when available.
  * This function may be called simultaneously from multiple threads.
@@ -28,6 +28,7 @@ typedef struct LimiterDSPContext {
                     int w, int h, int min, int max);
 } LimiterDSPContext;
 
+void ff_limiter_init(LimiterDSPContext *dsp, int bpp);
 void ff_limiter_init_x86(LimiterDSPContext *dsp, int bpp);
 
 #endif /* AVFILTER_LIMITER_H */
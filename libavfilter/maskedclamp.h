@@ -30,6 +30,7 @@ typedef struct MaskedClampDSPContext {
                         int w, int undershoot, int overshoot);
 } MaskedClampDSPContext;
 
+void ff_maskedclamp_init(MaskedClampDSPContext *dsp, int depth);
 void ff_maskedclamp_init_x86(MaskedClampDSPContext *dsp, int depth);
 
 #endif /* AVFILTER_MASKEDCLAMP_H */
@@ -41,6 +41,7 @@ typedef struct MaskedMergeContext {
                         int half, int shift);
 } MaskedMergeContext;
 
+void ff_maskedmerge_init(MaskedMergeContext *s);
 void ff_maskedmerge_init_x86(MaskedMergeContext *s);
 
 #endif /* AVFILTER_MASKEDMERGE_H */
@@ -31,6 +31,7 @@ typedef struct Stereo3DDSPContext {
                      const int *ana_matrix_r, const int *ana_matrix_g, const int *ana_matrix_b);
 } Stereo3DDSPContext;
 
+void ff_stereo3d_init(Stereo3DDSPContext *dsp);
 void ff_stereo3d_init_x86(Stereo3DDSPContext *dsp);
 
 #endif /* AVFILTER_STEREO3D_H */
@@ -80,6 +80,7 @@ typedef struct TInterlaceContext {
                          ptrdiff_t mref, ptrdiff_t pref, int clip_max);
 } TInterlaceContext;
 
+void ff_tinterlace_init(TInterlaceContext *s);
 void ff_tinterlace_init_x86(TInterlaceContext *interlace);
 
 #endif /* AVFILTER_TINTERLACE_H */
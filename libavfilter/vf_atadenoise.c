@@ -234,6 +234,17 @@ static void filter_row##name##_serial(const uint8_t *ssrc, uint8_t *ddst,   \
 FILTER_ROW_SERIAL(uint8_t, 8)
 FILTER_ROW_SERIAL(uint16_t, 16)
 
+void ff_atadenoise_init(ATADenoiseDSPContext *dsp, int depth, int algorithm)
+{
+    if (depth == 8)
+        dsp->filter_row = algorithm == PARALLEL ? filter_row8 : filter_row8_serial;
+    else
+        dsp->filter_row = algorithm == PARALLEL ? filter_row16 : filter_row16_serial;
+
+    if (ARCH_X86)
+        ff_atadenoise_init_x86(dsp, depth, algorithm);
+}
+
 static int filter_slice(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
 {
     ATADenoiseContext *s = ctx->priv;
@@ -296,10 +307,7 @@ static int config_input(AVFilterLink *inlink)
 
     depth = desc->comp[0].depth;
     s->filter_slice = filter_slice;
-    if (depth == 8)
-        s->dsp.filter_row = s->algorithm == PARALLEL ? filter_row8 : filter_row8_serial;
-    else
-        s->dsp.filter_row = s->algorithm == PARALLEL ? filter_row16 : filter_row16_serial;
+    ff_atadenoise_init(&s->dsp, depth, s->algorithm);
 
     s->thra[0] = s->fthra[0] * (1 << depth) - 1;
     s->thra[1] = s->fthra[1] * (1 << depth) - 1;
@@ -308,9 +316,6 @@ static int config_input(AVFilterLink *inlink)
     s->thrb[1] = s->fthrb[1] * (1 << depth) - 1;
     s->thrb[2] = s->fthrb[2] * (1 << depth) - 1;
 
-    if (ARCH_X86)
-        ff_atadenoise_init_x86(&s->dsp, depth, s->algorithm);
-
     return 0;
 }
 
@@ -555,6 +555,29 @@ static int filter_slice(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
     return 0;
 }
 
+void ff_convolution_init(ConvolutionContext *s, int depth)
+{
+    int p;
+
+    for (p = 0; p < 4; p++) {
+        if (s->mode[p] == MATRIX_ROW)
+            s->filter[p] = depth > 8 ? filter16_row    : filter_row;
+        else if (s->mode[p] == MATRIX_COLUMN)
+            s->filter[p] = depth > 8 ? filter16_column : filter_column;
+        else if (s->size[p] == 3)
+            s->filter[p] = depth > 8 ? filter16_3x3    : filter_3x3;
+        else if (s->size[p] == 5)
+            s->filter[p] = depth > 8 ? filter16_5x5    : filter_5x5;
+        else if (s->size[p] == 7)
+            s->filter[p] = depth > 8 ? filter16_7x7    : filter_7x7;
+    }
+
+#if CONFIG_CONVOLUTION_FILTER && ARCH_X86_64
+    if (depth == 8)
+        ff_convolution_init_x86(s);
+#endif
+}
+
 static int config_input(AVFilterLink *inlink)
 {
     AVFilterContext *ctx = inlink->dst;
@@ -575,23 +598,7 @@ static int config_input(AVFilterLink *inlink)
     s->bpc = (s->depth + 7) / 8;
 
     if (!strcmp(ctx->filter->name, "convolution")) {
-        if (s->depth > 8) {
-            for (p = 0; p < s->nb_planes; p++) {
-                if (s->mode[p] == MATRIX_ROW)
-                    s->filter[p] = filter16_row;
-                else if (s->mode[p] == MATRIX_COLUMN)
-                    s->filter[p] = filter16_column;
-                else if (s->size[p] == 3)
-                    s->filter[p] = filter16_3x3;
-                else if (s->size[p] == 5)
-                    s->filter[p] = filter16_5x5;
-                else if (s->size[p] == 7)
-                    s->filter[p] = filter16_7x7;
-            }
-        }
-#if CONFIG_CONVOLUTION_FILTER && ARCH_X86_64
-        ff_convolution_init_x86(s);
-#endif
+        ff_convolution_init(s, s->depth);
     } else if (!strcmp(ctx->filter->name, "prewitt")) {
         if (s->depth > 8)
             for (p = 0; p < s->nb_planes; p++)
@@ -659,33 +666,25 @@ static av_cold int init(AVFilterContext *ctx)
                 return AVERROR(EINVAL);
             }
             if (s->mode[i] == MATRIX_ROW) {
-                s->filter[i] = filter_row;
                 s->setup[i] = setup_row;
                 s->size[i] = s->matrix_length[i];
             } else if (s->mode[i] == MATRIX_COLUMN) {
-                s->filter[i] = filter_column;
                 s->setup[i] = setup_column;
                 s->size[i] = s->matrix_length[i];
             } else if (s->matrix_length[i] == 9) {
                 s->size[i] = 3;
                 if (!memcmp(matrix, same3x3, sizeof(same3x3)))
                     s->copy[i] = 1;
-                else
-                    s->filter[i] = filter_3x3;
                 s->setup[i] = setup_3x3;
             } else if (s->matrix_length[i] == 25) {
                 s->size[i] = 5;
                 if (!memcmp(matrix, same5x5, sizeof(same5x5)))
                     s->copy[i] = 1;
-                else
-                    s->filter[i] = filter_5x5;
                 s->setup[i] = setup_5x5;
             } else if (s->matrix_length[i] == 49) {
                 s->size[i] = 7;
                 if (!memcmp(matrix, same7x7, sizeof(same7x7)))
                     s->copy[i] = 1;
-                else
-                    s->filter[i] = filter_7x7;
                 s->setup[i] = setup_7x7;
             } else {
                 return AVERROR(EINVAL);
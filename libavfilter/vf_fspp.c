@@ -490,6 +490,19 @@ static void row_fdct_c(int16_t *data, const uint8_t *pixels, ptrdiff_t line_size
     }
 }
 
+void ff_fspp_init(FSPPContext *fspp)
+{
+    fspp->store_slice  = store_slice_c;
+    fspp->store_slice2 = store_slice2_c;
+    fspp->mul_thrmat   = mul_thrmat_c;
+    fspp->column_fidct = column_fidct_c;
+    fspp->row_idct     = row_idct_c;
+    fspp->row_fdct     = row_fdct_c;
+
+    if (ARCH_X86)
+        ff_fspp_init_x86(fspp);
+}
+
 static int query_formats(AVFilterContext *ctx)
 {
     static const enum AVPixelFormat pix_fmts[] = {
@@ -532,15 +545,7 @@ static int config_input(AVFilterLink *inlink)
             return AVERROR(ENOMEM);
     }
 
-    fspp->store_slice  = store_slice_c;
-    fspp->store_slice2 = store_slice2_c;
-    fspp->mul_thrmat   = mul_thrmat_c;
-    fspp->column_fidct = column_fidct_c;
-    fspp->row_idct     = row_idct_c;
-    fspp->row_fdct     = row_fdct_c;
-
-    if (ARCH_X86)
-        ff_fspp_init_x86(fspp);
+    ff_fspp_init(fspp);
 
     return 0;
 }
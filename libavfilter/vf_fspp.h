@@ -90,6 +90,7 @@ typedef struct FSPPContext {
 
 } FSPPContext;
 
+void ff_fspp_init(FSPPContext *fspp);
 void ff_fspp_init_x86(FSPPContext *fspp);
 
 #endif /* AVFILTER_FSPP_H */
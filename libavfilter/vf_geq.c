@@ -367,6 +367,9 @@ typedef struct ThreadData {
     int linesize;
 } ThreadData;
 
+/* number of pixels evaluated by one av_expr_eval_row() call */
+#define ROW_CHUNK 128
+
 static int slice_geq_filter(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
 {
     GEQContext *geq = ctx->priv;
@@ -377,9 +380,11 @@ static int slice_geq_filter(AVFilterContext *ctx, void *arg, int jobnr, int nb_j
     const int linesize = td->linesize;
     const int slice_start = (height *  jobnr) / nb_jobs;
     const int slice_end = (height * (jobnr+1)) / nb_jobs;
-    int x, y;
+    int x, y, i, ret;
 
     double values[VAR_VARS_NB];
+    double xs[ROW_CHUNK], res[ROW_CHUNK];
+    const double *rows[VAR_VARS_NB] = { [VAR_X] = xs };
     values[VAR_W] = geq->values[VAR_W];
     values[VAR_H] = geq->values[VAR_H];
     values[VAR_N] = geq->values[VAR_N];
@@ -387,26 +392,27 @@ static int slice_geq_filter(AVFilterContext *ctx, void *arg, int jobnr, int nb_j
     values[VAR_SH] = geq->values[VAR_SH];
     values[VAR_T] = geq->values[VAR_T];
 
-    if (geq->bps == 8) {
-        uint8_t *ptr = geq->dst + linesize * slice_start;
-        for (y = slice_start; y < slice_end; y++) {
-            values[VAR_Y] = y;
+    for (y = slice_start; y < slice_end; y++) {
+        uint8_t  *ptr   = geq->dst   +  linesize    * y;
+        uint16_t *ptr16 = geq->dst16 + (linesize/2) * y;
+        values[VAR_Y] = y;
 
-            for (x = 0; x < width; x++) {
-                values[VAR_X] = x;
-                ptr[x] = av_expr_eval(geq->e[plane][jobnr], values, geq);
-            }
-            ptr += linesize;
-        }
-    } else {
-        uint16_t *ptr16 = geq->dst16 + (linesize/2) * slice_start;
-        for (y = slice_start; y < slice_end; y++) {
-            values[VAR_Y] = y;
-            for (x = 0; x < width; x++) {
-                values[VAR_X] = x;
-                ptr16[x] = av_expr_eval(geq->e[plane][jobnr], values, geq);
+        for (x = 0; x < width; x += ROW_CHUNK) {
+            const int n = FFMIN(width - x, ROW_CHUNK);
+
+            for (i = 0; i < n; i++)
+                xs[i] = x + i;
+            ret = av_expr_eval_row(geq->e[plane][jobnr], res, n, values, rows, geq);
+            if (ret < 0)
+                return ret;
+
+            if (geq->bps == 8) {
+                for (i = 0; i < n; i++)
+                    ptr[x + i] = res[i];
+            } else {
+                for (i = 0; i < n; i++)
+                    ptr16[x + i] = res[i];
             }
-            ptr16 += linesize/2;
         }
     }
 
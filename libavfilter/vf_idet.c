@@ -110,6 +110,15 @@ int ff_idet_filter_line_c_16bit(const uint16_t *a, const uint16_t *b, const uint
     return ret;
 }
 
+void ff_idet_init(IDETContext *idet, int for_16b)
+{
+    idet->filter_line = for_16b ? (ff_idet_filter_func)ff_idet_filter_line_c_16bit
+                                : ff_idet_filter_line_c;
+
+    if (ARCH_X86)
+        ff_idet_init_x86(idet, for_16b);
+}
+
 static void filter(AVFilterContext *ctx)
 {
     IDETContext *idet = ctx->priv;
@@ -275,11 +284,8 @@ static int filter_frame(AVFilterLink *link, AVFrame *picref)
 
     if (!idet->csp)
         idet->csp = av_pix_fmt_desc_get(link->format);
-    if (idet->csp->comp[0].depth > 8){
-        idet->filter_line = (ff_idet_filter_func)ff_idet_filter_line_c_16bit;
-        if (ARCH_X86)
-            ff_idet_init_x86(idet, 1);
-    }
+    if (idet->csp->comp[0].depth > 8)
+        ff_idet_init(idet, 1);
 
     if (idet->analyze_interlaced_flag) {
         if (idet->cur->interlaced_frame) {
@@ -415,10 +421,7 @@ static av_cold int init(AVFilterContext *ctx)
     else
         idet->decay_coefficient = PRECISION;
 
-    idet->filter_line = ff_idet_filter_line_c;
-
-    if (ARCH_X86)
-        ff_idet_init_x86(idet, 0);
+    ff_idet_init(idet, 0);
 
     return 0;
 }
@@ -133,6 +133,18 @@ static void limiter16(const uint8_t *ssrc, uint8_t *ddst,
     }
 }
 
+void ff_limiter_init(LimiterDSPContext *dsp, int bpp)
+{
+    if (bpp == 8) {
+        dsp->limiter = limiter8;
+    } else {
+        dsp->limiter = limiter16;
+    }
+
+    if (ARCH_X86)
+        ff_limiter_init_x86(dsp, bpp);
+}
+
 static int config_props(AVFilterLink *inlink)
 {
     AVFilterContext *ctx = inlink->dst;
@@ -156,14 +168,7 @@ static int config_props(AVFilterLink *inlink)
     s->max = FFMIN(s->max, (1 << depth) - 1);
     s->min = FFMIN(s->min, (1 << depth) - 1);
 
-    if (depth == 8) {
-        s->dsp.limiter = limiter8;
-    } else {
-        s->dsp.limiter = limiter16;
-    }
-
-    if (ARCH_X86)
-        ff_limiter_init_x86(&s->dsp, desc->comp[0].depth);
+    ff_limiter_init(&s->dsp, depth);
 
     return 0;
 }
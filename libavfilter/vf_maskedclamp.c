@@ -186,6 +186,17 @@ static void maskedclamp##name(const uint8_t *bbsrc, uint8_t *ddst,
 MASKEDCLAMP(uint8_t, 8)
 MASKEDCLAMP(uint16_t, 16)
 
+void ff_maskedclamp_init(MaskedClampDSPContext *dsp, int depth)
+{
+    if (depth <= 8)
+        dsp->maskedclamp = maskedclamp8;
+    else
+        dsp->maskedclamp = maskedclamp16;
+
+    if (ARCH_X86)
+        ff_maskedclamp_init_x86(dsp, depth);
+}
+
 static int config_input(AVFilterLink *inlink)
 {
     AVFilterContext *ctx = inlink->dst;
@@ -209,13 +220,7 @@ static int config_input(AVFilterLink *inlink)
     s->undershoot = FFMIN(s->undershoot, (1 << s->depth) - 1);
     s->overshoot = FFMIN(s->overshoot, (1 << s->depth) - 1);
 
-    if (s->depth <= 8)
-        s->dsp.maskedclamp = maskedclamp8;
-    else
-        s->dsp.maskedclamp = maskedclamp16;
-
-    if (ARCH_X86)
-        ff_maskedclamp_init_x86(&s->dsp, s->depth);
+    ff_maskedclamp_init(&s->dsp, s->depth);
 
     return 0;
 }
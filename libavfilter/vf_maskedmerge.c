@@ -188,6 +188,17 @@ static void maskedmerge16(const uint8_t *bbsrc, const uint8_t *oosrc,
     }
 }
 
+void ff_maskedmerge_init(MaskedMergeContext *s)
+{
+    if (s->depth == 8)
+        s->maskedmerge = maskedmerge8;
+    else
+        s->maskedmerge = maskedmerge16;
+
+    if (ARCH_X86)
+        ff_maskedmerge_init_x86(s);
+}
+
 static int config_input(AVFilterLink *inlink)
 {
     AVFilterContext *ctx = inlink->dst;
@@ -207,13 +218,7 @@ static int config_input(AVFilterLink *inlink)
     s->depth = desc->comp[0].depth;
     s->half = (1 << s->depth) / 2;
 
-    if (desc->comp[0].depth == 8)
-        s->maskedmerge = maskedmerge8;
-    else
-        s->maskedmerge = maskedmerge16;
-
-    if (ARCH_X86)
-        ff_maskedmerge_init_x86(s);
+    ff_maskedmerge_init(s);
 
     return 0;
 }
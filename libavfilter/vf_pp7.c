@@ -137,6 +137,14 @@ static void dctB_c(int16_t *dst, int16_t *src)
     }
 }
 
+void ff_pp7_init(PP7Context *pp7)
+{
+    pp7->dctB = dctB_c;
+
+    if (ARCH_X86)
+        ff_pp7_init_x86(pp7);
+}
+
 static int hardthresh_c(PP7Context *p, int16_t *src, int qp)
 {
     int i;
@@ -306,10 +314,7 @@ static int config_input(AVFilterLink *inlink)
         case 2: pp7->requantize = mediumthresh_c; break;
     }
 
-    pp7->dctB = dctB_c;
-
-    if (ARCH_X86)
-        ff_pp7_init_x86(pp7);
+    ff_pp7_init(pp7);
 
     return 0;
 }
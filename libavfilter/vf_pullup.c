@@ -114,6 +114,16 @@ static int var_c(const uint8_t *a, const uint8_t *b, ptrdiff_t s)
     return 4 * var; /* match comb scaling */
 }
 
+void ff_pullup_init(PullupContext *s)
+{
+    s->diff = diff_c;
+    s->comb = comb_c;
+    s->var  = var_c;
+
+    if (ARCH_X86)
+        ff_pullup_init_x86(s);
+}
+
 static int alloc_metrics(PullupContext *s, PullupField *f)
 {
     f->diffs = av_calloc(FFALIGN(s->metric_length, 16), sizeof(*f->diffs));
@@ -211,12 +221,7 @@ static int config_input(AVFilterLink *inlink)
     if (!s->head)
         return AVERROR(ENOMEM);
 
-    s->diff = diff_c;
-    s->comb = comb_c;
-    s->var  = var_c;
-
-    if (ARCH_X86)
-        ff_pullup_init_x86(s);
+    ff_pullup_init(s);
     return 0;
 }
 
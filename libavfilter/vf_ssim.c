@@ -376,6 +376,14 @@ static int query_formats(AVFilterContext *ctx)
     return ff_set_common_formats(ctx, fmts_list);
 }
 
+void ff_ssim_init(SSIMDSPContext *dsp)
+{
+    dsp->ssim_4x4_line = ssim_4x4xn_8bit;
+    dsp->ssim_end_line = ssim_endn_8bit;
+    if (ARCH_X86)
+        ff_ssim_init_x86(dsp);
+}
+
 static int config_input_ref(AVFilterLink *inlink)
 {
     const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(inlink->format);
@@ -416,10 +424,7 @@ static int config_input_ref(AVFilterLink *inlink)
     s->max = (1 << desc->comp[0].depth) - 1;
 
     s->ssim_plane = desc->comp[0].depth > 8 ? ssim_plane_16bit : ssim_plane;
-    s->dsp.ssim_4x4_line = ssim_4x4xn_8bit;
-    s->dsp.ssim_end_line = ssim_endn_8bit;
-    if (ARCH_X86)
-        ff_ssim_init_x86(&s->dsp);
+    ff_ssim_init(&s->dsp);
 
     return 0;
 }
@@ -363,6 +363,13 @@ static void anaglyph(uint8_t *dst, uint8_t *lsrc, uint8_t *rsrc,
     }
 }
 
+void ff_stereo3d_init(Stereo3DDSPContext *dsp)
+{
+    dsp->anaglyph = anaglyph;
+    if (ARCH_X86)
+        ff_stereo3d_init_x86(dsp);
+}
+
 static int config_output(AVFilterLink *outlink)
 {
     AVFilterContext *ctx = outlink->src;
@@ -594,9 +601,7 @@ static int config_output(AVFilterLink *outlink)
     s->hsub = desc->log2_chroma_w;
     s->vsub = desc->log2_chroma_h;
 
-    s->dsp.anaglyph = anaglyph;
-    if (ARCH_X86)
-        ff_stereo3d_init_x86(&s->dsp);
+    ff_stereo3d_init(&s->dsp);
 
     return 0;
 }
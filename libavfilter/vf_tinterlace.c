@@ -203,6 +203,24 @@ static void lowpass_line_complex_c_16(uint8_t *dst8, ptrdiff_t width, const uint
     }
 }
 
+void ff_tinterlace_init(TInterlaceContext *s)
+{
+    if (s->flags & TINTERLACE_FLAG_CVLPF) {
+        if (s->csp->comp[0].depth > 8)
+            s->lowpass_line = lowpass_line_complex_c_16;
+        else
+            s->lowpass_line = lowpass_line_complex_c;
+    } else {
+        if (s->csp->comp[0].depth > 8)
+            s->lowpass_line = lowpass_line_c_16;
+        else
+            s->lowpass_line = lowpass_line_c;
+    }
+
+    if (ARCH_X86)
+        ff_tinterlace_init_x86(s);
+}
+
 static av_cold void uninit(AVFilterContext *ctx)
 {
     TInterlaceContext *tinterlace = ctx->priv;
@@ -272,21 +290,8 @@ static int config_out_props(AVFilterLink *outlink)
         outlink->time_base = tinterlace->preout_time_base;
 
     tinterlace->csp = av_pix_fmt_desc_get(outlink->format);
-    if (tinterlace->flags & TINTERLACE_FLAG_CVLPF) {
-        if (tinterlace->csp->comp[0].depth > 8)
-            tinterlace->lowpass_line = lowpass_line_complex_c_16;
-        else
-            tinterlace->lowpass_line = lowpass_line_complex_c;
-        if (ARCH_X86)
-            ff_tinterlace_init_x86(tinterlace);
-    } else if (tinterlace->flags & TINTERLACE_FLAG_VLPF) {
-        if (tinterlace->csp->comp[0].depth > 8)
-            tinterlace->lowpass_line = lowpass_line_c_16;
-        else
-            tinterlace->lowpass_line = lowpass_line_c;
-        if (ARCH_X86)
-            ff_tinterlace_init_x86(tinterlace);
-    }
+    if (tinterlace->flags & (TINTERLACE_FLAG_VLPF | TINTERLACE_FLAG_CVLPF))
+        ff_tinterlace_init(tinterlace);
 
     av_log(ctx, AV_LOG_VERBOSE, "mode:%d filter:%s h:%d -> h:%d\n", tinterlace->mode,
            (tinterlace->flags & TINTERLACE_FLAG_CVLPF) ? "complex" :
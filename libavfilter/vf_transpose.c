@@ -174,6 +174,27 @@ static void transpose_8x8_64_c(uint8_t *src, ptrdiff_t src_linesize,
     transpose_block_64_c(src, src_linesize, dst, dst_linesize, 8, 8);
 }
 
+void ff_transpose_init(TransVtable *v, int pixstep)
+{
+    switch (pixstep) {
+    case 1: v->transpose_block = transpose_block_8_c;
+            v->transpose_8x8   = transpose_8x8_8_c;  break;
+    case 2: v->transpose_block = transpose_block_16_c;
+            v->transpose_8x8   = transpose_8x8_16_c; break;
+    case 3: v->transpose_block = transpose_block_24_c;
+            v->transpose_8x8   = transpose_8x8_24_c; break;
+    case 4: v->transpose_block = transpose_block_32_c;
+            v->transpose_8x8   = transpose_8x8_32_c; break;
+    case 6: v->transpose_block = transpose_block_48_c;
+            v->transpose_8x8   = transpose_8x8_48_c; break;
+    case 8: v->transpose_block = transpose_block_64_c;
+            v->transpose_8x8   = transpose_8x8_64_c; break;
+    }
+
+    if (ARCH_X86)
+        ff_transpose_init_x86(v, pixstep);
+}
+
 static int config_props_output(AVFilterLink *outlink)
 {
     AVFilterContext *ctx = outlink->src;
@@ -217,31 +238,8 @@ static int config_props_output(AVFilterLink *outlink)
     else
         outlink->sample_aspect_ratio = inlink->sample_aspect_ratio;
 
-    for (int i = 0; i < 4; i++) {
-        TransVtable *v = &s->vtables[i];
-        switch (s->pixsteps[i]) {
-        case 1: v->transpose_block = transpose_block_8_c;
-                v->transpose_8x8   = transpose_8x8_8_c;  break;
-        case 2: v->transpose_block = transpose_block_16_c;
-                v->transpose_8x8   = transpose_8x8_16_c; break;
-        case 3: v->transpose_block = transpose_block_24_c;
-                v->transpose_8x8   = transpose_8x8_24_c; break;
-        case 4: v->transpose_block = transpose_block_32_c;
-                v->transpose_8x8   = transpose_8x8_32_c; break;
-        case 6: v->transpose_block = transpose_block_48_c;
-                v->transpose_8x8   = transpose_8x8_48_c; break;
-        case 8: v->transpose_block = transpose_block_64_c;
-                v->transpose_8x8   = transpose_8x8_64_c; break;
-        }
-    }
-
-    if (ARCH_X86) {
-        for (int i = 0; i < 4; i++) {
-            TransVtable *v = &s->vtables[i];
-
-            ff_transpose_init_x86(v, s->pixsteps[i]);
-        }
-    }
+    for (int i = 0; i < 4; i++)
+        ff_transpose_init(&s->vtables[i], s->pixsteps[i]);
 
     av_log(ctx, AV_LOG_VERBOSE,
            "w:%d h:%d dir:%d -> w:%d h:%d rotation:%s vflip:%d\n",
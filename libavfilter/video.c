@@ -69,6 +69,9 @@ AVFrame *ff_default_get_video_buffer(AVFilterLink *link, int w, int h)
                                                     link->format, BUFFER_ALIGN);
         if (!link->frame_pool)
             return NULL;
+        if (link->graph && link->graph->prewarm_frames > 0 &&
+            ff_frame_pool_prewarm(link->frame_pool, link->graph->prewarm_frames) < 0)
+            return NULL;
     } else {
         if (ff_frame_pool_get_video_config(link->frame_pool,
                                            &pool_width, &pool_height,
@@ -84,6 +87,9 @@ AVFrame *ff_default_get_video_buffer(AVFilterLink *link, int w, int h)
                                                         link->format, BUFFER_ALIGN);
             if (!link->frame_pool)
                 return NULL;
+            if (link->graph && link->graph->prewarm_frames > 0 &&
+                ff_frame_pool_prewarm(link->frame_pool, link->graph->prewarm_frames) < 0)
+                return NULL;
         }
     }
 
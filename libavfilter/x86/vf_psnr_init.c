@@ -32,7 +32,8 @@ void ff_psnr_init_x86(PSNRDSPContext *dsp, int bpp)
     if (EXTERNAL_SSE2(cpu_flags)) {
         if (bpp <= 8) {
             dsp->sse_line = ff_sse_line_8bit_sse2;
-        } else if (bpp <= 15) {
+        } else if (bpp <= 14) {
+            /* sums of four squared differences must fit in 32 bits */
             dsp->sse_line = ff_sse_line_16bit_sse2;
         }
     }
@@ -241,7 +241,7 @@ cglobal ssim_end_line, 3, 3, 7, sum0, sum1, w
     subpd             m6, m5
     jmp .end
 .skip2:
-    psrldq            m5, 8
+    psrldq            m3, 8
     subpd             m6, m5
     subpd             m0, m3
     jmp .end
@@ -63,6 +63,19 @@ SECTION .text
 %endif
 %endmacro
 
+; The SSE2 PMINSD in x86util.asm expects a float source operand.
+%macro PMINSD_INT 3
+%if cpuflag(sse4)
+    pminsd  %1, %2
+%else
+    mova    %3, %2
+    pcmpgtd %3, %1
+    pxor    %1, %2
+    pand    %1, %3
+    pxor    %1, %2
+%endif
+%endmacro
+
 %macro CHECK 2
     movu      m2, [curq+t1+%1*2]
     movu      m3, [curq+t0+%2*2]
@@ -92,7 +105,7 @@ SECTION .text
 %macro CHECK1 0
     mova    m3, m0
     pcmpgtd m3, m2
-    PMINSD  m0, m2, m6
+    PMINSD_INT m0, m2, m6
     mova    m6, m3
     pand    m5, m3
     pandn   m3, m1
@@ -106,7 +119,7 @@ SECTION .text
     paddd   m2, m6
     mova    m3, m0
     pcmpgtd m3, m2
-    PMINSD  m0, m2, m4
+    PMINSD_INT m0, m2, m4
     pand    m5, m3
     pandn   m3, m1
     por     m3, m5
@@ -222,12 +235,12 @@ SECTION .text
     psubd        m5, m4
     psubd        m0, m7
     mova         m4, m2
-    PMINSD       m2, m3, m7
+    PMINSD_INT   m2, m3, m7
     PMAXSD       m3, m4, m7
     PMAXSD       m2, m5, m7
-    PMINSD       m3, m5, m7
+    PMINSD_INT   m3, m5, m7
     PMAXSD       m2, m0, m7
-    PMINSD       m3, m0, m7
+    PMINSD_INT   m3, m0, m7
     pxor         m4, m4
     PMAXSD       m6, m3, m7
     psubd        m4, m2
@@ -239,7 +252,7 @@ SECTION .text
     psubd        m2, m6
     paddd        m3, m6
     PMAXSD       m1, m2, m7
-    PMINSD       m1, m3, m7
+    PMINSD_INT   m1, m3, m7
     PACK         m1
 
     movh     [dstq], m1
@@ -86,6 +86,10 @@ typedef struct YADIFContext {
     int current_field;  ///< YADIFCurrentField
 } YADIFContext;
 
+/**
+ * Set up the line filters for the bit depth of yadif->csp.
+ */
+void ff_yadif_init(YADIFContext *yadif);
 void ff_yadif_init_x86(YADIFContext *yadif);
 
 int ff_yadif_filter_frame(AVFilterLink *link, AVFrame *frame);
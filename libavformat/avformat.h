@@ -1951,6 +1951,17 @@ typedef struct AVFormatContext {
      * - decoding: set by user
      */
     int max_probe_packets;
+
+    /**
+     * Directory in which the detected input format and the stream
+     * parameters found by avformat_find_stream_info() are cached, keyed
+     * on the URL, the size and the first bytes of the input.
+     * Subsequent opens of the same input skip format probing and stream
+     * analysis.
+     * - encoding: unused
+     * - decoding: set by user
+     */
+    char *probe_cache;
 } AVFormatContext;
 
 #if FF_API_FORMAT_GET_SET
@@ -142,6 +142,18 @@ struct AVFormatInternal {
      * Prefer the codec framerate for avg_frame_rate computation.
      */
     int prefer_codec_framerate;
+
+    /**
+     * Probe cache key and entry file of the input, set when
+     * AVFormatContext.probe_cache is used.
+     */
+    char *probe_cache_key;
+    char *probe_cache_file;
+
+    /**
+     * Cached stream parameters, pending avformat_find_stream_info().
+     */
+    AVDictionary *probe_cache;
 };
 
 struct AVStreamInternal {
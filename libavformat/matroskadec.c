@@ -388,6 +388,9 @@ typedef struct MatroskaDemuxContext {
 
     /* Bandwidth value for WebM DASH Manifest */
     int bandwidth;
+
+    /* Parse the CUES while reading the header instead of on the first seek */
+    int preload_cues;
 } MatroskaDemuxContext;
 
 #define CHILD_OF(parent) { .def = { .n = parent } }
@@ -1169,6 +1172,32 @@ static MatroskaLevel1Element *matroska_find_level1_elem(MatroskaDemuxContext *ma
     return elem;
 }
 
+static MatroskaTrack *matroska_find_track_by_num(MatroskaDemuxContext *matroska,
+                                                 uint64_t num);
+
+/*
+ * Peek at the track number of a (Simple)Block in the I/O buffer. Returns 1
+ * if the block belongs to a discarded stream, so that its payload can be
+ * skipped instead of being read into memory.
+ */
+static int matroska_block_discarded(MatroskaDemuxContext *matroska,
+                                    AVIOContext *pb, uint64_t length)
+{
+    MatroskaTrack *track;
+    AVIOContext peek;
+    uint64_t num;
+
+    if (length < 4 || pb->buf_end - pb->buf_ptr < 8)
+        return 0;
+
+    ffio_init_context(&peek, pb->buf_ptr, 8, 0, NULL, NULL, NULL, NULL);
+    if (ebml_read_num(matroska, &peek, 8, &num, 1) < 0)
+        return 0;
+
+    track = matroska_find_track_by_num(matroska, num);
+    return track && track->stream && track->stream->discard >= AVDISCARD_ALL;
+}
+
 static int ebml_parse(MatroskaDemuxContext *matroska,
                       EbmlSyntax *syntax, void *data)
 {
@@ -1397,6 +1426,9 @@ static int ebml_parse(MatroskaDemuxContext *matroska,
         res = ebml_read_ascii(pb, length, data);
         break;
     case EBML_BIN:
+        if ((id == MATROSKA_ID_SIMPLEBLOCK || id == MATROSKA_ID_BLOCK) &&
+            matroska_block_discarded(matroska, pb, length))
+            goto skip;
         res = ebml_read_binary(pb, length, pos_alt, data);
         break;
     case EBML_LEVEL1:
@@ -2974,7 +3006,11 @@ static int matroska_read_header(AVFormatContext *s)
             max_start = chapters[i].start;
         }
 
-    matroska_add_index_entries(matroska);
+    if (matroska->preload_cues && matroska->cues_parsing_deferred > 0) {
+        matroska->cues_parsing_deferred = 0;
+        matroska_parse_cues(matroska);
+    } else
+        matroska_add_index_entries(matroska);
 
     matroska_convert_tags(s);
 
@@ -4241,6 +4277,18 @@ static const AVOption options[] = {
     { NULL },
 };
 
+static const AVOption matroska_options[] = {
+    { "preload_cues", "read the index while opening the file instead of on the first seek", OFFSET(preload_cues), AV_OPT_TYPE_BOOL, {.i64 = 0}, 0, 1, AV_OPT_FLAG_DECODING_PARAM },
+    { NULL },
+};
+
+static const AVClass matroska_class = {
+    .class_name = "Matroska / WebM demuxer",
+    .item_name  = av_default_item_name,
+    .option     = matroska_options,
+    .version    = LIBAVUTIL_VERSION_INT,
+};
+
 static const AVClass webm_dash_class = {
     .class_name = "WebM DASH Manifest demuxer",
     .item_name  = av_default_item_name,
@@ -4258,7 +4306,8 @@ AVInputFormat ff_matroska_demuxer = {
     .read_packet    = matroska_read_packet,
     .read_close     = matroska_read_close,
     .read_seek      = matroska_read_seek,
-    .mime_type      = "audio/webm,audio/x-matroska,video/webm,video/x-matroska"
+    .mime_type      = "audio/webm,audio/x-matroska,video/webm,video/x-matroska",
+    .priv_class     = &matroska_class,
 };
 
 AVInputFormat ff_webm_dash_manifest_demuxer = {
@@ -0,0 +1,495 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * on-disk cache of probe and stream info results
+ *
+ * Every cache entry is a file named after a SHA-256 hash of the input URL,
+ * the input size and its first PROBE_CACHE_HEAD_SIZE bytes. It holds the
+ * name of the detected demuxer and the per-stream parameters found by
+ * avformat_find_stream_info(), serialized as a dictionary.
+ */
+
+#include "config.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_IO_H
+#include <io.h>
+#endif
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "libavutil/avassert.h"
+#include "libavutil/avstring.h"
+#include "libavutil/bprint.h"
+#include "libavutil/dict.h"
+#include "libavutil/hash.h"
+#include "libavutil/internal.h"
+#include "libavutil/mem.h"
+#include "libavutil/random_seed.h"
+
+#include "avformat.h"
+#include "avio_internal.h"
+#include "internal.h"
+#include "probecache.h"
+
+#define PROBE_CACHE_HEAD_SIZE  16384
+#define PROBE_CACHE_MAX_SIZE   (1 << 20)
+#define PROBE_CACHE_EXTRADATA_MAX (1 << 16)
+
+enum ProbeCacheFieldType {
+    FIELD_INT,
+    FIELD_INT64,
+    FIELD_RATIONAL,
+};
+
+typedef struct ProbeCacheField {
+    const char *name;
+    int offset;
+    enum ProbeCacheFieldType type;
+} ProbeCacheField;
+
+#define PAR(x) offsetof(AVCodecParameters, x)
+static const ProbeCacheField par_fields[] = {
+    { "codec_type",            PAR(codec_type),            FIELD_INT      },
+    { "codec_id",              PAR(codec_id),              FIELD_INT      },
+    { "codec_tag",             PAR(codec_tag),             FIELD_INT      },
+    { "format",                PAR(format),                FIELD_INT      },
+    { "bit_rate",              PAR(bit_rate),              FIELD_INT64    },
+    { "bits_per_coded_sample", PAR(bits_per_coded_sample), FIELD_INT      },
+    { "bits_per_raw_sample",   PAR(bits_per_raw_sample),   FIELD_INT      },
+    { "profile",               PAR(profile),               FIELD_INT      },
+    { "level",                 PAR(level),                 FIELD_INT      },
+    { "width",                 PAR(width),                 FIELD_INT      },
+    { "height",                PAR(height),                FIELD_INT      },
+    { "par_sar",               PAR(sample_aspect_ratio),   FIELD_RATIONAL },
+    { "field_order",           PAR(field_order),           FIELD_INT      },
+    { "color_range",           PAR(color_range),           FIELD_INT      },
+    { "color_primaries",       PAR(color_primaries),       FIELD_INT      },
+    { "color_trc",             PAR(color_trc),             FIELD_INT      },
+    { "color_space",           PAR(color_space),           FIELD_INT      },
+    { "chroma_location",       PAR(chroma_location),       FIELD_INT      },
+    { "video_delay",           PAR(video_delay),           FIELD_INT      },
+    { "channel_layout",        PAR(channel_layout),        FIELD_INT64    },
+    { "channels",              PAR(channels),              FIELD_INT      },
+    { "sample_rate",           PAR(sample_rate),           FIELD_INT      },
+    { "block_align",           PAR(block_align),           FIELD_INT      },
+    { "frame_size",            PAR(frame_size),            FIELD_INT      },
+    { "initial_padding",       PAR(initial_padding),       FIELD_INT      },
+    { "trailing_padding",      PAR(trailing_padding),      FIELD_INT      },
+    { "seek_preroll",          PAR(seek_preroll),          FIELD_INT      },
+    { NULL },
+};
+
+#define ST(x) offsetof(AVStream, x)
+static const ProbeCacheField stream_fields[] = {
+    { "start_time",            ST(start_time),             FIELD_INT64    },
+    { "duration",              ST(duration),               FIELD_INT64    },
+    { "sar",                   ST(sample_aspect_ratio),    FIELD_RATIONAL },
+    { "r_frame_rate",          ST(r_frame_rate),           FIELD_RATIONAL },
+    { "avg_frame_rate",        ST(avg_frame_rate),         FIELD_RATIONAL },
+    { NULL },
+};
+
+#define FMT(x) offsetof(AVFormatContext, x)
+static const ProbeCacheField format_fields[] = {
+    { "start_time",            FMT(start_time),            FIELD_INT64    },
+    { "duration",              FMT(duration),              FIELD_INT64    },
+    { "bit_rate",              FMT(bit_rate),              FIELD_INT64    },
+    { "duration_estimation_method",
+                               FMT(duration_estimation_method), FIELD_INT },
+    { NULL },
+};
+
+static void field_key(char *key, int size, int index, const ProbeCacheField *f)
+{
+    if (index < 0)
+        av_strlcpy(key, f->name, size);
+    else
+        snprintf(key, size, "%d.%s", index, f->name);
+}
+
+static int store_fields(AVDictionary **m, int index, const void *obj,
+                        const ProbeCacheField *f)
+{
+    for (; f->name; f++) {
+        const uint8_t *p = (const uint8_t *)obj + f->offset;
+        char key[64], val[64];
+        int ret;
+
+        field_key(key, sizeof(key), index, f);
+        switch (f->type) {
+        case FIELD_INT:
+            snprintf(val, sizeof(val), "%d", *(const int *)p);
+            break;
+        case FIELD_INT64:
+            snprintf(val, sizeof(val), "%"PRIu64, *(const uint64_t *)p);
+            break;
+        case FIELD_RATIONAL:
+            snprintf(val, sizeof(val), "%d/%d",
+                     ((const AVRational *)p)->num, ((const AVRational *)p)->den);
+            break;
+        }
+        if ((ret = av_dict_set(m, key, val, 0)) < 0)
+            return ret;
+    }
+    return 0;
+}
+
+/* Parse the fields of obj from m. If obj is NULL, only check that they are
+ * all present and valid. */
+static int load_fields(AVDictionary *m, int index, void *obj,
+                       const ProbeCacheField *f)
+{
+    for (; f->name; f++) {
+        uint8_t *p = obj ? (uint8_t *)obj + f->offset : NULL;
+        AVDictionaryEntry *e;
+        AVRational q;
+        int64_t i64;
+        uint64_t u64;
+        char key[64], *end;
+
+        field_key(key, sizeof(key), index, f);
+        if (!(e = av_dict_get(m, key, NULL, AV_DICT_MATCH_CASE)))
+            return AVERROR_INVALIDDATA;
+        switch (f->type) {
+        case FIELD_INT:
+            i64 = strtoll(e->value, &end, 10);
+            if (end == e->value || *end || i64 < INT_MIN || i64 > INT_MAX)
+                return AVERROR_INVALIDDATA;
+            if (p)
+                *(int *)p = i64;
+            break;
+        case FIELD_INT64:
+            u64 = strtoull(e->value, &end, 10);
+            if (end == e->value || *end)
+                return AVERROR_INVALIDDATA;
+            if (p)
+                *(uint64_t *)p = u64;
+            break;
+        case FIELD_RATIONAL:
+            if (sscanf(e->value, "%d/%d", &q.num, &q.den) != 2)
+                return AVERROR_INVALIDDATA;
+            if (p)
+                *(AVRational *)p = q;
+            break;
+        }
+    }
+    return 0;
+}
+
+static int64_t get_int(AVDictionary *m, const char *key)
+{
+    AVDictionaryEntry *e = av_dict_get(m, key, NULL, AV_DICT_MATCH_CASE);
+    return e ? strtoll(e->value, NULL, 10) : -1;
+}
+
+static int compute_key(AVFormatContext *s)
+{
+    AVFormatInternal *internal = s->internal;
+    struct AVHashContext *hash = NULL;
+    uint8_t hex[2 * AV_HASH_MAX_SIZE + 1];
+    int64_t size = avio_size(s->pb);
+    int64_t pos  = avio_tell(s->pb);
+    uint8_t *buf;
+    int ret, len;
+
+    /* live and unsized inputs are never cached */
+    if (size < 0 || pos < 0)
+        return 0;
+
+    if (!(buf = av_malloc(PROBE_CACHE_HEAD_SIZE)))
+        return AVERROR(ENOMEM);
+
+    if ((ret = ffio_ensure_seekback(s->pb, PROBE_CACHE_HEAD_SIZE)) < 0)
+        goto end;
+    len = avio_read(s->pb, buf, PROBE_CACHE_HEAD_SIZE);
+    if (avio_seek(s->pb, pos, SEEK_SET) < 0) {
+        ret = AVERROR(EIO);
+        goto end;
+    }
+    if (len < 0)
+        len = 0;
+
+    internal->probe_cache_key = av_asprintf("%s|%"PRId64, s->url, size);
+    if (!internal->probe_cache_key) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+
+    if ((ret = av_hash_alloc(&hash, "SHA256")) < 0)
+        goto end;
+    av_hash_init(hash);
+    av_hash_update(hash, internal->probe_cache_key,
+                   strlen(internal->probe_cache_key) + 1);
+    av_hash_update(hash, buf, len);
+    av_hash_final_hex(hash, hex, sizeof(hex));
+
+    internal->probe_cache_file = av_asprintf("%s/%s.probe", s->probe_cache, hex);
+    if (!internal->probe_cache_file) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+    ret = 1;
+
+end:
+    av_hash_freep(&hash);
+    av_free(buf);
+    return ret;
+}
+
+int ff_probe_cache_lookup(AVFormatContext *s)
+{
+    AVFormatInternal *internal = s->internal;
+    AVDictionary *m = NULL;
+    AVDictionaryEntry *e;
+    AVIOContext *pb = NULL;
+    ff_const59 AVInputFormat *fmt;
+    AVBPrint bp;
+    int ret, score;
+
+    if (!s->pb || internal->probe_cache_file)
+        return 0;
+
+    ret = compute_key(s);
+    if (ret <= 0) {
+        if (ret != AVERROR(ENOMEM)) {
+            av_log(s, AV_LOG_DEBUG, "Input cannot be probe cached\n");
+            ret = 0;
+        }
+        return ret;
+    }
+
+    if (avio_open2(&pb, internal->probe_cache_file, AVIO_FLAG_READ,
+                   &s->interrupt_callback, NULL) < 0)
+        return 0;
+
+    av_bprint_init(&bp, 0, AV_BPRINT_SIZE_UNLIMITED);
+    ret = avio_read_to_bprint(pb, &bp, PROBE_CACHE_MAX_SIZE);
+    avio_closep(&pb);
+    if (ret >= 0 && !av_bprint_is_complete(&bp))
+        ret = AVERROR(ENOMEM);
+    if (ret >= 0)
+        ret = av_dict_parse_string(&m, bp.str, "=", "\n", 0);
+    av_bprint_finalize(&bp, NULL);
+    if (ret == AVERROR(ENOMEM)) {
+        av_dict_free(&m);
+        return ret;
+    }
+    if (ret < 0)
+        goto miss;
+
+    e = av_dict_get(m, "key", NULL, AV_DICT_MATCH_CASE);
+    if (!e || strcmp(e->value, internal->probe_cache_key))
+        goto miss;
+    e = av_dict_get(m, "iformat", NULL, AV_DICT_MATCH_CASE);
+    if (!e || !(fmt = av_find_input_format(e->value)))
+        goto miss;
+    if (s->iformat && s->iformat != fmt)
+        goto miss;
+
+    score = get_int(m, "probe_score");
+    av_log(s, AV_LOG_VERBOSE, "Probe cache hit for '%s' in %s\n",
+           s->url, internal->probe_cache_file);
+
+    internal->probe_cache = m;
+    if (s->iformat)
+        return 0;
+    s->iformat = fmt;
+    return av_clip(score, 1, AVPROBE_SCORE_MAX);
+
+miss:
+    av_log(s, AV_LOG_DEBUG, "Ignoring stale probe cache entry %s\n",
+           internal->probe_cache_file);
+    av_dict_free(&m);
+    return 0;
+}
+
+int ff_probe_cache_apply(AVFormatContext *s)
+{
+    AVDictionary *m = s->internal->probe_cache;
+    char key[64];
+    int i, ret;
+
+    if (!m)
+        return 0;
+
+    if (get_int(m, "nb_streams") != s->nb_streams)
+        goto mismatch;
+
+    for (i = 0; i < s->nb_streams; i++) {
+        AVCodecParameters *par = s->streams[i]->codecpar;
+
+        snprintf(key, sizeof(key), "%d.codec_type", i);
+        if (get_int(m, key) != par->codec_type)
+            goto mismatch;
+        snprintf(key, sizeof(key), "%d.codec_id", i);
+        if (get_int(m, key) != par->codec_id)
+            goto mismatch;
+    }
+
+    /* check the whole entry before touching any stream */
+    for (i = 0; i < s->nb_streams; i++) {
+        if (load_fields(m, i, NULL, par_fields) < 0 ||
+            load_fields(m, i, NULL, stream_fields) < 0)
+            goto invalid;
+    }
+    if (load_fields(m, -1, NULL, format_fields) < 0)
+        goto invalid;
+
+    for (i = 0; i < s->nb_streams; i++) {
+        AVStream *st = s->streams[i];
+        AVCodecParameters *par = st->codecpar;
+        AVDictionaryEntry *e;
+
+        if ((ret = load_fields(m, i, par, par_fields)) < 0 ||
+            (ret = load_fields(m, i, st, stream_fields)) < 0)
+            return ret;
+
+        snprintf(key, sizeof(key), "%d.extradata", i);
+        e = av_dict_get(m, key, NULL, AV_DICT_MATCH_CASE);
+        if (e && !par->extradata) {
+            int size = strlen(e->value) / 2;
+            if ((ret = ff_alloc_extradata(par, size)) < 0)
+                return ret;
+            ff_hex_to_data(par->extradata, e->value);
+        }
+        st->internal->need_context_update = 1;
+    }
+
+    if ((ret = load_fields(m, -1, s, format_fields)) < 0)
+        return ret;
+
+    av_dict_free(&s->internal->probe_cache);
+    return 1;
+
+mismatch:
+    av_log(s, AV_LOG_VERBOSE, "Stream layout differs from the probe cache, "
+           "analyzing streams\n");
+    av_dict_free(&s->internal->probe_cache);
+    return 0;
+
+invalid:
+    av_log(s, AV_LOG_WARNING, "Ignoring invalid probe cache entry %s\n",
+           s->internal->probe_cache_file);
+    av_dict_free(&s->internal->probe_cache);
+    return 0;
+}
+
+/* Create a temporary file next to the cache entry, under a name no other
+ * process or thread uses, and open it for writing. */
+static int open_temp_file(AVFormatContext *s, AVIOContext **pb, char **tmp)
+{
+    int i, fd, ret;
+
+    for (i = 0; i < 16; i++) {
+        *tmp = av_asprintf("%s.%08"PRIx32".tmp", s->internal->probe_cache_file,
+                           av_get_random_seed());
+        if (!*tmp)
+            return AVERROR(ENOMEM);
+
+        fd = avpriv_open(*tmp, O_WRONLY | O_CREAT | O_EXCL, 0666);
+        if (fd >= 0) {
+            close(fd);
+            ret = avio_open2(pb, *tmp, AVIO_FLAG_WRITE,
+                             &s->interrupt_callback, NULL);
+            if (ret < 0)
+                avpriv_io_delete(*tmp);
+            return ret;
+        }
+        ret = AVERROR(errno);
+        av_freep(tmp);
+        if (ret != AVERROR(EEXIST))
+            return ret;
+    }
+    return AVERROR(EEXIST);
+}
+
+int ff_probe_cache_store(AVFormatContext *s)
+{
+    AVFormatInternal *internal = s->internal;
+    AVDictionary *m = NULL;
+    AVIOContext *pb = NULL;
+    char *tmp = NULL, *buf = NULL, *hex = NULL;
+    int i, ret;
+
+    if (!internal->probe_cache_file || !s->iformat)
+        return 0;
+
+    if ((ret = av_dict_set(&m, "key", internal->probe_cache_key, 0)) < 0 ||
+        (ret = av_dict_set(&m, "iformat", s->iformat->name, 0)) < 0 ||
+        (ret = av_dict_set_int(&m, "probe_score", s->probe_score, 0)) < 0 ||
+        (ret = av_dict_set_int(&m, "nb_streams", s->nb_streams, 0)) < 0 ||
+        (ret = store_fields(&m, -1, s, format_fields)) < 0)
+        goto end;
+
+    for (i = 0; i < s->nb_streams; i++) {
+        AVStream *st = s->streams[i];
+        AVCodecParameters *par = st->codecpar;
+
+        if ((ret = store_fields(&m, i, par, par_fields)) < 0 ||
+            (ret = store_fields(&m, i, st, stream_fields)) < 0)
+            goto end;
+
+        if (par->extradata_size > 0 &&
+            par->extradata_size <= PROBE_CACHE_EXTRADATA_MAX) {
+            char key[64];
+
+            if (!(hex = av_malloc(2 * par->extradata_size + 1))) {
+                ret = AVERROR(ENOMEM);
+                goto end;
+            }
+            ff_data_to_hex(hex, par->extradata, par->extradata_size, 1);
+            hex[2 * par->extradata_size] = '\0';
+            snprintf(key, sizeof(key), "%d.extradata", i);
+            ret = av_dict_set(&m, key, hex, AV_DICT_DONT_STRDUP_VAL);
+            hex = NULL;
+            if (ret < 0)
+                goto end;
+        }
+    }
+
+    if ((ret = av_dict_get_string(m, &buf, '=', '\n')) < 0)
+        goto end;
+
+    ret = open_temp_file(s, &pb, &tmp);
+    if (ret < 0) {
+        av_log(s, AV_LOG_WARNING, "Failed to create a temporary probe cache "
+               "file for %s: %s\n", internal->probe_cache_file, av_err2str(ret));
+        goto end;
+    }
+    avio_write(pb, buf, strlen(buf));
+    avio_w8(pb, '\n');
+    ret = avio_closep(&pb);
+    if (ret >= 0)
+        ret = ff_rename(tmp, internal->probe_cache_file, s);
+    if (ret < 0)
+        avpriv_io_delete(tmp);
+
+end:
+    av_free(hex);
+    av_free(tmp);
+    av_free(buf);
+    av_dict_free(&m);
+    return ret;
+}
@@ -0,0 +1,54 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVFORMAT_PROBECACHE_H
+#define AVFORMAT_PROBECACHE_H
+
+#include "avformat.h"
+
+/**
+ * Compute the cache key of the input opened in s->pb and look it up in
+ * the directory given by AVFormatContext.probe_cache.
+ *
+ * On a hit, s->iformat is set to the cached demuxer and the cached
+ * stream parameters are kept for ff_probe_cache_apply().
+ * The read position of s->pb is left unchanged.
+ *
+ * @return the cached probe score on a hit, 0 on a miss or if the input
+ *         cannot be keyed, a negative AVERROR code on allocation failure
+ */
+int ff_probe_cache_lookup(AVFormatContext *s);
+
+/**
+ * Restore the stream parameters found by ff_probe_cache_lookup().
+ *
+ * Nothing is changed unless the streams created by the demuxer match the
+ * cached ones in number, type and codec id.
+ *
+ * @return 1 if all streams were restored, 0 if the cache entry does not
+ *         apply, a negative AVERROR code on failure
+ */
+int ff_probe_cache_apply(AVFormatContext *s);
+
+/**
+ * Write the demuxer choice and the stream parameters found by
+ * avformat_find_stream_info() to the cache.
+ */
+int ff_probe_cache_store(AVFormatContext *s);
+
+#endif /* AVFORMAT_PROBECACHE_H */
@@ -20,13 +20,19 @@
  */
 
 
+#include <stdatomic.h>
+
+#include "config.h"
 #include "libavutil/avutil.h"
 #include "libavutil/avstring.h"
 #include "libavutil/opt.h"
+#include "libavutil/thread.h"
+#include "libavutil/threadmessage.h"
 #include "internal.h"
 #include "avformat.h"
 #include "avio_internal.h"
 #include "tee_common.h"
+#include "url.h"
 
 typedef enum {
     ON_SLAVE_FAILURE_ABORT  = 1,
@@ -34,10 +40,32 @@ typedef enum {
 } SlaveFailurePolicy;
 
 #define DEFAULT_SLAVE_FAILURE_POLICY ON_SLAVE_FAILURE_ABORT
+#define DEFAULT_SLAVE_QUEUE_SIZE 60
+
+typedef enum TeeMessageType {
+    TEE_WRITE_PACKET,
+    TEE_FLUSH_OUTPUT
+} TeeMessageType;
+
+typedef struct TeeMessage {
+    TeeMessageType type;
+    AVPacket pkt;
+} TeeMessage;
+
+/**
+ * Bitstream filter chain applied to one input stream. Slave streams using
+ * the same filters on the same input stream share a single chain, whose
+ * output packets are passed to all of them by reference.
+ */
+typedef struct TeeBSFChain {
+    AVBSFContext *bsf;  ///< NULL for pass-through
+    char *spec;         ///< filter list the chain was created from
+    int stream_index;   ///< input stream index
+} TeeBSFChain;
 
 typedef struct {
     AVFormatContext *avf;
-    AVBSFContext **bsfs; ///< bitstream filters per stream
+    int *bsf_chains;    ///< index of the bitstream filter chain per stream
 
     SlaveFailurePolicy on_fail;
     int use_fifo;
@@ -47,6 +75,18 @@ typedef struct {
      * disabled output streams are set to -1 */
     int *stream_map;
     int header_written;
+
+    /** interrupt callback of the tee muxer, checked by the slave's own one */
+    AVIOInterruptCB parent_interrupt_cb;
+    /** set to make all blocking I/O of the slave fail with AVERROR_EXIT */
+    atomic_int abort_request;
+
+#if HAVE_THREADS
+    /** packet queue feeding the writer thread, NULL if not threaded */
+    AVThreadMessageQueue *queue;
+    pthread_t writer_thread;
+    int thread_ret;
+#endif
 } TeeSlave;
 
 typedef struct TeeContext {
@@ -54,8 +94,12 @@ typedef struct TeeContext {
     unsigned nb_slaves;
     unsigned nb_alive;
     TeeSlave *slaves;
+    TeeBSFChain *bsf_chains;
+    int nb_bsf_chains;
     int use_fifo;
     AVDictionary *fifo_options;
+    int use_threads;
+    int queue_size;
 } TeeContext;
 
 static const char *const slave_delim     = "|";
@@ -68,6 +112,10 @@ static const AVOption options[] = {
          OFFSET(use_fifo), AV_OPT_TYPE_BOOL, {.i64 = 0}, 0, 1, AV_OPT_FLAG_ENCODING_PARAM},
         {"fifo_options", "fifo pseudo-muxer options", OFFSET(fifo_options),
          AV_OPT_TYPE_DICT, {.str = NULL}, 0, 0, AV_OPT_FLAG_ENCODING_PARAM},
+        {"use_threads", "Write each slave output from its own thread",
+         OFFSET(use_threads), AV_OPT_TYPE_BOOL, {.i64 = 0}, 0, 1, AV_OPT_FLAG_ENCODING_PARAM},
+        {"queue_size", "Size of the packet queue of each slave writer thread",
+         OFFSET(queue_size), AV_OPT_TYPE_INT, {.i64 = DEFAULT_SLAVE_QUEUE_SIZE}, 1, INT_MAX, AV_OPT_FLAG_ENCODING_PARAM},
         {NULL}
 };
 
@@ -118,25 +166,254 @@ static int parse_slave_fifo_options(const char *use_fifo,
     return ret;
 }
 
-static int close_slave(TeeSlave *tee_slave)
+#if HAVE_THREADS
+static void free_message(void *msg)
+{
+    TeeMessage *tee_msg = msg;
+
+    if (tee_msg->type == TEE_WRITE_PACKET)
+        av_packet_unref(&tee_msg->pkt);
+}
+
+static void *tee_writer_thread(void *arg)
+{
+    TeeSlave *tee_slave = arg;
+    TeeMessage msg;
+    int ret;
+
+    while (1) {
+        ret = av_thread_message_queue_recv(tee_slave->queue, &msg, 0);
+        if (ret < 0)
+            break;
+
+        ret = av_interleaved_write_frame(tee_slave->avf,
+                                         msg.type == TEE_FLUSH_OUTPUT ? NULL : &msg.pkt);
+        if (ret < 0)
+            break;
+    }
+
+    /* Make the next send of the main thread fail with our error. */
+    tee_slave->thread_ret = ret == AVERROR_EOF ? 0 : ret;
+    av_thread_message_queue_set_err_send(tee_slave->queue,
+                                         ret < 0 ? ret : AVERROR_EOF);
+    return NULL;
+}
+#endif
+
+static int start_slave_thread(AVFormatContext *avf, TeeSlave *tee_slave)
+{
+#if HAVE_THREADS
+    TeeContext *tee = avf->priv_data;
+    int ret;
+
+    ret = av_thread_message_queue_alloc(&tee_slave->queue, tee->queue_size,
+                                        sizeof(TeeMessage));
+    if (ret < 0)
+        return ret;
+    av_thread_message_queue_set_free_func(tee_slave->queue, free_message);
+
+    ret = pthread_create(&tee_slave->writer_thread, NULL, tee_writer_thread, tee_slave);
+    if (ret) {
+        av_log(avf, AV_LOG_ERROR, "Failed to start writer thread: %s\n",
+               av_err2str(AVERROR(ret)));
+        av_thread_message_queue_free(&tee_slave->queue);
+        return AVERROR(ret);
+    }
+    return 0;
+#else
+    av_log(avf, AV_LOG_ERROR, "use_threads requires threading support\n");
+    return AVERROR(ENOSYS);
+#endif
+}
+
+static int slave_interrupt_cb(void *opaque)
+{
+    TeeSlave *tee_slave = opaque;
+
+    return atomic_load(&tee_slave->abort_request) ||
+           ff_check_interrupt(&tee_slave->parent_interrupt_cb);
+}
+
+/* Wait for the writer thread to write all the queued packets and return
+ * its error code. If abort is set, interrupt the packet being written
+ * instead of waiting for it. */
+static int stop_slave_thread(TeeSlave *tee_slave, int abort)
+{
+#if HAVE_THREADS
+    if (!tee_slave->queue)
+        return 0;
+
+    if (abort)
+        atomic_store(&tee_slave->abort_request, 1);
+    av_thread_message_queue_set_err_recv(tee_slave->queue, AVERROR_EOF);
+    pthread_join(tee_slave->writer_thread, NULL);
+    av_thread_message_queue_free(&tee_slave->queue);
+    return tee_slave->thread_ret;
+#else
+    return 0;
+#endif
+}
+
+/* Queue a packet or a flush request (pkt == NULL) for the writer thread.
+ * The packet reference is consumed. */
+static int send_slave_message(AVFormatContext *avf, unsigned slave_idx, AVPacket *pkt)
+{
+#if HAVE_THREADS
+    TeeContext *tee = avf->priv_data;
+    TeeMessage msg = { .type = pkt ? TEE_WRITE_PACKET : TEE_FLUSH_OUTPUT };
+    int ret;
+
+    if (pkt)
+        av_packet_move_ref(&msg.pkt, pkt);
+
+    ret = av_thread_message_queue_send(tee->slaves[slave_idx].queue, &msg,
+                                       AV_THREAD_MESSAGE_NONBLOCK);
+    if (ret == AVERROR(EAGAIN)) {
+        av_log(avf, AV_LOG_ERROR, "Slave muxer #%u cannot keep up, queue full.\n",
+               slave_idx);
+        ret = AVERROR(ENOBUFS);
+    }
+    if (ret < 0)
+        free_message(&msg);
+    return ret;
+#else
+    return AVERROR(ENOSYS);
+#endif
+}
+
+static int slave_is_threaded(TeeSlave *tee_slave)
+{
+#if HAVE_THREADS
+    return !!tee_slave->queue;
+#else
+    return 0;
+#endif
+}
+
+/* Write a packet, or flush if pkt is NULL, to a slave directly or through
+ * its writer thread. The packet reference is consumed. */
+static int write_slave_packet(AVFormatContext *avf, unsigned slave_idx, AVPacket *pkt)
+{
+    TeeContext *tee = avf->priv_data;
+
+    if (slave_is_threaded(&tee->slaves[slave_idx]))
+        return send_slave_message(avf, slave_idx, pkt);
+    return av_interleaved_write_frame(tee->slaves[slave_idx].avf, pkt);
+}
+
+/* Find the bitstream filter chain applying spec (NULL for pass-through) to
+ * input stream stream_index, creating it if no other slave uses it yet.
+ * Returns the index of the chain or a negative error code. */
+static int get_bsf_chain(AVFormatContext *avf, int stream_index, const char *spec)
+{
+    TeeContext *tee = avf->priv_data;
+    AVStream *st = avf->streams[stream_index];
+    TeeBSFChain *chain;
+    AVBSFContext *bsf = NULL;
+    char *spec_dup = NULL;
+    int i, ret;
+
+    for (i = 0; i < tee->nb_bsf_chains; i++) {
+        chain = &tee->bsf_chains[i];
+        if (chain->stream_index == stream_index &&
+            (spec ? chain->spec && !strcmp(chain->spec, spec) : !chain->spec))
+            return i;
+    }
+
+    if (spec) {
+        ret = av_bsf_list_parse_str(spec, &bsf);
+        if (ret < 0) {
+            av_log(avf, AV_LOG_ERROR,
+                   "Error parsing bitstream filter sequence '%s' associated to "
+                   "stream %d\n", spec, stream_index);
+            return ret;
+        }
+
+        bsf->time_base_in = st->time_base;
+        ret = avcodec_parameters_copy(bsf->par_in, st->codecpar);
+        if (ret < 0)
+            goto fail;
+
+        ret = av_bsf_init(bsf);
+        if (ret < 0) {
+            av_log(avf, AV_LOG_ERROR,
+            "Failed to initialize bitstream filter(s): %s\n",
+            av_err2str(ret));
+            goto fail;
+        }
+
+        if (!(spec_dup = av_strdup(spec))) {
+            ret = AVERROR(ENOMEM);
+            goto fail;
+        }
+    }
+
+    chain = av_dynarray2_add((void **)&tee->bsf_chains, &tee->nb_bsf_chains,
+                             sizeof(*tee->bsf_chains), NULL);
+    if (!chain) {
+        ret = AVERROR(ENOMEM);
+        goto fail;
+    }
+    chain->bsf          = bsf;
+    chain->spec         = spec_dup;
+    chain->stream_index = stream_index;
+    return tee->nb_bsf_chains - 1;
+
+fail:
+    av_bsf_free(&bsf);
+    av_free(spec_dup);
+    return ret;
+}
+
+static void free_bsf_chains(TeeContext *tee)
+{
+    int i;
+
+    for (i = 0; i < tee->nb_bsf_chains; i++) {
+        av_bsf_free(&tee->bsf_chains[i].bsf);
+        av_freep(&tee->bsf_chains[i].spec);
+    }
+    av_freep(&tee->bsf_chains);
+    tee->nb_bsf_chains = 0;
+}
+
+static int slave_uses_bsf_chain(TeeContext *tee, unsigned slave_idx, int chain_idx)
+{
+    TeeSlave *tee_slave = &tee->slaves[slave_idx];
+    int s2;
+
+    if (!tee_slave->avf)
+        return 0;
+    s2 = tee_slave->stream_map[tee->bsf_chains[chain_idx].stream_index];
+    return s2 >= 0 && tee_slave->bsf_chains[s2] == chain_idx;
+}
+
+/* Close a slave output. If abort is set, a pending write is interrupted.
+ * No trailer is written to an aborted output or one with an I/O error. */
+static int close_slave(TeeSlave *tee_slave, int abort)
 {
     AVFormatContext *avf;
-    unsigned i;
-    int ret = 0;
+    int ret = 0, ret2;
 
     avf = tee_slave->avf;
     if (!avf)
         return 0;
 
-    if (tee_slave->header_written)
-        ret = av_write_trailer(avf);
+    ret = stop_slave_thread(tee_slave, abort);
+    if (avf->pb && avf->pb->error < 0) {
+        if (!ret)
+            ret = avf->pb->error;
+        abort = 1;
+    }
 
-    if (tee_slave->bsfs) {
-        for (i = 0; i < avf->nb_streams; ++i)
-            av_bsf_free(&tee_slave->bsfs[i]);
+    if (tee_slave->header_written && !abort) {
+        ret2 = av_write_trailer(avf);
+        if (!ret)
+            ret = ret2;
     }
+
     av_freep(&tee_slave->stream_map);
-    av_freep(&tee_slave->bsfs);
+    av_freep(&tee_slave->bsf_chains);
 
     ff_format_io_close(avf, &avf->pb);
     avformat_free_context(avf);
@@ -150,9 +427,10 @@ static void close_slaves(AVFormatContext *avf)
     unsigned i;
 
     for (i = 0; i < tee->nb_slaves; i++) {
-        close_slave(&tee->slaves[i]);
+        close_slave(&tee->slaves[i], 0);
     }
     av_freep(&tee->slaves);
+    free_bsf_chains(tee);
 }
 
 static int open_slave(AVFormatContext *avf, char *slave, TeeSlave *tee_slave)
@@ -168,6 +446,7 @@ static int open_slave(AVFormatContext *avf, char *slave, TeeSlave *tee_slave)
     int stream_count;
     int fullret;
     char *subselect = NULL, *next_subselect = NULL, *first_subselect = NULL, *tmp_select = NULL;
+    char **bsf_specs = NULL;
 
     if ((ret = ff_tee_parse_slave_options(avf, slave, &options, &filename)) < 0)
         return ret;
@@ -239,7 +518,10 @@ static int open_slave(AVFormatContext *avf, char *slave, TeeSlave *tee_slave)
     avf2->opaque   = avf->opaque;
     avf2->io_open  = avf->io_open;
     avf2->io_close = avf->io_close;
-    avf2->interrupt_callback = avf->interrupt_callback;
+    tee_slave->parent_interrupt_cb = avf->interrupt_callback;
+    atomic_init(&tee_slave->abort_request, 0);
+    avf2->interrupt_callback.callback = slave_interrupt_cb;
+    avf2->interrupt_callback.opaque   = tee_slave;
     avf2->flags = avf->flags;
     avf2->strict_std_compliance = avf->strict_std_compliance;
 
@@ -309,8 +591,9 @@ static int open_slave(AVFormatContext *avf, char *slave, TeeSlave *tee_slave)
     }
     tee_slave->header_written = 1;
 
-    tee_slave->bsfs = av_calloc(avf2->nb_streams, sizeof(*tee_slave->bsfs));
-    if (!tee_slave->bsfs) {
+    bsf_specs = av_calloc(avf2->nb_streams, sizeof(*bsf_specs));
+    tee_slave->bsf_chains = av_calloc(avf2->nb_streams, sizeof(*tee_slave->bsf_chains));
+    if (!bsf_specs || !tee_slave->bsf_chains) {
         ret = AVERROR(ENOMEM);
         goto end;
     }
@@ -341,17 +624,14 @@ static int open_slave(AVFormatContext *avf, char *slave, TeeSlave *tee_slave)
             if (ret > 0) {
                 av_log(avf, AV_LOG_DEBUG, "spec:%s bsfs:%s matches stream %d of slave "
                        "output '%s'\n", spec, entry->value, i, filename);
-                if (tee_slave->bsfs[i]) {
+                if (bsf_specs[i]) {
                     av_log(avf, AV_LOG_WARNING,
                            "Duplicate bsfs specification associated to stream %d of slave "
                            "output '%s', filters will be ignored\n", i, filename);
                     continue;
                 }
-                ret = av_bsf_list_parse_str(entry->value, &tee_slave->bsfs[i]);
-                if (ret < 0) {
-                    av_log(avf, AV_LOG_ERROR,
-                           "Error parsing bitstream filter sequence '%s' associated to "
-                           "stream %d of slave output '%s'\n", entry->value, i, filename);
+                if (!(bsf_specs[i] = av_strdup(entry->value))) {
+                    ret = AVERROR(ENOMEM);
                     goto end;
                 }
             }
@@ -365,31 +645,15 @@ static int open_slave(AVFormatContext *avf, char *slave, TeeSlave *tee_slave)
         if (target_stream < 0)
             continue;
 
-        if (!tee_slave->bsfs[target_stream]) {
-            /* Add pass-through bitstream filter */
-            ret = av_bsf_get_null_filter(&tee_slave->bsfs[target_stream]);
-            if (ret < 0) {
-                av_log(avf, AV_LOG_ERROR,
-                       "Failed to create pass-through bitstream filter: %s\n",
-                       av_err2str(ret));
-                goto end;
-            }
-        }
-
-        tee_slave->bsfs[target_stream]->time_base_in = avf->streams[i]->time_base;
-        ret = avcodec_parameters_copy(tee_slave->bsfs[target_stream]->par_in,
-                                      avf->streams[i]->codecpar);
-        if (ret < 0)
-            goto end;
-
-        ret = av_bsf_init(tee_slave->bsfs[target_stream]);
+        ret = get_bsf_chain(avf, i, bsf_specs[target_stream]);
         if (ret < 0) {
-            av_log(avf, AV_LOG_ERROR,
-            "Failed to initialize bitstream filter(s): %s\n",
-            av_err2str(ret));
+            av_log(avf, AV_LOG_ERROR, "Slave '%s': failed to set up bitstream "
+                   "filters of stream %d\n", slave, target_stream);
             goto end;
         }
+        tee_slave->bsf_chains[target_stream] = ret;
     }
+    ret = 0;
 
     if (options) {
         entry = NULL;
@@ -406,25 +670,31 @@ end:
     av_dict_free(&options);
     av_dict_free(&bsf_options);
     av_freep(&tmp_select);
+    if (bsf_specs && avf2) {
+        for (i = 0; i < avf2->nb_streams; i++)
+            av_free(bsf_specs[i]);
+    }
+    av_free(bsf_specs);
     return ret;
 }
 
-static void log_slave(TeeSlave *slave, void *log_ctx, int log_level)
+static void log_slave(TeeContext *tee, TeeSlave *slave, void *log_ctx, int log_level)
 {
     int i;
     av_log(log_ctx, log_level, "filename:'%s' format:%s\n",
            slave->avf->url, slave->avf->oformat->name);
     for (i = 0; i < slave->avf->nb_streams; i++) {
         AVStream *st = slave->avf->streams[i];
-        AVBSFContext *bsf = slave->bsfs[i];
-        const char *bsf_name;
+        AVBSFContext *bsf = tee->bsf_chains[slave->bsf_chains[i]].bsf;
+        const char *bsf_name = "null";
 
         av_log(log_ctx, log_level, "    stream:%d codec:%s type:%s",
                i, avcodec_get_name(st->codecpar->codec_id),
                av_get_media_type_string(st->codecpar->codec_type));
 
-        bsf_name = bsf->filter->priv_class ?
-                   bsf->filter->priv_class->item_name(bsf) : bsf->filter->name;
+        if (bsf)
+            bsf_name = bsf->filter->priv_class ?
+                       bsf->filter->priv_class->item_name(bsf) : bsf->filter->name;
         av_log(log_ctx, log_level, " bsfs: %s\n", bsf_name);
     }
 }
@@ -436,7 +706,13 @@ static int tee_process_slave_failure(AVFormatContext *avf, unsigned slave_idx, i
 
     tee->nb_alive--;
 
-    close_slave(tee_slave);
+#if HAVE_THREADS
+    /* Do not wait for a failed output to write its backlog. */
+    if (tee_slave->queue)
+        av_thread_message_flush(tee_slave->queue);
+#endif
+    /* An output which cannot keep up must not block on its pending write. */
+    close_slave(tee_slave, err_n == AVERROR(ENOBUFS));
 
     if (!tee->nb_alive) {
         av_log(avf, AV_LOG_ERROR, "All tee outputs failed.\n");
@@ -487,12 +763,13 @@ static int tee_write_header(AVFormatContext *avf)
         if (ret < 0)
             goto fail;
 
-        if ((ret = open_slave(avf, slaves[i], &tee->slaves[i])) < 0) {
+        if ((ret = open_slave(avf, slaves[i], &tee->slaves[i])) < 0 ||
+            (tee->use_threads && (ret = start_slave_thread(avf, &tee->slaves[i])) < 0)) {
             ret = tee_process_slave_failure(avf, i, ret);
             if (ret < 0)
                 goto fail;
         } else {
-            log_slave(&tee->slaves[i], avf, AV_LOG_VERBOSE);
+            log_slave(tee, &tee->slaves[i], avf, AV_LOG_VERBOSE);
         }
         av_freep(&slaves[i]);
     }
@@ -524,81 +801,136 @@ static int tee_write_trailer(AVFormatContext *avf)
     unsigned i;
 
     for (i = 0; i < tee->nb_slaves; i++) {
-        if ((ret = close_slave(&tee->slaves[i])) < 0) {
+        if ((ret = close_slave(&tee->slaves[i], 0)) < 0) {
             ret = tee_process_slave_failure(avf, i, ret);
             if (!ret_all && ret < 0)
                 ret_all = ret;
         }
     }
     av_freep(&tee->slaves);
+    free_bsf_chains(tee);
     return ret_all;
 }
 
-static int tee_write_packet(AVFormatContext *avf, AVPacket *pkt)
+/* Pass an output packet of a bitstream filter chain, with timestamps in
+ * time_base, to every slave using the chain. The packet reference is
+ * consumed. */
+static int tee_dispatch_packet(AVFormatContext *avf, int chain_idx,
+                               AVPacket *pkt, AVRational time_base)
 {
     TeeContext *tee = avf->priv_data;
-    AVFormatContext *avf2;
-    AVBSFContext *bsfs;
+    TeeBSFChain *chain = &tee->bsf_chains[chain_idx];
     AVPacket pkt2;
     int ret_all = 0, ret;
-    unsigned i, s;
+    unsigned i;
     int s2;
 
     for (i = 0; i < tee->nb_slaves; i++) {
-        if (!(avf2 = tee->slaves[i].avf))
+        if (!slave_uses_bsf_chain(tee, i, chain_idx))
+            continue;
+        s2 = tee->slaves[i].stream_map[chain->stream_index];
+
+        if ((ret = av_packet_ref(&pkt2, pkt)) < 0) {
+            if (!ret_all)
+                ret_all = ret;
             continue;
+        }
+        pkt2.stream_index = s2;
+        av_packet_rescale_ts(&pkt2, time_base,
+                             tee->slaves[i].avf->streams[s2]->time_base);
+
+        ret = write_slave_packet(avf, i, &pkt2);
+        if (ret < 0) {
+            ret = tee_process_slave_failure(avf, i, ret);
+            if (!ret_all && ret < 0)
+                ret_all = ret;
+        }
+    }
+    av_packet_unref(pkt);
+    return ret_all;
+}
 
-        /* Flush slave if pkt is NULL*/
-        if (!pkt) {
-            ret = av_interleaved_write_frame(avf2, NULL);
+static int tee_process_bsf_chain_failure(AVFormatContext *avf, int chain_idx, int err_n)
+{
+    TeeContext *tee = avf->priv_data;
+    int ret_all = 0, ret;
+    unsigned i;
+
+    av_log(avf, AV_LOG_ERROR, "Error while filtering packet: %s\n",
+           av_err2str(err_n));
+    for (i = 0; i < tee->nb_slaves; i++) {
+        if (!slave_uses_bsf_chain(tee, i, chain_idx))
+            continue;
+        ret = tee_process_slave_failure(avf, i, err_n);
+        if (!ret_all && ret < 0)
+            ret_all = ret;
+    }
+    return ret_all;
+}
+
+static int tee_write_packet(AVFormatContext *avf, AVPacket *pkt)
+{
+    TeeContext *tee = avf->priv_data;
+    AVPacket pkt2;
+    int ret_all = 0, ret;
+    unsigned i;
+    int c;
+
+    /* Flush slaves if pkt is NULL */
+    if (!pkt) {
+        for (i = 0; i < tee->nb_slaves; i++) {
+            if (!tee->slaves[i].avf)
+                continue;
+            ret = write_slave_packet(avf, i, NULL);
             if (ret < 0) {
                 ret = tee_process_slave_failure(avf, i, ret);
                 if (!ret_all && ret < 0)
                     ret_all = ret;
             }
-            continue;
         }
+        return ret_all;
+    }
 
-        s = pkt->stream_index;
-        s2 = tee->slaves[i].stream_map[s];
-        if (s2 < 0)
+    for (c = 0; c < tee->nb_bsf_chains; c++) {
+        TeeBSFChain *chain = &tee->bsf_chains[c];
+
+        if (chain->stream_index != pkt->stream_index)
+            continue;
+        for (i = 0; i < tee->nb_slaves; i++)
+            if (slave_uses_bsf_chain(tee, i, c))
+                break;
+        if (i == tee->nb_slaves)
             continue;
 
-        if ((ret = av_packet_ref(&pkt2, pkt)) < 0)
-            if (!ret_all) {
+        if ((ret = av_packet_ref(&pkt2, pkt)) < 0) {
+            if (!ret_all)
                 ret_all = ret;
-                continue;
-            }
-        bsfs = tee->slaves[i].bsfs[s2];
-        pkt2.stream_index = s2;
+            continue;
+        }
 
-        ret = av_bsf_send_packet(bsfs, &pkt2);
-        if (ret < 0) {
-            av_log(avf, AV_LOG_ERROR, "Error while sending packet to bitstream filter: %s\n",
-                   av_err2str(ret));
-            ret = tee_process_slave_failure(avf, i, ret);
+        if (!chain->bsf) {
+            ret = tee_dispatch_packet(avf, c, &pkt2,
+                                      avf->streams[pkt->stream_index]->time_base);
             if (!ret_all && ret < 0)
                 ret_all = ret;
+            continue;
         }
 
-        while(1) {
-            ret = av_bsf_receive_packet(bsfs, &pkt2);
-            if (ret == AVERROR(EAGAIN)) {
-                ret = 0;
-                break;
-            } else if (ret < 0) {
-                break;
+        ret = av_bsf_send_packet(chain->bsf, &pkt2);
+        if (ret < 0) {
+            av_packet_unref(&pkt2);
+        } else {
+            while ((ret = av_bsf_receive_packet(chain->bsf, &pkt2)) >= 0) {
+                ret = tee_dispatch_packet(avf, c, &pkt2, chain->bsf->time_base_out);
+                if (!ret_all && ret < 0)
+                    ret_all = ret;
             }
-
-            av_packet_rescale_ts(&pkt2, bsfs->time_base_out,
-                                 avf2->streams[s2]->time_base);
-            ret = av_interleaved_write_frame(avf2, &pkt2);
-            if (ret < 0)
-                break;
-        };
+            if (ret == AVERROR(EAGAIN))
+                ret = 0;
+        }
 
         if (ret < 0) {
-            ret = tee_process_slave_failure(avf, i, ret);
+            ret = tee_process_bsf_chain_failure(avf, c, ret);
             if (!ret_all && ret < 0)
                 ret_all = ret;
         }
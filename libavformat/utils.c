@@ -43,6 +43,7 @@
 #include "avio_internal.h"
 #include "id3v2.h"
 #include "internal.h"
+#include "probecache.h"
 #if CONFIG_NETWORK
 #include "network.h"
 #endif
@@ -406,6 +407,19 @@ int av_demuxer_open(AVFormatContext *ic) {
     return 0;
 }
 
+/* Probe the format of an opened input, consulting the probe cache first. */
+static int probe_input(AVFormatContext *s, const char *filename)
+{
+    int ret;
+
+    if (s->probe_cache && (ret = ff_probe_cache_lookup(s)) != 0)
+        return ret;
+    if (s->iformat)
+        return 0;
+    return av_probe_input_buffer2(s->pb, &s->iformat, filename,
+                                 s, 0, s->format_probesize);
+}
+
 /* Open input file and probe the format if necessary. */
 static int init_input(AVFormatContext *s, const char *filename,
                       AVDictionary **options)
@@ -416,13 +430,12 @@ static int init_input(AVFormatContext *s, const char *filename,
 
     if (s->pb) {
         s->flags |= AVFMT_FLAG_CUSTOM_IO;
-        if (!s->iformat)
-            return av_probe_input_buffer2(s->pb, &s->iformat, filename,
-                                         s, 0, s->format_probesize);
-        else if (s->iformat->flags & AVFMT_NOFILE)
+        if (s->iformat && s->iformat->flags & AVFMT_NOFILE) {
             av_log(s, AV_LOG_WARNING, "Custom AVIOContext makes no sense and "
                                       "will be ignored with AVFMT_NOFILE format.\n");
-        return 0;
+            return 0;
+        }
+        return probe_input(s, filename);
     }
 
     if ((s->iformat && s->iformat->flags & AVFMT_NOFILE) ||
@@ -432,10 +445,7 @@ static int init_input(AVFormatContext *s, const char *filename,
     if ((ret = s->io_open(s, &s->pb, filename, AVIO_FLAG_READ | s->avio_flags, options)) < 0)
         return ret;
 
-    if (s->iformat)
-        return 0;
-    return av_probe_input_buffer2(s->pb, &s->iformat, filename,
-                                 s, 0, s->format_probesize);
+    return probe_input(s, filename);
 }
 
 int ff_packet_list_put(AVPacketList **packet_buffer,
@@ -3632,6 +3642,14 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
 
     flush_codecs = probesize > 0;
 
+    if (ic->internal->probe_cache) {
+        ret = ff_probe_cache_apply(ic);
+        if (ret < 0)
+            return ret;
+        if (ret > 0)
+            return update_stream_avctx(ic);
+    }
+
     av_opt_set(ic, "skip_clear", "1", AV_OPT_SEARCH_CHILDREN);
 
     max_stream_analyze_duration = max_analyze_duration;
@@ -4204,6 +4222,9 @@ FF_ENABLE_DEPRECATION_WARNINGS
         st->internal->avctx_inited = 0;
     }
 
+    if (ret >= 0 && ic->probe_cache)
+        ff_probe_cache_store(ic);
+
 find_stream_info_err:
     for (i = 0; i < ic->nb_streams; i++) {
         st = ic->streams[i];
@@ -4481,6 +4502,9 @@ void avformat_free_context(AVFormatContext *s)
     av_freep(&s->chapters);
     av_dict_free(&s->metadata);
     av_dict_free(&s->internal->id3v2_meta);
+    av_dict_free(&s->internal->probe_cache);
+    av_freep(&s->internal->probe_cache_key);
+    av_freep(&s->internal->probe_cache_file);
     av_freep(&s->streams);
     flush_packet_queue(s);
     av_freep(&s->internal);
@@ -26,6 +26,72 @@
 #include "mem.h"
 #include "thread.h"
 
+/* upper bound on the memory kept around per cache, the largest object is
+ * an AVFrame */
+#define OBJECT_CACHE_MAX 256
+
+static atomic_uint_fast64_t objects_allocated;
+static atomic_uint_fast64_t objects_reused;
+
+static FFObjectCache buffer_cache = FF_OBJECT_CACHE_INITIALIZER(AVBuffer);
+static FFObjectCache ref_cache    = FF_OBJECT_CACHE_INITIALIZER(AVBufferRef);
+
+void *ff_object_cache_alloc(FFObjectCache *cache)
+{
+    void *obj;
+
+    ff_mutex_lock(&cache->mutex);
+    obj = cache->head;
+    if (obj) {
+        cache->head = *(void **)obj;
+        cache->nb_objects--;
+    }
+    ff_mutex_unlock(&cache->mutex);
+
+    if (obj) {
+        atomic_fetch_add_explicit(&objects_reused, 1, memory_order_relaxed);
+        memset(obj, 0, cache->size);
+        return obj;
+    }
+
+    obj = av_mallocz(cache->size);
+    if (obj)
+        atomic_fetch_add_explicit(&objects_allocated, 1, memory_order_relaxed);
+    return obj;
+}
+
+void ff_object_cache_freep(FFObjectCache *cache, void *arg)
+{
+    void *obj;
+
+    memcpy(&obj, arg, sizeof(obj));
+    memcpy(arg, &(void *){ NULL }, sizeof(obj));
+    if (!obj)
+        return;
+
+    /* recycled objects would hide use-after-free from the poisoning */
+    if (!CONFIG_MEMORY_POISONING) {
+        ff_mutex_lock(&cache->mutex);
+        if (cache->nb_objects < OBJECT_CACHE_MAX) {
+            *(void **)obj = cache->head;
+            cache->head   = obj;
+            cache->nb_objects++;
+            obj = NULL;
+        }
+        ff_mutex_unlock(&cache->mutex);
+    }
+
+    av_free(obj);
+}
+
+void av_buffer_get_alloc_stats(uint64_t *allocated, uint64_t *reused)
+{
+    if (allocated)
+        *allocated = atomic_load_explicit(&objects_allocated, memory_order_relaxed);
+    if (reused)
+        *reused    = atomic_load_explicit(&objects_reused, memory_order_relaxed);
+}
+
 AVBufferRef *av_buffer_create(uint8_t *data, int size,
                               void (*free)(void *opaque, uint8_t *data),
                               void *opaque, int flags)
@@ -33,7 +99,7 @@ AVBufferRef *av_buffer_create(uint8_t *data, int size,
     AVBufferRef *ref = NULL;
     AVBuffer    *buf = NULL;
 
-    buf = av_mallocz(sizeof(*buf));
+    buf = ff_object_cache_alloc(&buffer_cache);
     if (!buf)
         return NULL;
 
@@ -46,9 +112,9 @@ AVBufferRef *av_buffer_create(uint8_t *data, int size,
 
     buf->flags = flags;
 
-    ref = av_mallocz(sizeof(*ref));
+    ref = ff_object_cache_alloc(&ref_cache);
     if (!ref) {
-        av_freep(&buf);
+        ff_object_cache_freep(&buffer_cache, &buf);
         return NULL;
     }
 
@@ -92,7 +158,7 @@ AVBufferRef *av_buffer_allocz(int size)
 
 AVBufferRef *av_buffer_ref(AVBufferRef *buf)
 {
-    AVBufferRef *ret = av_mallocz(sizeof(*ret));
+    AVBufferRef *ret = ff_object_cache_alloc(&ref_cache);
 
     if (!ret)
         return NULL;
@@ -112,13 +178,17 @@ static void buffer_replace(AVBufferRef **dst, AVBufferRef **src)
 
     if (src) {
         **dst = **src;
-        av_freep(src);
+        ff_object_cache_freep(&ref_cache, src);
     } else
-        av_freep(dst);
+        ff_object_cache_freep(&ref_cache, dst);
 
     if (atomic_fetch_sub_explicit(&b->refcount, 1, memory_order_acq_rel) == 1) {
+        /* b->free() may free the pool entry b is part of, so the flag has
+         * to be read first */
+        int free_avbuffer = !(b->flags_internal & BUFFER_FLAG_NO_FREE);
         b->free(b->opaque, b->data);
-        av_freep(&b);
+        if (free_avbuffer)
+            ff_object_cache_freep(&buffer_cache, &b);
     }
 }
 
@@ -273,19 +343,99 @@ static void buffer_pool_free(AVBufferPool *pool)
     av_freep(&pool);
 }
 
-void av_buffer_pool_flush(AVBufferPool *pool)
+/* must be called with pool->mutex locked */
+static void buffer_pool_trim(AVBufferPool *pool, int nb_keep)
 {
-    ff_mutex_lock(&pool->mutex);
-    while (pool->pool) {
+    while (pool->pool && pool->nb_free > nb_keep) {
         BufferPoolEntry *buf = pool->pool;
         pool->pool = buf->next;
+        pool->nb_free--;
 
         buf->free(buf->opaque, buf->data);
         av_freep(&buf);
     }
+}
+
+void av_buffer_pool_flush(AVBufferPool *pool)
+{
+    ff_mutex_lock(&pool->mutex);
+    buffer_pool_trim(pool, 0);
+    ff_mutex_unlock(&pool->mutex);
+}
+
+void av_buffer_pool_set_max_free(AVBufferPool *pool, int max_free)
+{
+    ff_mutex_lock(&pool->mutex);
+    pool->max_free = FFMAX(max_free, 0);
+    if (pool->max_free)
+        buffer_pool_trim(pool, pool->max_free);
     ff_mutex_unlock(&pool->mutex);
 }
 
+void av_buffer_pool_get_stats(AVBufferPool *pool, int *nb_in_use, int *nb_free,
+                              int *max_in_use, uint64_t *nb_allocated)
+{
+    ff_mutex_lock(&pool->mutex);
+    if (nb_in_use)
+        *nb_in_use    = pool->nb_in_use;
+    if (nb_free)
+        *nb_free      = pool->nb_free;
+    if (max_in_use)
+        *max_in_use   = pool->max_in_use;
+    if (nb_allocated)
+        *nb_allocated = pool->nb_allocated;
+    ff_mutex_unlock(&pool->mutex);
+}
+
+#define PREWARM_PAGE_SIZE 4096
+
+int av_buffer_pool_prewarm(AVBufferPool *pool, int nb_buffers)
+{
+    AVBufferRef **bufs;
+    uint64_t nb_allocated, nb_allocated_after;
+    int i, ret = 0;
+
+    if (nb_buffers <= 0)
+        return 0;
+
+    bufs = av_malloc_array(nb_buffers, sizeof(*bufs));
+    if (!bufs)
+        return AVERROR(ENOMEM);
+
+    for (i = 0; i < nb_buffers; i++) {
+        ff_mutex_lock(&pool->mutex);
+        nb_allocated = pool->nb_allocated;
+        ff_mutex_unlock(&pool->mutex);
+
+        bufs[i] = av_buffer_pool_get(pool);
+        if (!bufs[i]) {
+            ret = AVERROR(ENOMEM);
+            break;
+        }
+
+        ff_mutex_lock(&pool->mutex);
+        nb_allocated_after = pool->nb_allocated;
+        ff_mutex_unlock(&pool->mutex);
+
+        /* only touch the buffers that were allocated just now, the ones
+         * already in the pool have been used before */
+        if (nb_allocated_after != nb_allocated && bufs[i]->size > 0) {
+            volatile uint8_t *data = bufs[i]->data;
+            int j;
+
+            for (j = 0; j < bufs[i]->size; j += PREWARM_PAGE_SIZE)
+                data[j] = data[j];
+            data[bufs[i]->size - 1] = data[bufs[i]->size - 1];
+        }
+    }
+
+    while (i--)
+        av_buffer_unref(&bufs[i]);
+    av_free(bufs);
+
+    return ret;
+}
+
 void av_buffer_pool_uninit(AVBufferPool **ppool)
 {
     AVBufferPool *pool;
@@ -308,10 +458,20 @@ static void pool_release_buffer(void *opaque, uint8_t *data)
         memset(buf->data, FF_MEMORY_POISON, pool->size);
 
     ff_mutex_lock(&pool->mutex);
-    buf->next = pool->pool;
-    pool->pool = buf;
+    pool->nb_in_use--;
+    if (!pool->max_free || pool->nb_free < pool->max_free) {
+        buf->next = pool->pool;
+        pool->pool = buf;
+        pool->nb_free++;
+        buf = NULL;
+    }
     ff_mutex_unlock(&pool->mutex);
 
+    if (buf) {
+        buf->free(buf->opaque, buf->data);
+        av_free(buf);
+    }
+
     if (atomic_fetch_sub_explicit(&pool->refcount, 1, memory_order_acq_rel) == 1)
         buffer_pool_free(pool);
 }
@@ -344,6 +504,8 @@ static AVBufferRef *pool_alloc_buffer(AVBufferPool *pool)
     ret->buffer->opaque = buf;
     ret->buffer->free   = pool_release_buffer;
 
+    pool->nb_allocated++;
+
     return ret;
 }
 
@@ -355,17 +517,46 @@ AVBufferRef *av_buffer_pool_get(AVBufferPool *pool)
     ff_mutex_lock(&pool->mutex);
     buf = pool->pool;
     if (buf) {
-        ret = av_buffer_create(buf->data, pool->size, pool_release_buffer,
-                               buf, 0);
-        if (ret) {
-            pool->pool = buf->next;
-            buf->next = NULL;
-        }
+        pool->pool = buf->next;
+        pool->nb_free--;
+        buf->next = NULL;
+        ret = NULL;
     } else {
         ret = pool_alloc_buffer(pool);
     }
+    if (buf || ret) {
+        pool->nb_in_use++;
+        pool->max_in_use = FFMAX(pool->max_in_use, pool->nb_in_use);
+    }
     ff_mutex_unlock(&pool->mutex);
 
+    if (buf) {
+        /* reuse the AVBuffer embedded in the entry, only the reference
+         * itself needs to be allocated */
+        ret = ff_object_cache_alloc(&ref_cache);
+        if (!ret) {
+            ff_mutex_lock(&pool->mutex);
+            buf->next  = pool->pool;
+            pool->pool = buf;
+            pool->nb_free++;
+            pool->nb_in_use--;
+            ff_mutex_unlock(&pool->mutex);
+            return NULL;
+        }
+
+        memset(&buf->buffer, 0, sizeof(buf->buffer));
+        buf->buffer.data           = buf->data;
+        buf->buffer.size           = pool->size;
+        buf->buffer.free           = pool_release_buffer;
+        buf->buffer.opaque         = buf;
+        buf->buffer.flags_internal = BUFFER_FLAG_NO_FREE;
+        atomic_init(&buf->buffer.refcount, 1);
+
+        ret->buffer = &buf->buffer;
+        ret->data   = buf->data;
+        ret->size   = pool->size;
+    }
+
     if (ret)
         atomic_fetch_add_explicit(&pool->refcount, 1, memory_order_relaxed);
 
@@ -138,6 +138,19 @@ AVBufferRef *av_buffer_create(uint8_t *data, int size,
  */
 void av_buffer_default_free(void *opaque, uint8_t *data);
 
+/**
+ * Get allocation statistics for the small objects libavutil recycles
+ * internally: the AVBuffer and AVBufferRef wrappers, AVFrame structs and
+ * frame side data entries. This is meant for profiling and may be called
+ * from any thread.
+ *
+ * @param allocated if non-NULL, set to the number of objects allocated
+ *                  from the heap since the start of the process
+ * @param reused    if non-NULL, set to the number of objects taken from the
+ *                  internal free lists instead
+ */
+void av_buffer_get_alloc_stats(uint64_t *allocated, uint64_t *reused);
+
 /**
  * Create a new reference to an AVBuffer.
  *
@@ -303,6 +316,47 @@ AVBufferRef *av_buffer_pool_get(AVBufferPool *pool);
  */
 void *av_buffer_pool_buffer_get_opaque(AVBufferRef *ref);
 
+/**
+ * Limit the number of unused buffers kept in the pool. When a buffer is
+ * returned while max_free buffers are already waiting in the pool, it is
+ * freed instead. Buffers above the new limit are freed immediately, so this
+ * can be used to give memory back after a spike in usage.
+ *
+ * @param max_free maximum number of unused buffers, 0 for no limit (the
+ *                 default)
+ */
+void av_buffer_pool_set_max_free(AVBufferPool *pool, int max_free);
+
+/**
+ * Get usage statistics of a buffer pool. Any of the pointers may be NULL.
+ *
+ * @param nb_in_use    set to the number of buffers currently handed out
+ * @param nb_free      set to the number of unused buffers in the pool
+ * @param max_in_use   set to the highest number of buffers handed out at
+ *                     the same time, which can be used to choose max_free
+ * @param nb_allocated set to the number of buffers allocated by the pool
+ *                     since it was created
+ */
+void av_buffer_pool_get_stats(AVBufferPool *pool, int *nb_in_use, int *nb_free,
+                              int *max_in_use, uint64_t *nb_allocated);
+
+/**
+ * Make sure the pool can hand out nb_buffers buffers at the same time
+ * without allocating. Missing buffers are allocated and every page of them
+ * is written to, so that the page faults are taken now rather than on first
+ * use. On systems with a first-touch NUMA policy this also places the memory
+ * on the node of the calling thread, so call this from the thread that will
+ * use the buffers.
+ *
+ * Buffers above the limit set with av_buffer_pool_set_max_free() are freed
+ * again when they are returned, so that limit should not be lower than
+ * nb_buffers.
+ *
+ * @return 0 on success, a negative AVERROR on failure, in which case the
+ *         buffers allocated so far are kept in the pool
+ */
+int av_buffer_pool_prewarm(AVBufferPool *pool, int nb_buffers);
+
 /**
  * @}
  */
@@ -30,6 +30,12 @@
  */
 #define BUFFER_FLAG_REALLOCATABLE (1 << 0)
 
+/**
+ * The AVBuffer structure is part of a BufferPoolEntry and is not freed
+ * together with the buffer.
+ */
+#define BUFFER_FLAG_NO_FREE (1 << 1)
+
 struct AVBuffer {
     uint8_t *data; /**< data described by this buffer */
     int      size; /**< size of data in bytes */
@@ -72,6 +78,12 @@ typedef struct BufferPoolEntry {
 
     AVBufferPool *pool;
     struct BufferPoolEntry *next;
+
+    /*
+     * The AVBuffer handed out for this entry when it is reused, so that
+     * av_buffer_pool_get() does not have to allocate one every time.
+     */
+    AVBuffer buffer;
 } BufferPoolEntry;
 
 struct AVBufferPool {
@@ -90,10 +102,45 @@ struct AVBufferPool {
     atomic_uint refcount;
 
     int size;
+
+    /* the following are protected by mutex */
+    int nb_free;          ///< number of buffers in pool
+    int max_free;         ///< 0 or the maximum for nb_free
+    int nb_in_use;        ///< number of buffers handed out
+    int max_in_use;       ///< highest nb_in_use so far
+    uint64_t nb_allocated;
+
     void *opaque;
     AVBufferRef* (*alloc)(int size);
     AVBufferRef* (*alloc2)(void *opaque, int size);
     void         (*pool_free)(void *opaque);
 };
 
+/**
+ * A thread-safe free list of fixed-size objects. It is used to recycle
+ * the small structs that are allocated and freed for every packet and
+ * frame (AVBuffer, AVBufferRef, AVFrame, AVFrameSideData), so they do not
+ * go through the allocator every time.
+ */
+typedef struct FFObjectCache {
+    AVMutex mutex;
+    void  *head;       ///< freed objects, linked through their first bytes
+    int    nb_objects; ///< number of objects in the list
+    size_t size;       ///< size of one object
+} FFObjectCache;
+
+#define FF_OBJECT_CACHE_INITIALIZER(type) { AV_MUTEX_INITIALIZER, NULL, 0, sizeof(type) }
+
+/**
+ * Get a zeroed object from the cache, or allocate a new one when the
+ * cache is empty.
+ */
+void *ff_object_cache_alloc(FFObjectCache *cache);
+
+/**
+ * Give an object back to the cache, or free it when the cache is full.
+ * Sets *obj to NULL.
+ */
+void ff_object_cache_freep(FFObjectCache *cache, void *obj);
+
 #endif /* AVUTIL_BUFFER_INTERNAL_H */
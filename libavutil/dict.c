@@ -27,11 +27,110 @@
 #include "time_internal.h"
 #include "bprint.h"
 
+/* dictionaries with more entries than this get a hash index */
+#define DICT_HASH_MIN_COUNT 32
+
 struct AVDictionary {
     int count;
     AVDictionaryEntry *elems;
+    /**
+     * Open addressing hash table of indices into elems, -1 marks a free
+     * slot. The size is a power of two, at least twice count. Keys are
+     * hashed case-insensitively so both lookup modes can use it.
+     */
+    int *hash;
+    unsigned hash_mask;
 };
 
+static unsigned dict_hash(const char *key)
+{
+    uint32_t h = 2166136261U;
+
+    if (key)
+        for (; *key; key++)
+            h = (h ^ av_toupper(*key)) * 16777619U;
+    return h;
+}
+
+static unsigned dict_hash_find_slot(const AVDictionary *m, int idx)
+{
+    unsigned i = dict_hash(m->elems[idx].key) & m->hash_mask;
+
+    while (m->hash[i] != idx)
+        i = (i + 1) & m->hash_mask;
+    return i;
+}
+
+static void dict_hash_insert(AVDictionary *m, int idx)
+{
+    unsigned i = dict_hash(m->elems[idx].key) & m->hash_mask;
+
+    while (m->hash[i] >= 0)
+        i = (i + 1) & m->hash_mask;
+    m->hash[i] = idx;
+}
+
+static void dict_hash_remove(AVDictionary *m, int idx)
+{
+    unsigned i = dict_hash_find_slot(m, idx), j = i;
+
+    /* backward shift deletion: move later members of the probe run
+     * into the hole unless that would put them before their home slot */
+    for (;;) {
+        unsigned home;
+        j = (j + 1) & m->hash_mask;
+        if (m->hash[j] < 0)
+            break;
+        home = dict_hash(m->elems[m->hash[j]].key) & m->hash_mask;
+        if (((j - home) & m->hash_mask) >= ((j - i) & m->hash_mask)) {
+            m->hash[i] = m->hash[j];
+            i = j;
+        }
+    }
+    m->hash[i] = -1;
+}
+
+/* Add the last entry to the index, building or growing it as needed.
+ * Once built, the index is kept even if the dictionary shrinks back
+ * below DICT_HASH_MIN_COUNT, so every entry must be added to it.
+ * The index is only an accelerator, so on allocation failure it is
+ * dropped and lookups fall back to the linear scan. */
+static void dict_hash_add_last(AVDictionary *m)
+{
+    unsigned size = m->hash ? m->hash_mask + 1 : 0;
+    int i;
+
+    if (m->count * 2U <= size) {
+        dict_hash_insert(m, m->count - 1);
+        return;
+    }
+    if (m->count <= DICT_HASH_MIN_COUNT)
+        return;
+
+    size = FFMAX(size, 2 * DICT_HASH_MIN_COUNT);
+    while (size < m->count * 4U)
+        size <<= 1;
+    av_freep(&m->hash);
+    m->hash = av_malloc_array(size, sizeof(*m->hash));
+    if (!m->hash)
+        return;
+    m->hash_mask = size - 1;
+    memset(m->hash, -1, size * sizeof(*m->hash));
+    for (i = 0; i < m->count; i++)
+        dict_hash_insert(m, i);
+}
+
+static int dict_key_equal(const char *s, const char *key, int flags)
+{
+    if (!s)
+        return 0;
+    if (flags & AV_DICT_MATCH_CASE)
+        return !strcmp(s, key);
+    for (; av_toupper(*s) == av_toupper(*key) && *key; s++, key++)
+        ;
+    return !*s && !*key;
+}
+
 int av_dict_count(const AVDictionary *m)
 {
     return m ? m->count : 0;
@@ -50,6 +149,21 @@ AVDictionaryEntry *av_dict_get(const AVDictionary *m, const char *key,
     else
         i = 0;
 
+    if (m->hash && !(flags & AV_DICT_IGNORE_SUFFIX)) {
+        /* all entries with a matching key are in the probe run of the
+         * key's home slot; return the first one after prev */
+        unsigned slot = dict_hash(key) & m->hash_mask;
+        int idx, best = -1;
+
+        while ((idx = m->hash[slot]) >= 0) {
+            if (idx >= i && (best < 0 || idx < best) &&
+                dict_key_equal(m->elems[idx].key, key, flags))
+                best = idx;
+            slot = (slot + 1) & m->hash_mask;
+        }
+        return best >= 0 ? &m->elems[best] : NULL;
+    }
+
     for (; i < m->count; i++) {
         const char *s = m->elems[i].key;
         if (flags & AV_DICT_MATCH_CASE)
@@ -100,6 +214,12 @@ int av_dict_set(AVDictionary **pm, const char *key, const char *value,
             oldval = tag->value;
         else
             av_free(tag->value);
+        if (m->hash) {
+            int idx = tag - m->elems;
+            dict_hash_remove(m, idx);
+            if (idx != m->count - 1)
+                m->hash[dict_hash_find_slot(m, m->count - 1)] = idx;
+        }
         av_free(tag->key);
         *tag = m->elems[--m->count];
     } else if (copy_value) {
@@ -124,10 +244,12 @@ int av_dict_set(AVDictionary **pm, const char *key, const char *value,
             av_freep(&copy_value);
         }
         m->count++;
+        dict_hash_add_last(m);
     } else {
         av_freep(&copy_key);
     }
     if (!m->count) {
+        av_freep(&m->hash);
         av_freep(&m->elems);
         av_freep(pm);
     }
@@ -136,6 +258,7 @@ int av_dict_set(AVDictionary **pm, const char *key, const char *value,
 
 err_out:
     if (m && !m->count) {
+        av_freep(&m->hash);
         av_freep(&m->elems);
         av_freep(pm);
     }
@@ -209,6 +332,7 @@ void av_dict_free(AVDictionary **pm)
             av_freep(&m->elems[m->count].key);
             av_freep(&m->elems[m->count].value);
         }
+        av_freep(&m->hash);
         av_freep(&m->elems);
     }
     av_freep(pm);
@@ -28,6 +28,7 @@
 
 #include <float.h>
 #include "attributes.h"
+#include "avassert.h"
 #include "avutil.h"
 #include "common.h"
 #include "eval.h"
@@ -45,6 +46,8 @@ typedef struct Parser {
     int stack_index;
     char *s;
     const double *const_values;
+    const double * const *const_rows;         // per-constant overrides, indexed by row_index
+    int row_index;
     const char * const *const_names;          // NULL terminated
     double (* const *funcs1)(void *, double a);           // NULL terminated
     const char * const *func1_names;          // NULL terminated
@@ -174,8 +177,16 @@ struct AVExpr {
     } a;
     struct AVExpr *param[3];
     double *var;
+    struct ExprProgram *prog;
 };
 
+static av_always_inline double const_value(const Parser *p, int index)
+{
+    if (p->const_rows && p->const_rows[index])
+        return p->const_rows[index][p->row_index];
+    return p->const_values[index];
+}
+
 static double etime(double v)
 {
     return av_gettime() * 0.000001;
@@ -185,7 +196,7 @@ static double eval_expr(Parser *p, AVExpr *e)
 {
     switch (e->type) {
         case e_value:  return e->value;
-        case e_const:  return e->value * p->const_values[e->const_index];
+        case e_const:  return e->value * const_value(p, e->const_index);
         case e_func0:  return e->value * e->a.func0(eval_expr(p, e->param[0]));
         case e_func1:  return e->value * e->a.func1(p->opaque, eval_expr(p, e->param[0]));
         case e_func2:  return e->value * e->a.func2(p->opaque, eval_expr(p, e->param[0]), eval_expr(p, e->param[1]));
@@ -333,6 +344,8 @@ static double eval_expr(Parser *p, AVExpr *e)
 
 static int parse_expr(AVExpr **e, Parser *p);
 
+static void free_program(struct ExprProgram **prog);
+
 void av_expr_free(AVExpr *e)
 {
     if (!e) return;
@@ -340,6 +353,7 @@ void av_expr_free(AVExpr *e)
     av_expr_free(e->param[1]);
     av_expr_free(e->param[2]);
     av_freep(&e->var);
+    free_program(&e->prog);
     av_freep(&e);
 }
 
@@ -682,6 +696,476 @@ static int verify_expr(AVExpr *e)
     }
 }
 
+/* Expressions are compiled into a flat program for a small register
+ * machine when they are parsed. Every instruction reads its operands from
+ * registers and writes its result to register dst, the final result ends
+ * up in register 0. Subexpressions that read or modify the variables, or
+ * loop over them, are not compiled and are evaluated by eval_expr(). */
+
+#define MAX_REGS  24
+#define ROW_BLOCK 32
+
+enum {
+    OP_VALUE, OP_CONST, OP_FUNC0, OP_FUNC1, OP_FUNC2, OP_TREE,
+    OP_SQUISH, OP_GAUSS, OP_ISNAN, OP_ISINF, OP_FLOOR, OP_CEIL, OP_TRUNC,
+    OP_ROUND, OP_SGN, OP_SQRT, OP_NOT,
+    OP_MOD, OP_GCD, OP_MAX, OP_MIN, OP_EQ, OP_GT, OP_GTE, OP_LT, OP_LTE,
+    OP_POW, OP_MUL, OP_DIV, OP_ADD, OP_LAST, OP_HYPOT, OP_ATAN2,
+    OP_BITAND, OP_BITOR,
+    OP_CLIP, OP_BETWEEN, OP_LERP, OP_SELECT,
+    OP_SCALE, OP_JZ, OP_JNZ, OP_JMP,
+};
+
+typedef struct ExprInsn {
+    int op;
+    int dst;
+    int src[3];
+    int index;          ///< constant index or jump target
+    double value;       ///< scale of the result, the value itself for OP_VALUE
+    union {
+        double (*func0)(double);
+        double (*func1)(void *, double);
+        double (*func2)(void *, double, double);
+    } a;
+    AVExpr *tree;       ///< subexpression evaluated by OP_TREE
+} ExprInsn;
+
+typedef struct ExprProgram {
+    ExprInsn *insn;
+    int nb_insn;
+    int scalar_only;    ///< contains jumps or state, cannot be run on a row
+} ExprProgram;
+
+static void free_program(ExprProgram **prog)
+{
+    if (!*prog)
+        return;
+    av_freep(&(*prog)->insn);
+    av_freep(prog);
+}
+
+/* Whether evaluating e reads or writes the variables or is otherwise not
+ * a pure function of the constants. */
+static int expr_has_state(const AVExpr *e)
+{
+    int i;
+
+    if (!e)
+        return 0;
+    switch (e->type) {
+    case e_ld:
+    case e_st:
+    case e_random:
+    case e_print:
+    case e_while:
+    case e_taylor:
+    case e_root:
+        return 1;
+    case e_func0:
+        if (e->a.func0 == etime)
+            return 1;
+        break;
+    default:
+        break;
+    }
+    for (i = 0; i < 3; i++)
+        if (expr_has_state(e->param[i]))
+            return 1;
+    return 0;
+}
+
+/* Whether the node converts its arguments to integers, which is undefined
+ * for out of range values, so it must only run where the tree evaluator
+ * would run it. */
+static int expr_converts_to_int(const AVExpr *e)
+{
+    return e->type == e_gcd || e->type == e_bitand || e->type == e_bitor;
+}
+
+/* Whether both branches of an if() can be evaluated unconditionally: the
+ * user functions might not be prepared for the arguments the condition
+ * guards against. */
+static int expr_is_eager(const AVExpr *e)
+{
+    int i;
+
+    if (!e)
+        return 1;
+    if (e->type == e_func1 || e->type == e_func2 || expr_has_state(e) ||
+        expr_converts_to_int(e))
+        return 0;
+    for (i = 0; i < 3; i++)
+        if (!expr_is_eager(e->param[i]))
+            return 0;
+    return 1;
+}
+
+/* Replace the subexpressions which only depend on numbers by their value. */
+static void fold_constants(AVExpr *e)
+{
+    Parser p = { 0 };
+    int i, foldable = 1;
+
+    if (!e)
+        return;
+    for (i = 0; i < 3; i++) {
+        fold_constants(e->param[i]);
+        if (e->param[i] && e->param[i]->type != e_value)
+            foldable = 0;
+    }
+    if (!foldable || e->type == e_value || e->type == e_const ||
+        e->type == e_func1 || e->type == e_func2 || expr_has_state(e) ||
+        expr_converts_to_int(e))
+        return;
+
+    e->value = eval_expr(&p, e);
+    e->type  = e_value;
+    for (i = 0; i < 3; i++) {
+        av_expr_free(e->param[i]);
+        e->param[i] = NULL;
+    }
+}
+
+typedef struct ExprCompiler {
+    ExprProgram *prog;
+    int size;
+    int error;
+} ExprCompiler;
+
+static ExprInsn *emit(ExprCompiler *c, int op, int dst, double value)
+{
+    ExprProgram *prog = c->prog;
+    ExprInsn *in;
+
+    if (c->error)
+        return NULL;
+    if (dst >= MAX_REGS) {
+        c->error = AVERROR(ENOSPC);
+        return NULL;
+    }
+    if (prog->nb_insn >= c->size) {
+        int size = FFMAX(2 * c->size, 16);
+        if (av_reallocp_array(&prog->insn, size, sizeof(*prog->insn)) < 0) {
+            c->error = AVERROR(ENOMEM);
+            return NULL;
+        }
+        c->size = size;
+    }
+
+    in = &prog->insn[prog->nb_insn++];
+    memset(in, 0, sizeof(*in));
+    in->op     = op;
+    in->dst    = dst;
+    in->src[0] = dst;
+    in->src[1] = dst + 1;
+    in->src[2] = dst + 2;
+    in->value  = value;
+
+    return in;
+}
+
+static void compile_expr(ExprCompiler *c, AVExpr *e, int dst);
+
+static void compile_params(ExprCompiler *c, AVExpr *e, int dst, int nb)
+{
+    int i;
+
+    for (i = 0; i < nb; i++)
+        compile_expr(c, e->param[i], dst + i);
+}
+
+static void compile_tree(ExprCompiler *c, AVExpr *e, int dst)
+{
+    ExprInsn *in = emit(c, OP_TREE, dst, 1);
+    if (in)
+        in->tree = e;
+    c->prog->scalar_only = 1;
+}
+
+static void compile_expr(ExprCompiler *c, AVExpr *e, int dst)
+{
+    static const uint8_t unary_ops[] = {
+        [e_squish] = OP_SQUISH, [e_gauss] = OP_GAUSS, [e_isnan] = OP_ISNAN,
+        [e_isinf]  = OP_ISINF,  [e_floor] = OP_FLOOR, [e_ceil]  = OP_CEIL,
+        [e_trunc]  = OP_TRUNC,  [e_round] = OP_ROUND, [e_sgn]   = OP_SGN,
+        [e_sqrt]   = OP_SQRT,   [e_not]   = OP_NOT,
+    };
+    static const uint8_t binary_ops[] = {
+        [e_mod]    = OP_MOD,    [e_gcd]   = OP_GCD,   [e_max]   = OP_MAX,
+        [e_min]    = OP_MIN,    [e_eq]    = OP_EQ,    [e_gt]    = OP_GT,
+        [e_gte]    = OP_GTE,    [e_lt]    = OP_LT,    [e_lte]   = OP_LTE,
+        [e_pow]    = OP_POW,    [e_mul]   = OP_MUL,   [e_div]   = OP_DIV,
+        [e_add]    = OP_ADD,    [e_last]  = OP_LAST,  [e_hypot] = OP_HYPOT,
+        [e_atan2]  = OP_ATAN2,  [e_bitand] = OP_BITAND, [e_bitor] = OP_BITOR,
+    };
+    ExprInsn *in;
+
+    switch (e->type) {
+    case e_value:
+        emit(c, OP_VALUE, dst, e->value);
+        return;
+    case e_const:
+        if ((in = emit(c, OP_CONST, dst, e->value)))
+            in->index = e->const_index;
+        return;
+    case e_func0:
+        if (e->a.func0 == etime) {
+            compile_tree(c, e, dst);
+            return;
+        }
+        compile_params(c, e, dst, 1);
+        if ((in = emit(c, OP_FUNC0, dst, e->value)))
+            in->a.func0 = e->a.func0;
+        return;
+    case e_func1:
+        compile_params(c, e, dst, 1);
+        if ((in = emit(c, OP_FUNC1, dst, e->value)))
+            in->a.func1 = e->a.func1;
+        return;
+    case e_func2:
+        compile_params(c, e, dst, 2);
+        if ((in = emit(c, OP_FUNC2, dst, e->value)))
+            in->a.func2 = e->a.func2;
+        return;
+    case e_squish: case e_gauss: case e_isnan: case e_isinf:
+    case e_floor:  case e_ceil:  case e_trunc: case e_round:
+    case e_sgn:    case e_sqrt:  case e_not:
+        compile_params(c, e, dst, 1);
+        emit(c, unary_ops[e->type], dst, e->value);
+        return;
+    case e_mod:  case e_gcd:   case e_max:   case e_min:    case e_eq:
+    case e_gt:   case e_gte:   case e_lt:    case e_lte:    case e_pow:
+    case e_mul:  case e_div:   case e_add:   case e_last:   case e_hypot:
+    case e_atan2: case e_bitand: case e_bitor:
+        compile_params(c, e, dst, 2);
+        emit(c, binary_ops[e->type], dst, e->value);
+        return;
+    case e_clip:
+    case e_between:
+        /* eval_expr() evaluates some parameters twice or not at all */
+        if (expr_has_state(e)) {
+            compile_tree(c, e, dst);
+            return;
+        }
+        compile_params(c, e, dst, 3);
+        emit(c, e->type == e_clip ? OP_CLIP : OP_BETWEEN, dst, e->value);
+        return;
+    case e_lerp:
+        compile_params(c, e, dst, 3);
+        emit(c, OP_LERP, dst, 1);
+        return;
+    case e_if:
+    case e_ifnot: {
+        AVExpr *a = e->param[e->type == e_if ? 1 : 2];
+        AVExpr *b = e->param[e->type == e_if ? 2 : 1];
+        int jump, end;
+
+        if (expr_is_eager(e->param[1]) && expr_is_eager(e->param[2])) {
+            compile_expr(c, e->param[0], dst);
+            if (a) compile_expr(c, a, dst + 1);
+            else   emit(c, OP_VALUE, dst + 1, 0);
+            if (b) compile_expr(c, b, dst + 2);
+            else   emit(c, OP_VALUE, dst + 2, 0);
+            emit(c, OP_SELECT, dst, e->value);
+            return;
+        }
+
+        compile_expr(c, e->param[0], dst);
+        jump = c->prog->nb_insn;
+        emit(c, e->type == e_if ? OP_JZ : OP_JNZ, dst, 1);
+        compile_expr(c, e->param[1], dst);
+        end = c->prog->nb_insn;
+        emit(c, OP_JMP, dst, 1);
+        if (!c->error)
+            c->prog->insn[jump].index = c->prog->nb_insn;
+        if (e->param[2]) compile_expr(c, e->param[2], dst);
+        else             emit(c, OP_VALUE, dst, 0);
+        if (!c->error)
+            c->prog->insn[end].index = c->prog->nb_insn;
+        if (e->value != 1)
+            emit(c, OP_SCALE, dst, e->value);
+        c->prog->scalar_only = 1;
+        return;
+    }
+    default:
+        compile_tree(c, e, dst);
+        return;
+    }
+}
+
+/* Returns 0 and no program if the expression needs too many registers,
+ * it is then evaluated by eval_expr(). */
+static int compile_program(AVExpr *e, ExprProgram **prog)
+{
+    ExprCompiler c = { 0 };
+
+    c.prog = av_mallocz(sizeof(*c.prog));
+    if (!c.prog)
+        return AVERROR(ENOMEM);
+
+    compile_expr(&c, e, 0);
+    if (c.error) {
+        free_program(&c.prog);
+        return c.error == AVERROR(ENOMEM) ? c.error : 0;
+    }
+
+    *prog = c.prog;
+    return 0;
+}
+
+static double run_program(const ExprProgram *prog, Parser *p)
+{
+    const ExprInsn *in = prog->insn, *end = in + prog->nb_insn;
+    double r[MAX_REGS];
+
+    while (in < end) {
+        double *d = &r[in->dst];
+#define A r[in->src[0]]
+#define B r[in->src[1]]
+#define C r[in->src[2]]
+        switch (in->op) {
+        case OP_VALUE:  *d = in->value; break;
+        case OP_CONST:  *d = in->value * const_value(p, in->index); break;
+        case OP_FUNC0:  *d = in->value * in->a.func0(A); break;
+        case OP_FUNC1:  *d = in->value * in->a.func1(p->opaque, A); break;
+        case OP_FUNC2:  *d = in->value * in->a.func2(p->opaque, A, B); break;
+        case OP_TREE:   *d = eval_expr(p, in->tree); break;
+        case OP_SQUISH: *d = 1/(1+exp(4*A)); break;
+        case OP_GAUSS:  *d = exp(-A*A/2)/sqrt(2*M_PI); break;
+        case OP_ISNAN:  *d = in->value * !!isnan(A); break;
+        case OP_ISINF:  *d = in->value * !!isinf(A); break;
+        case OP_FLOOR:  *d = in->value * floor(A); break;
+        case OP_CEIL:   *d = in->value * ceil (A); break;
+        case OP_TRUNC:  *d = in->value * trunc(A); break;
+        case OP_ROUND:  *d = in->value * round(A); break;
+        case OP_SGN:    *d = in->value * FFDIFFSIGN(A, 0); break;
+        case OP_SQRT:   *d = in->value * sqrt (A); break;
+        case OP_NOT:    *d = in->value * (A == 0); break;
+        case OP_MOD:    *d = in->value * (A - floor((!CONFIG_FTRAPV || B) ? A / B : A * INFINITY) * B); break;
+        case OP_GCD:    *d = in->value * av_gcd(A, B); break;
+        case OP_MAX:    *d = in->value * (A >  B ?   A : B); break;
+        case OP_MIN:    *d = in->value * (A <  B ?   A : B); break;
+        case OP_EQ:     *d = in->value * (A == B ? 1.0 : 0.0); break;
+        case OP_GT:     *d = in->value * (A >  B ? 1.0 : 0.0); break;
+        case OP_GTE:    *d = in->value * (A >= B ? 1.0 : 0.0); break;
+        case OP_LT:     *d = in->value * (A <  B ? 1.0 : 0.0); break;
+        case OP_LTE:    *d = in->value * (A <= B ? 1.0 : 0.0); break;
+        case OP_POW:    *d = in->value * pow(A, B); break;
+        case OP_MUL:    *d = in->value * (A * B); break;
+        case OP_DIV:    *d = in->value * ((!CONFIG_FTRAPV || B) ? (A / B) : A * INFINITY); break;
+        case OP_ADD:    *d = in->value * (A + B); break;
+        case OP_LAST:   *d = in->value * B; break;
+        case OP_HYPOT:  *d = in->value * hypot(A, B); break;
+        case OP_ATAN2:  *d = in->value * atan2(A, B); break;
+        case OP_BITAND: *d = isnan(A) || isnan(B) ? NAN : in->value * ((long int)A & (long int)B); break;
+        case OP_BITOR:  *d = isnan(A) || isnan(B) ? NAN : in->value * ((long int)A | (long int)B); break;
+        case OP_CLIP:
+            *d = isnan(B) || isnan(C) || isnan(A) || B > C ? NAN :
+                 in->value * av_clipd(A, B, C);
+            break;
+        case OP_BETWEEN: *d = in->value * (A >= B && A <= C); break;
+        case OP_LERP:   *d = A + (B - A) * C; break;
+        case OP_SELECT: *d = in->value * (A ? B : C); break;
+        case OP_SCALE:  *d = in->value * A; break;
+        case OP_JZ:
+            if (!A) {
+                in = prog->insn + in->index;
+                continue;
+            }
+            break;
+        case OP_JNZ:
+            if (A) {
+                in = prog->insn + in->index;
+                continue;
+            }
+            break;
+        case OP_JMP:
+            in = prog->insn + in->index;
+            continue;
+        }
+#undef A
+#undef B
+#undef C
+        in++;
+    }
+
+    return r[0];
+}
+
+/* Run a program without jumps and state on nb <= ROW_BLOCK values at once,
+ * the constants with an entry in const_rows are read from there starting
+ * at offset. */
+static void run_program_row(const ExprProgram *prog, Parser *p, double *res,
+                            int nb, int offset, const double * const *const_rows)
+{
+    const ExprInsn *in = prog->insn, *end = in + prog->nb_insn;
+    double r[MAX_REGS][ROW_BLOCK];
+    int k;
+
+    for (; in < end; in++) {
+        double *d = r[in->dst];
+        const double *a = r[in->src[0]];
+        const double *b = in->src[1] < MAX_REGS ? r[in->src[1]] : NULL;
+        const double *c = in->src[2] < MAX_REGS ? r[in->src[2]] : NULL;
+        const double v = in->value;
+#define LOOP(x) for (k = 0; k < nb; k++) d[k] = (x); break
+        switch (in->op) {
+        case OP_VALUE:  LOOP(v);
+        case OP_CONST:
+            if (const_rows && const_rows[in->index]) {
+                const double *row = const_rows[in->index] + offset;
+                LOOP(v * row[k]);
+            } else {
+                const double cv = v * p->const_values[in->index];
+                LOOP(cv);
+            }
+        case OP_FUNC0:  LOOP(v * in->a.func0(a[k]));
+        case OP_FUNC1:  LOOP(v * in->a.func1(p->opaque, a[k]));
+        case OP_FUNC2:  LOOP(v * in->a.func2(p->opaque, a[k], b[k]));
+        case OP_SQUISH: LOOP(1/(1+exp(4*a[k])));
+        case OP_GAUSS:  LOOP(exp(-a[k]*a[k]/2)/sqrt(2*M_PI));
+        case OP_ISNAN:  LOOP(v * !!isnan(a[k]));
+        case OP_ISINF:  LOOP(v * !!isinf(a[k]));
+        case OP_FLOOR:  LOOP(v * floor(a[k]));
+        case OP_CEIL:   LOOP(v * ceil (a[k]));
+        case OP_TRUNC:  LOOP(v * trunc(a[k]));
+        case OP_ROUND:  LOOP(v * round(a[k]));
+        case OP_SGN:    LOOP(v * FFDIFFSIGN(a[k], 0));
+        case OP_SQRT:   LOOP(v * sqrt (a[k]));
+        case OP_NOT:    LOOP(v * (a[k] == 0));
+        case OP_MOD:    LOOP(v * (a[k] - floor((!CONFIG_FTRAPV || b[k]) ? a[k] / b[k] : a[k] * INFINITY) * b[k]));
+        case OP_GCD:    LOOP(v * av_gcd(a[k], b[k]));
+        case OP_MAX:    LOOP(v * (a[k] >  b[k] ? a[k] : b[k]));
+        case OP_MIN:    LOOP(v * (a[k] <  b[k] ? a[k] : b[k]));
+        case OP_EQ:     LOOP(v * (a[k] == b[k] ? 1.0 : 0.0));
+        case OP_GT:     LOOP(v * (a[k] >  b[k] ? 1.0 : 0.0));
+        case OP_GTE:    LOOP(v * (a[k] >= b[k] ? 1.0 : 0.0));
+        case OP_LT:     LOOP(v * (a[k] <  b[k] ? 1.0 : 0.0));
+        case OP_LTE:    LOOP(v * (a[k] <= b[k] ? 1.0 : 0.0));
+        case OP_POW:    LOOP(v * pow(a[k], b[k]));
+        case OP_MUL:    LOOP(v * (a[k] * b[k]));
+        case OP_DIV:    LOOP(v * ((!CONFIG_FTRAPV || b[k]) ? (a[k] / b[k]) : a[k] * INFINITY));
+        case OP_ADD:    LOOP(v * (a[k] + b[k]));
+        case OP_LAST:   LOOP(v * b[k]);
+        case OP_HYPOT:  LOOP(v * hypot(a[k], b[k]));
+        case OP_ATAN2:  LOOP(v * atan2(a[k], b[k]));
+        case OP_BITAND: LOOP(isnan(a[k]) || isnan(b[k]) ? NAN : v * ((long int)a[k] & (long int)b[k]));
+        case OP_BITOR:  LOOP(isnan(a[k]) || isnan(b[k]) ? NAN : v * ((long int)a[k] | (long int)b[k]));
+        case OP_CLIP:
+            LOOP(isnan(b[k]) || isnan(c[k]) || isnan(a[k]) || b[k] > c[k] ? NAN :
+                 v * av_clipd(a[k], b[k], c[k]));
+        case OP_BETWEEN: LOOP(v * (a[k] >= b[k] && a[k] <= c[k]));
+        case OP_LERP:   LOOP(a[k] + (b[k] - a[k]) * c[k]);
+        case OP_SELECT: LOOP(v * (a[k] ? b[k] : c[k]));
+        case OP_SCALE:  LOOP(v * a[k]);
+        default:        av_assert0(0);
+        }
+#undef LOOP
+    }
+
+    memcpy(res, r[0], nb * sizeof(*res));
+}
+
 int av_expr_parse(AVExpr **expr, const char *s,
                   const char * const *const_names,
                   const char * const *func1_names, double (* const *funcs1)(void *, double),
@@ -724,11 +1208,14 @@ int av_expr_parse(AVExpr **expr, const char *s,
         ret = AVERROR(EINVAL);
         goto end;
     }
+    fold_constants(e);
     e->var= av_mallocz(sizeof(double) *VARS);
     if (!e->var) {
         ret = AVERROR(ENOMEM);
         goto end;
     }
+    if ((ret = compile_program(e, &e->prog)) < 0)
+        goto end;
     *expr = e;
     e = NULL;
 end:
@@ -770,7 +1257,34 @@ double av_expr_eval(AVExpr *e, const double *const_values, void *opaque)
 
     p.const_values = const_values;
     p.opaque     = opaque;
-    return eval_expr(&p, e);
+    return e->prog ? run_program(e->prog, &p) : eval_expr(&p, e);
+}
+
+int av_expr_eval_row(AVExpr *e, double *res, int nb,
+                     const double *const_values, const double * const *const_rows,
+                     void *opaque)
+{
+    Parser p = { 0 };
+    int i;
+
+    p.var          = e->var;
+    p.const_values = const_values;
+    p.opaque       = opaque;
+
+    if (e->prog && !e->prog->scalar_only) {
+        for (i = 0; i < nb; i += ROW_BLOCK)
+            run_program_row(e->prog, &p, res + i, FFMIN(nb - i, ROW_BLOCK),
+                            i, const_rows);
+        return 0;
+    }
+
+    p.const_rows = const_rows;
+    for (i = 0; i < nb; i++) {
+        p.row_index = i;
+        res[i] = e->prog ? run_program(e->prog, &p) : eval_expr(&p, e);
+    }
+
+    return 0;
 }
 
 int av_expr_parse_and_eval(double *d, const char *s,
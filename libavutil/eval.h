@@ -86,6 +86,29 @@ int av_expr_parse(AVExpr **expr, const char *s,
  */
 double av_expr_eval(AVExpr *e, const double *const_values, void *opaque);
 
+/**
+ * Evaluate a previously parsed expression nb times, for example once for
+ * every pixel of a row. This is considerably faster than calling
+ * av_expr_eval() in a loop for expressions which do not use the variables
+ * of st(), ld() and similar functions. Other expressions are evaluated one
+ * value after the other.
+ *
+ * The functions passed to av_expr_parse() may be called in any order, so
+ * they should only depend on their arguments.
+ *
+ * @param res array where the nb results are stored
+ * @param const_values array of values for the identifiers from
+ *                     av_expr_parse() const_names
+ * @param const_rows NULL, or an array with an entry for each identifier
+ *                   from const_names: if not NULL, it points to nb values
+ *                   which replace the one in const_values for each result
+ * @param opaque a pointer which will be passed to all functions from funcs1 and funcs2
+ * @return 0 on success, a negative AVERROR code on failure
+ */
+int av_expr_eval_row(AVExpr *e, double *res, int nb,
+                     const double *const_values, const double * const *const_rows,
+                     void *opaque);
+
 /**
  * Track the presence of variables and their number of occurrences in a parsed expression
  *
@@ -19,6 +19,7 @@
 #include "channel_layout.h"
 #include "avassert.h"
 #include "buffer.h"
+#include "buffer_internal.h"
 #include "common.h"
 #include "dict.h"
 #include "frame.h"
@@ -27,6 +28,9 @@
 #include "samplefmt.h"
 #include "hwcontext.h"
 
+static FFObjectCache frame_cache     = FF_OBJECT_CACHE_INITIALIZER(AVFrame);
+static FFObjectCache side_data_cache = FF_OBJECT_CACHE_INITIALIZER(AVFrameSideData);
+
 #if FF_API_FRAME_GET_SET
 MAKE_ACCESSORS(AVFrame, frame, int64_t, best_effort_timestamp)
 MAKE_ACCESSORS(AVFrame, frame, int64_t, pkt_duration)
@@ -172,7 +176,7 @@ static void free_side_data(AVFrameSideData **ptr_sd)
 
     av_buffer_unref(&sd->buf);
     av_dict_free(&sd->metadata);
-    av_freep(ptr_sd);
+    ff_object_cache_freep(&side_data_cache, ptr_sd);
 }
 
 static void wipe_side_data(AVFrame *frame)
@@ -189,7 +193,7 @@ static void wipe_side_data(AVFrame *frame)
 
 AVFrame *av_frame_alloc(void)
 {
-    AVFrame *frame = av_mallocz(sizeof(*frame));
+    AVFrame *frame = ff_object_cache_alloc(&frame_cache);
 
     if (!frame)
         return NULL;
@@ -206,7 +210,7 @@ void av_frame_free(AVFrame **frame)
         return;
 
     av_frame_unref(*frame);
-    av_freep(frame);
+    ff_object_cache_freep(&frame_cache, frame);
 }
 
 static int get_video_buffer(AVFrame *frame, int align)
@@ -710,7 +714,7 @@ AVFrameSideData *av_frame_new_side_data_from_buf(AVFrame *frame,
         return NULL;
     frame->side_data = tmp;
 
-    ret = av_mallocz(sizeof(*ret));
+    ret = ff_object_cache_alloc(&side_data_cache);
     if (!ret)
         return NULL;
 
@@ -31,6 +31,7 @@
 #include "mathematics.h"
 #include "pixdesc.h"
 #include "rational.h"
+#include "slicethread.h"
 
 void av_image_fill_max_pixsteps(int max_pixsteps[4], int max_pixstep_comps[4],
                                 const AVPixFmtDescriptor *pixdesc)
@@ -305,19 +306,104 @@ int av_image_check_sar(unsigned int w, unsigned int h, AVRational sar)
     return AVERROR(EINVAL);
 }
 
+/* Planes of at least this size are written with non-temporal stores where
+ * supported. They would evict most of the cache anyway, and the consumer of
+ * a copy this large rarely reads it back right away. */
+#define COPY_NT_MIN_SIZE     (16 << 20)
+/* Planes of at least this size are split into bands of at least
+ * COPY_SLICE_MIN_SIZE bytes and copied on the process-wide thread pool,
+ * if the application started one. */
+#define COPY_THREAD_MIN_SIZE (4 << 20)
+#define COPY_SLICE_MIN_SIZE  (1 << 20)
+
+typedef struct CopyPlaneThread {
+    uint8_t       *dst;
+    const uint8_t *src;
+    ptrdiff_t      dst_linesize, src_linesize;
+    ptrdiff_t      bytewidth;
+    int            height;
+    int            nt;
+} CopyPlaneThread;
+
+static void copy_plane_rows(uint8_t       *dst, ptrdiff_t dst_linesize,
+                            const uint8_t *src, ptrdiff_t src_linesize,
+                            ptrdiff_t bytewidth, int height, int nt)
+{
+    /* rows without padding in between are copied as a single row */
+    if (dst_linesize == src_linesize && FFABS(dst_linesize) == bytewidth) {
+        if (dst_linesize < 0) {
+            dst += (height - 1) * dst_linesize;
+            src += (height - 1) * src_linesize;
+        }
+        bytewidth *= height;
+        height     = 1;
+    }
+
+#if ARCH_X86
+    if (nt && ff_image_copy_plane_nt_x86(dst, dst_linesize, src, src_linesize,
+                                         bytewidth, height) >= 0)
+        return;
+#endif
+
+    for (;height > 0; height--) {
+        memcpy(dst, src, bytewidth);
+        dst += dst_linesize;
+        src += src_linesize;
+    }
+}
+
+static void copy_plane_worker(void *priv, int jobnr, int threadnr,
+                              int nb_jobs, int nb_threads)
+{
+    CopyPlaneThread *t = priv;
+    int start = (int64_t)t->height *  jobnr      / nb_jobs;
+    int end   = (int64_t)t->height * (jobnr + 1) / nb_jobs;
+
+    copy_plane_rows(t->dst + start * t->dst_linesize, t->dst_linesize,
+                    t->src + start * t->src_linesize, t->src_linesize,
+                    t->bytewidth, end - start, t->nt);
+}
+
 static void image_copy_plane(uint8_t       *dst, ptrdiff_t dst_linesize,
                              const uint8_t *src, ptrdiff_t src_linesize,
                              ptrdiff_t bytewidth, int height)
 {
+    int64_t size;
+    int nt;
+
     if (!dst || !src)
         return;
     av_assert0(FFABS(src_linesize) >= bytewidth);
     av_assert0(FFABS(dst_linesize) >= bytewidth);
-    for (;height > 0; height--) {
-        memcpy(dst, src, bytewidth);
-        dst += dst_linesize;
-        src += src_linesize;
+    if (height <= 0)
+        return;
+
+    size = (int64_t)bytewidth * height;
+    nt   = size >= COPY_NT_MIN_SIZE;
+
+    if (size >= COPY_THREAD_MIN_SIZE && height > 1) {
+        CopyPlaneThread t = {
+            .dst          = dst,
+            .src          = src,
+            .dst_linesize = dst_linesize,
+            .src_linesize = src_linesize,
+            .bytewidth    = bytewidth,
+            .height       = height,
+            .nt           = nt,
+        };
+        AVSliceThread *thread;
+        int nb_threads = avpriv_slicethread_create_pooled(&thread, &t,
+                                                          copy_plane_worker,
+                                                          NULL, 0);
+        if (nb_threads > 0) {
+            int nb_jobs = FFMIN3(nb_threads, height, size / COPY_SLICE_MIN_SIZE);
+            avpriv_slicethread_execute(thread, nb_jobs, 0);
+            avpriv_slicethread_free(&thread);
+            return;
+        }
     }
+
+    copy_plane_rows(dst, dst_linesize, src, src_linesize, bytewidth, height, nt);
 }
 
 static void image_copy_plane_uc_from(uint8_t       *dst, ptrdiff_t dst_linesize,
@@ -26,5 +26,14 @@ int ff_image_copy_plane_uc_from_x86(uint8_t       *dst, ptrdiff_t dst_linesize,
                                     const uint8_t *src, ptrdiff_t src_linesize,
                                     ptrdiff_t bytewidth, int height);
 
+/**
+ * Copy a plane with non-temporal stores, bypassing the cache.
+ * @return 0 on success, AVERROR(ENOSYS) if the plane layout or the CPU
+ *         is not supported
+ */
+int ff_image_copy_plane_nt_x86(uint8_t       *dst, ptrdiff_t dst_linesize,
+                               const uint8_t *src, ptrdiff_t src_linesize,
+                               ptrdiff_t bytewidth, int height);
+
 
 #endif /* AVUTIL_IMGUTILS_INTERNAL_H */
@@ -33,13 +33,16 @@
 #include <io.h>
 #endif
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdlib.h>
+#include "avstring.h"
 #include "avutil.h"
 #include "bprint.h"
 #include "common.h"
 #include "internal.h"
 #include "log.h"
 #include "thread.h"
+#include "time.h"
 
 static AVMutex mutex = AV_MUTEX_INITIALIZER;
 
@@ -343,28 +346,16 @@ int av_log_format_line2(void *ptr, int level, const char *fmt, va_list vl,
     return ret;
 }
 
-void av_log_default_callback(void* ptr, int level, const char* fmt, va_list vl)
+/**
+ * Print a formatted line to stderr, with repeat detection.
+ * Must be called with the mutex held.
+ */
+static void print_line(int level, unsigned tint, const int type[2],
+                       int print_prefix, char *part[4], const char *line)
 {
-    static int print_prefix = 1;
     static int count;
     static char prev[LINE_SZ];
-    AVBPrint part[4];
-    char line[LINE_SZ];
     static int is_atty;
-    int type[2];
-    unsigned tint = 0;
-
-    if (level >= 0) {
-        tint = level & 0xff00;
-        level &= 0xff;
-    }
-
-    if (level > av_log_level)
-        return;
-    ff_mutex_lock(&mutex);
-
-    format_line(ptr, level, fmt, vl, part, &print_prefix, type);
-    snprintf(line, sizeof(line), "%s%s%s%s", part[0].str, part[1].str, part[2].str, part[3].str);
 
 #if HAVE_ISATTY
     if (!is_atty)
@@ -376,27 +367,51 @@ void av_log_default_callback(void* ptr, int level, const char* fmt, va_list vl)
         count++;
         if (is_atty == 1)
             fprintf(stderr, "    Last message repeated %d times\r", count);
-        goto end;
+        return;
     }
     if (count > 0) {
         fprintf(stderr, "    Last message repeated %d times\n", count);
         count = 0;
     }
     strcpy(prev, line);
-    sanitize(part[0].str);
-    colored_fputs(type[0], 0, part[0].str);
-    sanitize(part[1].str);
-    colored_fputs(type[1], 0, part[1].str);
-    sanitize(part[2].str);
-    colored_fputs(av_clip(level >> 3, 0, NB_LEVELS - 1), tint >> 8, part[2].str);
-    sanitize(part[3].str);
-    colored_fputs(av_clip(level >> 3, 0, NB_LEVELS - 1), tint >> 8, part[3].str);
+    sanitize(part[0]);
+    colored_fputs(type[0], 0, part[0]);
+    sanitize(part[1]);
+    colored_fputs(type[1], 0, part[1]);
+    sanitize(part[2]);
+    colored_fputs(av_clip(level >> 3, 0, NB_LEVELS - 1), tint >> 8, part[2]);
+    sanitize(part[3]);
+    colored_fputs(av_clip(level >> 3, 0, NB_LEVELS - 1), tint >> 8, part[3]);
 
 #if CONFIG_VALGRIND_BACKTRACE
     if (level <= BACKTRACE_LOGLEVEL)
         VALGRIND_PRINTF_BACKTRACE("%s", "");
 #endif
-end:
+}
+
+void av_log_default_callback(void* ptr, int level, const char* fmt, va_list vl)
+{
+    static int print_prefix = 1;
+    AVBPrint part[4];
+    char line[LINE_SZ];
+    int type[2];
+    unsigned tint = 0;
+
+    if (level >= 0) {
+        tint = level & 0xff00;
+        level &= 0xff;
+    }
+
+    if (level > av_log_level)
+        return;
+    ff_mutex_lock(&mutex);
+
+    format_line(ptr, level, fmt, vl, part, &print_prefix, type);
+    snprintf(line, sizeof(line), "%s%s%s%s", part[0].str, part[1].str, part[2].str, part[3].str);
+    print_line(level, tint, type, print_prefix,
+               (char *[4]){ part[0].str, part[1].str, part[2].str, part[3].str },
+               line);
+
     av_bprint_finalize(part+3, NULL);
     ff_mutex_unlock(&mutex);
 }
@@ -457,6 +472,235 @@ void av_log_set_callback(void (*callback)(void*, int, const char*, va_list))
     av_log_callback = callback;
 }
 
+#if HAVE_THREADS
+
+#define ASYNC_RING_SIZE 256
+
+/**
+ * One formatted message in the ring. seq is the ring position the slot
+ * can next be written for; it becomes pos + 1 once the message at pos
+ * has been published and pos + ASYNC_RING_SIZE once it has been consumed.
+ */
+typedef struct AsyncLogSlot {
+    atomic_uint seq;
+    int level;
+    unsigned tint;
+    int type[2];
+    int print_prefix;
+    const char *class_name;
+    int64_t timestamp;
+    int part_end[3];
+    char line[LINE_SZ];
+} AsyncLogSlot;
+
+static struct {
+    AsyncLogSlot *slots;
+    atomic_uint write_pos;
+    unsigned read_pos;
+    atomic_int writer_waiting;
+    atomic_int stop;
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    void (*callback)(void *opaque, const AVLogRecord *record);
+    void *opaque;
+    void (*prev_callback)(void*, int, const char*, va_list);
+} async_log;
+
+static void async_log_wake(void)
+{
+    if (atomic_load(&async_log.writer_waiting)) {
+        pthread_mutex_lock(&async_log.lock);
+        pthread_cond_signal(&async_log.cond);
+        pthread_mutex_unlock(&async_log.lock);
+    }
+}
+
+static void async_log_callback(void *avcl, int level, const char *fmt, va_list vl)
+{
+    static atomic_int shared_print_prefix = ATOMIC_VAR_INIT(1);
+    AVClass *avc = avcl ? *(AVClass **) avcl : NULL;
+    AsyncLogSlot *slot;
+    AVBPrint part[4];
+    unsigned tint = 0, pos;
+    int i, len = 0, print_prefix, type[2];
+    int64_t timestamp;
+
+    if (level >= 0) {
+        tint = level & 0xff00;
+        level &= 0xff;
+    }
+
+    if (level > av_log_level)
+        return;
+
+    /* stamp the message before a full ring can delay it */
+    timestamp = av_gettime();
+
+    /* formatting happens in the calling thread, without any lock */
+    print_prefix = atomic_load_explicit(&shared_print_prefix, memory_order_relaxed);
+    format_line(avcl, level, fmt, vl, part, &print_prefix, type);
+    atomic_store_explicit(&shared_print_prefix, print_prefix, memory_order_relaxed);
+
+    pos  = atomic_fetch_add_explicit(&async_log.write_pos, 1, memory_order_relaxed);
+    slot = &async_log.slots[pos % ASYNC_RING_SIZE];
+    while (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos) {
+        /* the ring is full, give the writer time to catch up */
+        async_log_wake();
+        av_usleep(100);
+    }
+
+    slot->level        = level;
+    slot->tint         = tint;
+    slot->type[0]      = type[0];
+    slot->type[1]      = type[1];
+    slot->print_prefix = print_prefix;
+    slot->class_name   = avc ? avc->class_name : NULL;
+    slot->timestamp    = timestamp;
+    for (i = 0; i < 4; i++) {
+        len += av_strlcpy(slot->line + len, part[i].str, LINE_SZ - len);
+        len  = FFMIN(len, LINE_SZ - 1);
+        if (i < 3)
+            slot->part_end[i] = len;
+    }
+    av_bprint_finalize(part+3, NULL);
+
+    atomic_store(&slot->seq, pos + 1);
+    async_log_wake();
+}
+
+static void async_log_output(AsyncLogSlot *slot)
+{
+    if (async_log.callback) {
+        AVLogRecord record = {
+            .level      = slot->level,
+            .category   = slot->type[1] - 16,
+            .class_name = slot->class_name,
+            .timestamp  = slot->timestamp,
+            .line       = slot->line,
+            .message    = slot->line + slot->part_end[2],
+        };
+        async_log.callback(async_log.opaque, &record);
+    } else {
+        char split[LINE_SZ + 3], *part[4];
+        int i, start = 0;
+
+        /* print_line() wants the prefixes as separate strings */
+        for (i = 0; i < 4; i++) {
+            int end = i < 3 ? slot->part_end[i] : strlen(slot->line);
+            part[i] = split + start + i;
+            memcpy(part[i], slot->line + start, end - start);
+            part[i][end - start] = 0;
+            start = end;
+        }
+        ff_mutex_lock(&mutex);
+        print_line(slot->level, slot->tint, slot->type, slot->print_prefix,
+                   part, slot->line);
+        ff_mutex_unlock(&mutex);
+    }
+}
+
+static void *async_log_writer(void *arg)
+{
+    for (;;) {
+        unsigned pos = async_log.read_pos;
+        AsyncLogSlot *slot = &async_log.slots[pos % ASYNC_RING_SIZE];
+
+        if (atomic_load(&slot->seq) == pos + 1) {
+            async_log_output(slot);
+            atomic_store_explicit(&slot->seq, pos + ASYNC_RING_SIZE,
+                                  memory_order_release);
+            async_log.read_pos++;
+            continue;
+        }
+        if (atomic_load(&async_log.stop))
+            break;
+
+        /* writer_waiting is set before the slot is checked again, and
+         * producers check it after publishing, so no wakeup is lost */
+        pthread_mutex_lock(&async_log.lock);
+        atomic_store(&async_log.writer_waiting, 1);
+        while (atomic_load(&slot->seq) != pos + 1 && !atomic_load(&async_log.stop))
+            pthread_cond_wait(&async_log.cond, &async_log.lock);
+        atomic_store(&async_log.writer_waiting, 0);
+        pthread_mutex_unlock(&async_log.lock);
+    }
+    return NULL;
+}
+
+int av_log_async_start(void (*callback)(void *opaque, const AVLogRecord *record),
+                       void *opaque)
+{
+    int i, ret;
+
+    if (async_log.slots)
+        return AVERROR(EINVAL);
+
+    async_log.slots = av_malloc_array(ASYNC_RING_SIZE, sizeof(*async_log.slots));
+    if (!async_log.slots)
+        return AVERROR(ENOMEM);
+    for (i = 0; i < ASYNC_RING_SIZE; i++)
+        atomic_init(&async_log.slots[i].seq, i);
+    atomic_init(&async_log.write_pos, 0);
+    atomic_init(&async_log.writer_waiting, 0);
+    atomic_init(&async_log.stop, 0);
+    async_log.read_pos = 0;
+    async_log.callback = callback;
+    async_log.opaque   = opaque;
+
+    if ((ret = pthread_mutex_init(&async_log.lock, NULL))) {
+        av_freep(&async_log.slots);
+        return AVERROR(ret);
+    }
+    if ((ret = pthread_cond_init(&async_log.cond, NULL))) {
+        pthread_mutex_destroy(&async_log.lock);
+        av_freep(&async_log.slots);
+        return AVERROR(ret);
+    }
+    if ((ret = pthread_create(&async_log.writer, NULL, async_log_writer, NULL))) {
+        pthread_cond_destroy(&async_log.cond);
+        pthread_mutex_destroy(&async_log.lock);
+        av_freep(&async_log.slots);
+        return AVERROR(ret);
+    }
+
+    async_log.prev_callback = av_log_callback;
+    av_log_callback = async_log_callback;
+    return 0;
+}
+
+void av_log_async_stop(void)
+{
+    if (!async_log.slots)
+        return;
+
+    av_log_callback = async_log.prev_callback;
+
+    pthread_mutex_lock(&async_log.lock);
+    atomic_store(&async_log.stop, 1);
+    pthread_cond_signal(&async_log.cond);
+    pthread_mutex_unlock(&async_log.lock);
+    pthread_join(async_log.writer, NULL);
+
+    pthread_cond_destroy(&async_log.cond);
+    pthread_mutex_destroy(&async_log.lock);
+    av_freep(&async_log.slots);
+}
+
+#else
+
+int av_log_async_start(void (*callback)(void *opaque, const AVLogRecord *record),
+                       void *opaque)
+{
+    return AVERROR(ENOSYS);
+}
+
+void av_log_async_stop(void)
+{
+}
+
+#endif
+
 static void missing_feature_sample(int sample, void *avc, const char *msg,
                                    va_list argument_list)
 {
@@ -302,6 +302,49 @@ void av_log_set_level(int level);
  */
 void av_log_set_callback(void (*callback)(void*, int, const char*, va_list));
 
+/**
+ * A log message as passed to an asynchronous log callback.
+ *
+ * @see av_log_async_start
+ */
+typedef struct AVLogRecord {
+    int level;                  ///< log level, without AV_LOG_C() color
+    AVClassCategory category;   ///< category of the logging context
+    const char *class_name;     ///< AVClass.class_name of the context, or NULL
+    int64_t timestamp;          ///< av_gettime() when the message was logged
+    const char *line;           ///< the formatted line, including any prefixes
+    const char *message;        ///< the message itself, a suffix of line
+} AVLogRecord;
+
+/**
+ * Switch to asynchronous logging.
+ *
+ * Messages are formatted in the calling thread, without taking a lock, and
+ * passed through a lock-free queue to a single writer thread. The writer
+ * either prints them like av_log_default_callback() does, including
+ * repeated message detection, or passes them to callback.
+ *
+ * This replaces the callback set with av_log_set_callback() until
+ * av_log_async_stop() is called. Log messages spanning several av_log()
+ * calls may interleave with those from other threads.
+ *
+ * @param callback called from the writer thread for each message, in the
+ *                 order they were logged; if NULL, messages are printed
+ *                 to stderr. It must not call av_log() itself.
+ * @param opaque   passed to callback
+ * @return 0 on success, a negative AVERROR code on failure, notably
+ *         AVERROR(ENOSYS) if threads are not supported
+ */
+int av_log_async_start(void (*callback)(void *opaque, const AVLogRecord *record),
+                       void *opaque);
+
+/**
+ * Flush all queued messages, stop the writer thread and restore the log
+ * callback that was set before av_log_async_start(). No other thread may
+ * log while this runs.
+ */
+void av_log_async_stop(void);
+
 /**
  * Default logging callback
  *
@@ -16,14 +16,46 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include "config.h"
+
+#if HAVE_SCHED_GETAFFINITY
+#ifndef _GNU_SOURCE
+# define _GNU_SOURCE
+#endif
+#include <sched.h>
+#endif
+
 #include <stdatomic.h>
 #include "slicethread.h"
+#include "threadpool.h"
+#include "cpu.h"
+#include "error.h"
 #include "mem.h"
 #include "thread.h"
 #include "avassert.h"
 
 #if HAVE_PTHREADS || HAVE_W32THREADS || HAVE_OS2THREADS
 
+/**
+ * Process-wide pool of worker threads. Slice threading contexts created
+ * while the pool is running queue their job sets on it instead of owning
+ * threads. Idle pool threads join the oldest job set that still has
+ * unclaimed jobs and a free thread slot.
+ */
+typedef struct ThreadPool {
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    pthread_t       *threads;
+    int             nb_threads;
+    int             flags;
+    int             finished;
+    AVSliceThread   *queue;     ///< job sets waiting for pool threads
+    atomic_uint     refcount;
+} ThreadPool;
+
+static AVMutex     pool_mutex = AV_MUTEX_INITIALIZER;
+static ThreadPool *pool;
+
 typedef struct WorkerContext {
     AVSliceThread   *ctx;
     pthread_mutex_t mutex;
@@ -48,6 +80,13 @@ struct AVSliceThread {
     void            *priv;
     void            (*worker_func)(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads);
     void            (*main_func)(void *priv);
+
+    /* only used when the jobs run on the shared pool */
+    ThreadPool      *pool;
+    AVSliceThread   *next;             ///< next job set in pool->queue
+    int             nb_slots;          ///< thread numbers handed out, under pool->mutex
+    atomic_uint     nb_jobs_done;
+    atomic_uint     nb_participants;   ///< pool threads working on this job set
 };
 
 static int run_jobs(AVSliceThread *ctx)
@@ -91,15 +130,312 @@ static void *attribute_align_arg thread_worker(void *v)
     }
 }
 
+static void pool_unref(ThreadPool *p)
+{
+    int i;
+
+    if (atomic_fetch_sub_explicit(&p->refcount, 1, memory_order_acq_rel) != 1)
+        return;
+
+    pthread_mutex_lock(&p->mutex);
+    p->finished = 1;
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->mutex);
+
+    for (i = 0; i < p->nb_threads; i++)
+        pthread_join(p->threads[i], NULL);
+
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->mutex);
+    av_freep(&p->threads);
+    av_free(p);
+}
+
+/* must be called with pool->mutex locked */
+static void pool_dequeue(ThreadPool *p, AVSliceThread *ctx)
+{
+    AVSliceThread **q;
+
+    for (q = &p->queue; *q; q = &(*q)->next) {
+        if (*q == ctx) {
+            *q = ctx->next;
+            ctx->next = NULL;
+            return;
+        }
+    }
+}
+
+static void pool_signal_done(AVSliceThread *ctx)
+{
+    pthread_mutex_lock(&ctx->done_mutex);
+    pthread_cond_signal(&ctx->done_cond);
+    pthread_mutex_unlock(&ctx->done_mutex);
+}
+
+static void pool_run_jobs(AVSliceThread *ctx, int threadnr)
+{
+    unsigned nb_jobs = ctx->nb_jobs;
+    unsigned jobnr;
+
+    while ((jobnr = atomic_fetch_add_explicit(&ctx->current_job, 1, memory_order_acq_rel)) < nb_jobs) {
+        ctx->worker_func(ctx->priv, jobnr, threadnr, nb_jobs, ctx->nb_active_threads);
+        if (atomic_fetch_add_explicit(&ctx->nb_jobs_done, 1, memory_order_acq_rel) == nb_jobs - 1)
+            pool_signal_done(ctx);
+    }
+}
+
+static void pool_set_affinity(ThreadPool *p, int idx)
+{
+#if HAVE_SCHED_GETAFFINITY && defined(CPU_COUNT)
+    cpu_set_t allowed, cpuset;
+    int i, n;
+
+    if (!(p->flags & AV_THREAD_POOL_FLAG_AFFINITY) ||
+        sched_getaffinity(0, sizeof(allowed), &allowed))
+        return;
+
+    n = idx % CPU_COUNT(&allowed);
+    for (i = 0; i < CPU_SETSIZE; i++) {
+        if (CPU_ISSET(i, &allowed) && !n--) {
+            CPU_ZERO(&cpuset);
+            CPU_SET(i, &cpuset);
+            sched_setaffinity(0, sizeof(cpuset), &cpuset);
+            return;
+        }
+    }
+#endif
+}
+
+typedef struct PoolThreadArg {
+    ThreadPool *pool;
+    int         idx;
+} PoolThreadArg;
+
+static void *attribute_align_arg pool_worker(void *v)
+{
+    ThreadPool *p = ((PoolThreadArg *)v)->pool;
+
+    pool_set_affinity(p, ((PoolThreadArg *)v)->idx);
+    av_free(v);
+
+    pthread_mutex_lock(&p->mutex);
+    while (1) {
+        AVSliceThread *ctx;
+        int threadnr;
+
+        while (!p->finished && !p->queue)
+            pthread_cond_wait(&p->cond, &p->mutex);
+        if (p->finished)
+            break;
+
+        ctx = p->queue;
+        if (atomic_load_explicit(&ctx->current_job, memory_order_acquire) >= ctx->nb_jobs) {
+            /* nothing left to claim, the owner waits for the running jobs */
+            pool_dequeue(p, ctx);
+            continue;
+        }
+
+        threadnr = ctx->nb_slots++;
+        if (ctx->nb_slots == ctx->nb_active_threads)
+            pool_dequeue(p, ctx);
+        atomic_fetch_add_explicit(&ctx->nb_participants, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&p->mutex);
+
+        pool_run_jobs(ctx, threadnr);
+
+        /* ctx may be freed by its owner as soon as this reaches zero */
+        pthread_mutex_lock(&ctx->done_mutex);
+        atomic_fetch_sub_explicit(&ctx->nb_participants, 1, memory_order_acq_rel);
+        pthread_cond_signal(&ctx->done_cond);
+        pthread_mutex_unlock(&ctx->done_mutex);
+
+        pthread_mutex_lock(&p->mutex);
+    }
+    pthread_mutex_unlock(&p->mutex);
+
+    return NULL;
+}
+
+static void pool_execute(AVSliceThread *ctx, int execute_main)
+{
+    ThreadPool *p = ctx->pool;
+    int run_main = ctx->main_func && execute_main;
+
+    atomic_store_explicit(&ctx->current_job,     0, memory_order_relaxed);
+    atomic_store_explicit(&ctx->nb_jobs_done,    0, memory_order_relaxed);
+    atomic_store_explicit(&ctx->nb_participants, 0, memory_order_relaxed);
+    /* the calling thread takes thread number 0 when it runs jobs itself */
+    ctx->nb_slots = !run_main;
+
+    if (ctx->nb_active_threads > ctx->nb_slots) {
+        AVSliceThread **q;
+
+        pthread_mutex_lock(&p->mutex);
+        for (q = &p->queue; *q; q = &(*q)->next);
+        *q = ctx;
+        pthread_cond_broadcast(&p->cond);
+        pthread_mutex_unlock(&p->mutex);
+    }
+
+    if (run_main)
+        ctx->main_func(ctx->priv);
+    else
+        pool_run_jobs(ctx, 0);
+
+    pthread_mutex_lock(&ctx->done_mutex);
+    while (atomic_load_explicit(&ctx->nb_jobs_done, memory_order_acquire) < ctx->nb_jobs)
+        pthread_cond_wait(&ctx->done_cond, &ctx->done_mutex);
+    pthread_mutex_unlock(&ctx->done_mutex);
+
+    pthread_mutex_lock(&p->mutex);
+    pool_dequeue(p, ctx);
+    pthread_mutex_unlock(&p->mutex);
+
+    pthread_mutex_lock(&ctx->done_mutex);
+    while (atomic_load_explicit(&ctx->nb_participants, memory_order_acquire))
+        pthread_cond_wait(&ctx->done_cond, &ctx->done_mutex);
+    pthread_mutex_unlock(&ctx->done_mutex);
+}
+
+int av_thread_pool_init(int nb_threads, int flags)
+{
+    ThreadPool *p;
+    int i, ret = 0;
+
+    if (nb_threads < 0)
+        return AVERROR(EINVAL);
+    if (!nb_threads)
+        nb_threads = av_cpu_count();
+
+    ff_mutex_lock(&pool_mutex);
+    if (pool) {
+        ret = AVERROR(EEXIST);
+        goto end;
+    }
+
+    p = av_mallocz(sizeof(*p));
+    if (!p || !(p->threads = av_calloc(nb_threads, sizeof(*p->threads)))) {
+        av_free(p);
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+    p->flags = flags;
+    atomic_init(&p->refcount, 1);
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->cond, NULL);
+
+    for (i = 0; i < nb_threads; i++) {
+        PoolThreadArg *arg = av_malloc(sizeof(*arg));
+
+        if (!arg) {
+            ret = AVERROR(ENOMEM);
+            break;
+        }
+        arg->pool = p;
+        arg->idx  = i;
+        if ((ret = pthread_create(&p->threads[i], NULL, pool_worker, arg))) {
+            av_free(arg);
+            ret = AVERROR(ret);
+            break;
+        }
+        p->nb_threads++;
+    }
+
+    if (ret < 0)
+        pool_unref(p);
+    else
+        pool = p;
+end:
+    ff_mutex_unlock(&pool_mutex);
+    return ret;
+}
+
+void av_thread_pool_uninit(void)
+{
+    ThreadPool *p;
+
+    ff_mutex_lock(&pool_mutex);
+    p    = pool;
+    pool = NULL;
+    ff_mutex_unlock(&pool_mutex);
+
+    if (p)
+        pool_unref(p);
+}
+
+/* takes over the caller's reference to p */
+static int pool_context_create(AVSliceThread **pctx, ThreadPool *p, void *priv,
+                               void (*worker_func)(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads),
+                               void (*main_func)(void *priv),
+                               int nb_threads)
+{
+    AVSliceThread *ctx;
+
+    *pctx = ctx = av_mallocz(sizeof(*ctx));
+    if (!ctx) {
+        pool_unref(p);
+        return AVERROR(ENOMEM);
+    }
+    ctx->pool        = p;
+    ctx->priv        = priv;
+    ctx->worker_func = worker_func;
+    ctx->main_func   = main_func;
+    /* the calling thread takes part in running the jobs */
+    ctx->nb_threads  = nb_threads ? nb_threads : p->nb_threads + 1;
+    atomic_init(&ctx->first_job, 0);
+    atomic_init(&ctx->current_job, 0);
+    atomic_init(&ctx->nb_jobs_done, 0);
+    atomic_init(&ctx->nb_participants, 0);
+    pthread_mutex_init(&ctx->done_mutex, NULL);
+    pthread_cond_init(&ctx->done_cond, NULL);
+    return ctx->nb_threads;
+}
+
+static ThreadPool *pool_ref(void)
+{
+    ThreadPool *p;
+
+    ff_mutex_lock(&pool_mutex);
+    p = pool;
+    if (p)
+        atomic_fetch_add_explicit(&p->refcount, 1, memory_order_relaxed);
+    ff_mutex_unlock(&pool_mutex);
+
+    return p;
+}
+
+int avpriv_slicethread_create_pooled(AVSliceThread **pctx, void *priv,
+                                     void (*worker_func)(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads),
+                                     void (*main_func)(void *priv),
+                                     int nb_threads)
+{
+    ThreadPool *p;
+
+    av_assert0(nb_threads >= 0);
+
+    p = pool_ref();
+    if (!p) {
+        *pctx = NULL;
+        return AVERROR(ENOSYS);
+    }
+    return pool_context_create(pctx, p, priv, worker_func, main_func, nb_threads);
+}
+
 int avpriv_slicethread_create(AVSliceThread **pctx, void *priv,
                               void (*worker_func)(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads),
                               void (*main_func)(void *priv),
                               int nb_threads)
 {
     AVSliceThread *ctx;
+    ThreadPool *p;
     int nb_workers, i;
 
     av_assert0(nb_threads >= 0);
+
+    p = pool_ref();
+    if (p)
+        return pool_context_create(pctx, p, priv, worker_func, main_func, nb_threads);
+
     if (!nb_threads) {
         int nb_cpus = av_cpu_count();
         if (nb_cpus > 1)
@@ -168,6 +504,10 @@ void avpriv_slicethread_execute(AVSliceThread *ctx, int nb_jobs, int execute_mai
     av_assert0(nb_jobs > 0);
     ctx->nb_jobs           = nb_jobs;
     ctx->nb_active_threads = FFMIN(nb_jobs, ctx->nb_threads);
+    if (ctx->pool) {
+        pool_execute(ctx, execute_main);
+        return;
+    }
     atomic_store_explicit(&ctx->first_job, 0, memory_order_relaxed);
     atomic_store_explicit(&ctx->current_job, ctx->nb_active_threads, memory_order_relaxed);
     nb_workers             = ctx->nb_active_threads;
@@ -205,6 +545,14 @@ void avpriv_slicethread_free(AVSliceThread **pctx)
         return;
 
     ctx = *pctx;
+    if (ctx->pool) {
+        pool_unref(ctx->pool);
+        pthread_cond_destroy(&ctx->done_cond);
+        pthread_mutex_destroy(&ctx->done_mutex);
+        av_freep(pctx);
+        return;
+    }
+
     nb_workers = ctx->nb_threads;
     if (!ctx->main_func)
         nb_workers--;
@@ -242,6 +590,15 @@ int avpriv_slicethread_create(AVSliceThread **pctx, void *priv,
     return AVERROR(EINVAL);
 }
 
+int avpriv_slicethread_create_pooled(AVSliceThread **pctx, void *priv,
+                                     void (*worker_func)(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads),
+                                     void (*main_func)(void *priv),
+                                     int nb_threads)
+{
+    *pctx = NULL;
+    return AVERROR(ENOSYS);
+}
+
 void avpriv_slicethread_execute(AVSliceThread *ctx, int nb_jobs, int execute_main)
 {
     av_assert0(0);
@@ -252,4 +609,13 @@ void avpriv_slicethread_free(AVSliceThread **pctx)
     av_assert0(!pctx || !*pctx);
 }
 
+int av_thread_pool_init(int nb_threads, int flags)
+{
+    return AVERROR(ENOSYS);
+}
+
+void av_thread_pool_uninit(void)
+{
+}
+
 #endif /* HAVE_PTHREADS || HAVE_W32THREADS || HAVE_OS32THREADS */
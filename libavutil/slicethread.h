@@ -35,6 +35,18 @@ int avpriv_slicethread_create(AVSliceThread **pctx, void *priv,
                               void (*main_func)(void *priv),
                               int nb_threads);
 
+/**
+ * Create a slice threading context running its jobs on the process-wide
+ * thread pool. Unlike avpriv_slicethread_create(), this never starts
+ * threads, so it is cheap enough to use for a single batch of jobs.
+ * @return number of threads, AVERROR(ENOSYS) if no pool is running, or
+ *         another negative AVERROR on failure
+ */
+int avpriv_slicethread_create_pooled(AVSliceThread **pctx, void *priv,
+                                     void (*worker_func)(void *priv, int jobnr, int threadnr, int nb_jobs, int nb_threads),
+                                     void (*main_func)(void *priv),
+                                     int nb_threads);
+
 /**
  * Execute slice threading.
  * @param ctx slice threading context
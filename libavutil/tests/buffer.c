@@ -0,0 +1,76 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdio.h>
+
+#include "libavutil/buffer.h"
+#include "libavutil/common.h"
+
+static int nb_allocs;
+
+static AVBufferRef *counting_alloc(int size)
+{
+    nb_allocs++;
+    return av_buffer_alloc(size);
+}
+
+/* take n buffers from the pool at the same time and give them back,
+ * return the number of allocations this caused */
+static int get_buffers(AVBufferPool *pool, int n)
+{
+    AVBufferRef *bufs[16];
+    int i, allocs = nb_allocs;
+
+    for (i = 0; i < n; i++) {
+        bufs[i] = av_buffer_pool_get(pool);
+        if (!bufs[i])
+            return -1;
+    }
+    for (i = 0; i < n; i++)
+        av_buffer_unref(&bufs[i]);
+
+    return nb_allocs - allocs;
+}
+
+int main(void)
+{
+    AVBufferPool *pool = av_buffer_pool_init(100000, counting_alloc);
+    int ret;
+
+    if (!pool)
+        return 1;
+
+    ret = av_buffer_pool_prewarm(pool, 4);
+    printf("prewarm 4: ret %d, %d allocations\n", ret, nb_allocs);
+    printf("get 4: %d allocations\n", get_buffers(pool, 4));
+    printf("get 5: %d allocations\n", get_buffers(pool, 5));
+
+    nb_allocs = 0;
+    ret = av_buffer_pool_prewarm(pool, 3);
+    printf("prewarm 3 of 5 free: ret %d, %d allocations\n", ret, nb_allocs);
+    ret = av_buffer_pool_prewarm(pool, 8);
+    printf("prewarm 8 of 5 free: ret %d, %d allocations\n", ret, nb_allocs);
+    printf("get 8: %d allocations\n", get_buffers(pool, 8));
+
+    nb_allocs = 0;
+    ret = av_buffer_pool_prewarm(pool, 0);
+    printf("prewarm 0: ret %d, %d allocations\n", ret, nb_allocs);
+
+    av_buffer_pool_uninit(&pool);
+    return 0;
+}
@@ -19,6 +19,7 @@
  */
 
 #include "libavutil/dict.c"
+#include "libavutil/lfg.h"
 
 static void print_dict(const AVDictionary *m)
 {
@@ -28,6 +29,96 @@ static void print_dict(const AVDictionary *m)
     printf("\n");
 }
 
+/* reference lookup, the linear scan done without the hash index */
+static AVDictionaryEntry *linear_get(const AVDictionary *m, const char *key,
+                                     const AVDictionaryEntry *prev, int flags)
+{
+    AVDictionaryEntry *t = (AVDictionaryEntry *)prev;
+    while ((t = av_dict_get(m, "", t, AV_DICT_IGNORE_SUFFIX)))
+        if (flags & AV_DICT_MATCH_CASE ? !strcmp(t->key, key) : !av_strcasecmp(t->key, key))
+            return t;
+    return NULL;
+}
+
+static int check_large_dict(const AVDictionary *m, int nb_keys)
+{
+    char key[16];
+    int i, k, errors = 0;
+
+    for (i = 0; i < nb_keys; i++) {
+        for (k = 0; k < 2; k++) {
+            static const int flags[] = { 0, AV_DICT_MATCH_CASE };
+            AVDictionaryEntry *e = NULL, *ref = NULL;
+            snprintf(key, sizeof(key), k ? "Key%d" : "KEY%d", i);
+            do {
+                e   = av_dict_get(m, key, e, flags[k]);
+                ref = linear_get(m, key, ref, flags[k]);
+                if (e != ref)
+                    errors++;
+            } while (e && ref);
+        }
+    }
+    return errors;
+}
+
+static void test_large_dict(void)
+{
+    AVDictionary *dict = NULL;
+    AVLFG lfg;
+    char key[16], val[16];
+    int i, errors = 0, nb_keys = 1000;
+
+    av_lfg_init(&lfg, 0xd1c7);
+    for (i = 0; i < 20000; i++) {
+        int op = av_lfg_get(&lfg) % 8;
+        snprintf(key, sizeof(key), "Key%d", av_lfg_get(&lfg) % nb_keys);
+        snprintf(val, sizeof(val), "%d", i);
+        if (op < 4)
+            av_dict_set(&dict, key, val, 0);
+        else if (op < 6)
+            av_dict_set(&dict, key, val, AV_DICT_MULTIKEY);
+        else if (op < 7)
+            av_dict_set(&dict, key, val, AV_DICT_APPEND | AV_DICT_MATCH_CASE);
+        else
+            av_dict_set(&dict, key, NULL, 0);
+        if (!(i % 4000))
+            errors += check_large_dict(dict, nb_keys);
+    }
+    errors += check_large_dict(dict, nb_keys);
+    printf("%d entries, %d lookup mismatches\n", av_dict_count(dict), errors);
+    av_dict_free(&dict);
+}
+
+/* shrink an indexed dictionary back below the index threshold and keep
+ * using it, the index must still cover entries added afterwards */
+static void test_shrunk_dict(void)
+{
+    AVDictionary *dict = NULL;
+    AVDictionaryEntry *e;
+    char key[16];
+    int i;
+
+    for (i = 0; i <= DICT_HASH_MIN_COUNT; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        av_dict_set(&dict, key, "x", 0);
+    }
+    av_dict_set(&dict, "key0", NULL, 0);
+    av_dict_set(&dict, "key1", NULL, 0);
+    av_dict_set(&dict, "new", "1", 0);
+    e = av_dict_get(dict, "new", NULL, 0);
+    printf("new: %s\n", e ? e->value : "(null)");
+    av_dict_set(&dict, "new", "2", 0);
+    e = av_dict_get(dict, "new", NULL, 0);
+    printf("new: %s, %d entries\n", e ? e->value : "(null)", av_dict_count(dict));
+    av_dict_set(&dict, "new", NULL, 0);
+    for (i = 2; i <= DICT_HASH_MIN_COUNT; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        av_dict_set(&dict, key, NULL, 0);
+    }
+    printf("%d entries\n", av_dict_count(dict));
+    av_dict_free(&dict);
+}
+
 static void test_separators(const AVDictionary *m, const char pair, const char val)
 {
     AVDictionary *dict = NULL;
@@ -132,5 +223,11 @@ int main(void)
     printf("%s\n", e->value);
     av_dict_free(&dict);
 
+    printf("\nTesting a large dictionary\n");
+    test_large_dict();
+
+    printf("\nTesting a dictionary shrunk below the index threshold\n");
+    test_shrunk_dict();
+
     return 0;
 }
@@ -23,6 +23,7 @@
 #include <string.h>
 
 #include "libavutil/libm.h"
+#include "libavutil/error.h"
 #include "libavutil/eval.h"
 
 static const double const_values[] = {
@@ -37,6 +38,57 @@ static const char *const const_names[] = {
     0
 };
 
+static const char *const row_const_names[] = {
+    "X",
+    "Y",
+    0
+};
+
+static double row_func2(void *opaque, double x, double y)
+{
+    return x * 0.5 + y;
+}
+
+static double (* const row_funcs2[])(void *, double, double) = { row_func2, NULL };
+static const char *const row_func2_names[] = { "f", NULL };
+
+#define ROW_SIZE 100
+
+/* compare av_expr_eval_row() with av_expr_eval() called for every X, on
+ * separate instances as expressions can store state in their variables */
+static int test_row(const char *s, double y)
+{
+    double values[2] = { 0, y };
+    double xs[ROW_SIZE], res[ROW_SIZE];
+    const double *rows[2] = { xs, NULL };
+    AVExpr *e = NULL, *e_row = NULL;
+    int i, ret;
+
+    ret = av_expr_parse(&e, s, row_const_names, NULL, NULL,
+                        row_func2_names, row_funcs2, 0, NULL);
+    if (ret >= 0)
+        ret = av_expr_parse(&e_row, s, row_const_names, NULL, NULL,
+                            row_func2_names, row_funcs2, 0, NULL);
+
+    for (i = 0; i < ROW_SIZE; i++)
+        xs[i] = i - 10;
+    if (ret >= 0)
+        ret = av_expr_eval_row(e_row, res, ROW_SIZE, values, rows, NULL);
+
+    for (i = 0; i < ROW_SIZE && ret >= 0; i++) {
+        double d;
+        values[0] = xs[i];
+        d = av_expr_eval(e, values, NULL);
+        if (memcmp(&d, &res[i], sizeof(d)) && !(isnan(d) && isnan(res[i]))) {
+            printf("'%s' X=%f: %f != %f\n", s, xs[i], res[i], d);
+            ret = AVERROR_BUG;
+        }
+    }
+    av_expr_free(e);
+    av_expr_free(e_row);
+    return ret;
+}
+
 int main(int argc, char **argv)
 {
     int i;
@@ -140,6 +192,25 @@ int main(int argc, char **argv)
         "clip(0, 0/0, 1)",
         NULL
     };
+    static const char *const row_exprs[] = {
+        "X",
+        "-X*Y+1",
+        "X/Y-mod(X,3)+X^2",
+        "(X+2*3)*Y-sin(PI/4)",
+        "if(gt(X,0), sqrt(X), -X)",
+        "ifnot(lt(X,5), X*Y)",
+        "if(X, f(X,Y), f(Y,X))",
+        "clip(X, -3, 40)+between(X, 0, 2)+sgn(X)+not(X)",
+        "gauss(X/10)+squish(X/100)+lerp(X, Y, 0.25)",
+        "bitand(X, 6)+bitor(X, 1)+hypot(X, Y)+atan2(X, Y)",
+        "floor(X/3)+ceil(X/3)+trunc(X/3)+round(X/3)+min(X,Y)+max(X,Y)",
+        "eq(X,Y)+gte(X,Y)+lte(X,Y)+isnan(sqrt(X))+isinf(1/X)",
+        "st(0, ld(0)+X); ld(0)",
+        "7*random(1)+X",
+        "((((((((((((((((((((((((((X+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)+1)*2)",
+        "1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+(1+X)))))))))))))))))))))))))))",
+        NULL
+    };
     int ret;
 
     for (expr = exprs; *expr; expr++) {
@@ -168,6 +239,11 @@ int main(int argc, char **argv)
     if (ret < 0)
         printf("av_expr_parse_and_eval failed\n");
 
+    for (expr = row_exprs; *expr; expr++) {
+        ret = test_row(*expr, 3);
+        printf("row '%s': %s\n", *expr, ret < 0 ? "failed" : "ok");
+    }
+
     if (argc > 1 && !strcmp(argv[1], "-t")) {
         for (i = 0; i < 1050; i++) {
             START_TIMER;
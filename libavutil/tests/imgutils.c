@@ -16,13 +16,190 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include "config.h"
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 #include "libavutil/imgutils.c"
+#include "libavutil/lfg.h"
+#include "libavutil/mem.h"
+#include "libavutil/threadpool.h"
+#include "libavutil/time.h"
 
 #undef printf
 
-int main(void)
+#if !HAVE_GETOPT
+#include "compat/getopt.c"
+#endif
+
+#define PAD 64
+
+/* copy a plane with the given layout and check that the bytes around the
+ * destination rows are left untouched */
+static int check_copy(AVLFG *lfg, int bytewidth, int height,
+                      int dst_linesize, int src_linesize, int dst_offset, int nt)
+{
+    size_t dst_size = (size_t)FFABS(dst_linesize) * height + 2 * PAD;
+    size_t src_size = (size_t)FFABS(src_linesize) * height;
+    uint8_t *dst_buf = av_malloc(dst_size), *ref_buf = av_malloc(dst_size);
+    uint8_t *src_buf = av_malloc(src_size);
+    uint8_t *dst, *ref, *src;
+    int i, ret = 0;
+
+    if (!dst_buf || !ref_buf || !src_buf) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+    for (i = 0; i < dst_size; i++)
+        dst_buf[i] = ref_buf[i] = av_lfg_get(lfg);
+    for (i = 0; i < src_size; i++)
+        src_buf[i] = av_lfg_get(lfg);
+
+    dst = dst_buf + PAD + dst_offset;
+    ref = ref_buf + PAD + dst_offset;
+    src = src_buf;
+    if (dst_linesize < 0) {
+        dst += (size_t)-dst_linesize * (height - 1);
+        ref += (size_t)-dst_linesize * (height - 1);
+    }
+    if (src_linesize < 0)
+        src += (size_t)-src_linesize * (height - 1);
+
+    for (i = 0; i < height; i++)
+        memcpy(ref + i * dst_linesize, src + i * src_linesize, bytewidth);
+    if (nt)
+        copy_plane_rows(dst, dst_linesize, src, src_linesize, bytewidth, height, 1);
+    else
+        image_copy_plane(dst, dst_linesize, src, src_linesize, bytewidth, height);
+
+    if (memcmp(dst_buf, ref_buf, dst_size)) {
+        fprintf(stderr, "copy %dx%d linesizes %d/%d offset %d nt %d: mismatch\n",
+                bytewidth, height, dst_linesize, src_linesize, dst_offset, nt);
+        ret = 1;
+    }
+
+end:
+    av_free(dst_buf);
+    av_free(ref_buf);
+    av_free(src_buf);
+    return ret;
+}
+
+static int test_copy(AVLFG *lfg)
+{
+    static const struct {
+        int bytewidth, height, dst_linesize, src_linesize, dst_offset;
+    } layouts[] = {
+        {    1,    1,     1,     1,  0 },
+        {   17,    9,    32,    17,  0 },
+        {   64,   16,    64,    64,  0 },
+        {   64,   16,   -64,   -64,  0 },
+        {   64,   16,   128,   -80,  0 },
+        {   65,    5,    80,    65,  0 },
+        {  100,   33,   112,   100,  0 },
+        {  100,   33,   112,   100,  8 },
+        {  129,    7,  -144,   160,  0 },
+        { 1920,   64,  1920,  1920,  0 },
+        { 1920,   64,  1984,  1921,  0 },
+        { 4100, 1100,  4112,  4100,  0 },
+        { 4096, 1100,  4096,  4096,  0 },
+        { 4096, 1100, -4096, -4096,  0 },
+    };
+    int i, nt, ret = 0;
+
+    for (nt = 0; nt < 2; nt++)
+        for (i = 0; i < FF_ARRAY_ELEMS(layouts); i++)
+            ret |= check_copy(lfg, layouts[i].bytewidth, layouts[i].height,
+                              layouts[i].dst_linesize, layouts[i].src_linesize,
+                              layouts[i].dst_offset, nt);
+    return ret;
+}
+
+/* copy a 16-bit 8K plane for about a second, return bytes per second */
+static double speed_test(uint8_t *dst, const uint8_t *src, ptrdiff_t linesize,
+                         int height, int mode)
+{
+    int64_t ti = av_gettime_relative(), ti1;
+    int it = 0, i;
+
+    do {
+        switch (mode) {
+        case 0:
+            for (i = 0; i < height; i++)
+                memcpy(dst + i * linesize, src + i * linesize, linesize);
+            break;
+        case 1:
+        case 2:
+            copy_plane_rows(dst, linesize, src, linesize, linesize, height, mode == 2);
+            break;
+        default:
+            image_copy_plane(dst, linesize, src, linesize, linesize, height);
+        }
+        it++;
+        ti1 = av_gettime_relative() - ti;
+    } while (ti1 < 1000000);
+
+    return (double)it * linesize * height * 1000000 / ti1;
+}
+
+static void help(void)
+{
+    printf("usage: imgutils [-h] [-s] [-t threads]\n"
+           "-h     print this help\n"
+           "-s     speed test\n"
+           "-t     speed test with a thread pool of the given size\n");
+}
+
+int main(int argc, char **argv)
 {
     int64_t x, y;
+    AVLFG lfg;
+    int ret, speed = 0, threads = 0;
+
+    for (;;) {
+        int c = getopt(argc, argv, "hst:");
+        if (c == -1)
+            break;
+        switch (c) {
+        case 's':
+            speed = 1;
+            break;
+        case 't':
+            speed   = 1;
+            threads = atoi(optarg);
+            break;
+        default:
+            help();
+            return 1;
+        }
+    }
+
+    if (speed) {
+        static const char *const names[] = {
+            "memcpy per row", "contiguous", "non-temporal", "av_image_copy_plane",
+        };
+        const ptrdiff_t linesize = 7680 * 2;
+        const int height = 4320;
+        uint8_t *src = av_malloc(linesize * height);
+        uint8_t *dst = av_malloc(linesize * height);
+        int mode;
+
+        if (!src || !dst)
+            return 2;
+        memset(src, 0x55, linesize * height);
+        memset(dst, 0xaa, linesize * height);
+        if (threads > 0 && av_thread_pool_init(threads, 0) < 0)
+            return 2;
+        for (mode = 0; mode < FF_ARRAY_ELEMS(names); mode++)
+            printf("%-20s %6.2f GB/s\n", names[mode],
+                   speed_test(dst, src, linesize, height, mode) / 1e9);
+        av_thread_pool_uninit();
+        av_free(src);
+        av_free(dst);
+        return 0;
+    }
 
     for (y = -1; y<UINT_MAX; y+= y/2 + 1) {
         for (x = -1; x<UINT_MAX; x+= x/2 + 1) {
@@ -32,5 +209,14 @@ int main(void)
         printf("\n");
     }
 
-    return 0;
+    av_lfg_init(&lfg, 0x1234);
+    ret = test_copy(&lfg);
+    /* again with the copies of the larger planes split across threads */
+    if (av_thread_pool_init(2, 0) >= 0) {
+        ret |= test_copy(&lfg);
+        av_thread_pool_uninit();
+    }
+    printf("plane copy: %s\n", ret ? "failed" : "ok");
+
+    return ret;
 }
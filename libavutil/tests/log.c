@@ -34,6 +34,57 @@ static int call_log_format_line2(const char *fmt, char *buffer, int buffer_size,
     return ret;
 }
 
+#if HAVE_THREADS
+#define ASYNC_THREADS  4
+#define ASYNC_MESSAGES 2000
+
+static int async_next[ASYNC_THREADS];
+static int async_errors;
+
+static void async_callback(void *opaque, const AVLogRecord *record)
+{
+    int thread, msg;
+
+    if (sscanf(record->message, "thread %d msg %d", &thread, &msg) != 2 ||
+        thread < 0 || thread >= ASYNC_THREADS ||
+        msg != async_next[thread]++ ||
+        record->level != AV_LOG_DEBUG || !record->timestamp)
+        async_errors++;
+}
+
+static void *async_thread(void *arg)
+{
+    int i, thread = (intptr_t)arg;
+
+    for (i = 0; i < ASYNC_MESSAGES; i++)
+        av_log(NULL, AV_LOG_DEBUG, "thread %d msg %d\n", thread, i);
+    return NULL;
+}
+
+static int test_async(void)
+{
+    pthread_t threads[ASYNC_THREADS];
+    int i;
+
+    if (av_log_async_start(async_callback, NULL) < 0)
+        return 1;
+    for (i = 0; i < ASYNC_THREADS; i++)
+        pthread_create(&threads[i], NULL, async_thread, (void *)(intptr_t)i);
+    for (i = 0; i < ASYNC_THREADS; i++)
+        pthread_join(threads[i], NULL);
+    av_log_async_stop();
+
+    for (i = 0; i < ASYNC_THREADS; i++)
+        if (async_next[i] != ASYNC_MESSAGES)
+            async_errors++;
+    if (async_errors || av_log_callback != av_log_default_callback) {
+        printf("Test async logging failed.\n");
+        return 1;
+    }
+    return 0;
+}
+#endif
+
 int main(int argc, char **argv)
 {
     int i;
@@ -67,5 +118,9 @@ int main(int argc, char **argv)
             return 1;
         }
     }
+#if HAVE_THREADS
+    if (test_async())
+        return 1;
+#endif
     return 0;
 }
@@ -18,6 +18,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <stdatomic.h>
+#include <string.h>
+
 #include "fifo.h"
 #include "threadmessage.h"
 #include "thread.h"
@@ -28,10 +31,20 @@ struct AVThreadMessageQueue {
     pthread_mutex_t lock;
     pthread_cond_t cond_recv;
     pthread_cond_t cond_send;
-    int err_send;
-    int err_recv;
+    atomic_int err_send;
+    atomic_int err_recv;
     unsigned elsize;
     void (*free_func)(void *msg);
+
+    /* AV_THREAD_MESSAGE_QUEUE_FLAG_SPSC: a ring used instead of fifo, the
+     * lock is only taken to sleep on and to wake up a waiting thread */
+    uint8_t *ring;
+    unsigned nelem;
+    unsigned write_idx;     ///< only accessed by the sending thread
+    unsigned read_idx;      ///< only accessed by the receiving thread
+    atomic_uint nb_queued;
+    atomic_int send_waiting;
+    atomic_int recv_waiting;
 #else
     int dummy;
 #endif
@@ -40,6 +53,14 @@ struct AVThreadMessageQueue {
 int av_thread_message_queue_alloc(AVThreadMessageQueue **mq,
                                   unsigned nelem,
                                   unsigned elsize)
+{
+    return av_thread_message_queue_alloc2(mq, nelem, elsize, 0);
+}
+
+int av_thread_message_queue_alloc2(AVThreadMessageQueue **mq,
+                                   unsigned nelem,
+                                   unsigned elsize,
+                                   unsigned flags)
 {
 #if HAVE_THREADS
     AVThreadMessageQueue *rmq;
@@ -47,6 +68,8 @@ int av_thread_message_queue_alloc(AVThreadMessageQueue **mq,
 
     if (nelem > INT_MAX / elsize)
         return AVERROR(EINVAL);
+    if ((flags & AV_THREAD_MESSAGE_QUEUE_FLAG_SPSC) && (!nelem || !elsize))
+        return AVERROR(EINVAL);
     if (!(rmq = av_mallocz(sizeof(*rmq))))
         return AVERROR(ENOMEM);
     if ((ret = pthread_mutex_init(&rmq->lock, NULL))) {
@@ -64,7 +87,11 @@ int av_thread_message_queue_alloc(AVThreadMessageQueue **mq,
         av_free(rmq);
         return AVERROR(ret);
     }
-    if (!(rmq->fifo = av_fifo_alloc(elsize * nelem))) {
+    if (flags & AV_THREAD_MESSAGE_QUEUE_FLAG_SPSC)
+        rmq->ring = av_malloc_array(nelem, elsize);
+    else
+        rmq->fifo = av_fifo_alloc(elsize * nelem);
+    if (!rmq->ring && !rmq->fifo) {
         pthread_cond_destroy(&rmq->cond_send);
         pthread_cond_destroy(&rmq->cond_recv);
         pthread_mutex_destroy(&rmq->lock);
@@ -72,6 +99,7 @@ int av_thread_message_queue_alloc(AVThreadMessageQueue **mq,
         return AVERROR(ENOMEM);
     }
     rmq->elsize = elsize;
+    rmq->nelem  = nelem;
     *mq = rmq;
     return 0;
 #else
@@ -94,6 +122,7 @@ void av_thread_message_queue_free(AVThreadMessageQueue **mq)
     if (*mq) {
         av_thread_message_flush(*mq);
         av_fifo_freep(&(*mq)->fifo);
+        av_freep(&(*mq)->ring);
         pthread_cond_destroy(&(*mq)->cond_send);
         pthread_cond_destroy(&(*mq)->cond_recv);
         pthread_mutex_destroy(&(*mq)->lock);
@@ -106,6 +135,8 @@ int av_thread_message_queue_nb_elems(AVThreadMessageQueue *mq)
 {
 #if HAVE_THREADS
     int ret;
+    if (mq->ring)
+        return atomic_load(&mq->nb_queued);
     pthread_mutex_lock(&mq->lock);
     ret = av_fifo_size(mq->fifo);
     pthread_mutex_unlock(&mq->lock);
@@ -151,6 +182,70 @@ static int av_thread_message_queue_recv_locked(AVThreadMessageQueue *mq,
     return 0;
 }
 
+static void wake_waiter(AVThreadMessageQueue *mq, atomic_int *waiting,
+                        pthread_cond_t *cond)
+{
+    if (atomic_load(waiting)) {
+        pthread_mutex_lock(&mq->lock);
+        pthread_cond_signal(cond);
+        pthread_mutex_unlock(&mq->lock);
+    }
+}
+
+/*
+ * The waiting flags are set before the queue state is checked again, and
+ * the other side checks them after updating nb_queued, so with sequentially
+ * consistent atomics no wakeup can be lost.
+ */
+
+static int thread_message_queue_send_spsc(AVThreadMessageQueue *mq,
+                                          void *msg,
+                                          unsigned flags)
+{
+    if (!mq->err_send && atomic_load(&mq->nb_queued) == mq->nelem) {
+        if ((flags & AV_THREAD_MESSAGE_NONBLOCK))
+            return AVERROR(EAGAIN);
+        pthread_mutex_lock(&mq->lock);
+        atomic_store(&mq->send_waiting, 1);
+        while (!mq->err_send && atomic_load(&mq->nb_queued) == mq->nelem)
+            pthread_cond_wait(&mq->cond_send, &mq->lock);
+        atomic_store(&mq->send_waiting, 0);
+        pthread_mutex_unlock(&mq->lock);
+    }
+    if (mq->err_send)
+        return mq->err_send;
+    memcpy(mq->ring + mq->write_idx * mq->elsize, msg, mq->elsize);
+    if (++mq->write_idx == mq->nelem)
+        mq->write_idx = 0;
+    atomic_fetch_add(&mq->nb_queued, 1);
+    wake_waiter(mq, &mq->recv_waiting, &mq->cond_recv);
+    return 0;
+}
+
+static int thread_message_queue_recv_spsc(AVThreadMessageQueue *mq,
+                                          void *msg,
+                                          unsigned flags)
+{
+    if (!mq->err_recv && !atomic_load(&mq->nb_queued)) {
+        if ((flags & AV_THREAD_MESSAGE_NONBLOCK))
+            return AVERROR(EAGAIN);
+        pthread_mutex_lock(&mq->lock);
+        atomic_store(&mq->recv_waiting, 1);
+        while (!mq->err_recv && !atomic_load(&mq->nb_queued))
+            pthread_cond_wait(&mq->cond_recv, &mq->lock);
+        atomic_store(&mq->recv_waiting, 0);
+        pthread_mutex_unlock(&mq->lock);
+    }
+    if (!atomic_load(&mq->nb_queued))
+        return mq->err_recv;
+    memcpy(msg, mq->ring + mq->read_idx * mq->elsize, mq->elsize);
+    if (++mq->read_idx == mq->nelem)
+        mq->read_idx = 0;
+    atomic_fetch_sub(&mq->nb_queued, 1);
+    wake_waiter(mq, &mq->send_waiting, &mq->cond_send);
+    return 0;
+}
+
 #endif /* HAVE_THREADS */
 
 int av_thread_message_queue_send(AVThreadMessageQueue *mq,
@@ -160,6 +255,9 @@ int av_thread_message_queue_send(AVThreadMessageQueue *mq,
 #if HAVE_THREADS
     int ret;
 
+    if (mq->ring)
+        return thread_message_queue_send_spsc(mq, msg, flags);
+
     pthread_mutex_lock(&mq->lock);
     ret = av_thread_message_queue_send_locked(mq, msg, flags);
     pthread_mutex_unlock(&mq->lock);
@@ -176,6 +274,9 @@ int av_thread_message_queue_recv(AVThreadMessageQueue *mq,
 #if HAVE_THREADS
     int ret;
 
+    if (mq->ring)
+        return thread_message_queue_recv_spsc(mq, msg, flags);
+
     pthread_mutex_lock(&mq->lock);
     ret = av_thread_message_queue_recv_locked(mq, msg, flags);
     pthread_mutex_unlock(&mq->lock);
@@ -221,6 +322,21 @@ void av_thread_message_flush(AVThreadMessageQueue *mq)
     int used, off;
     void *free_func = mq->free_func;
 
+    if (mq->ring) {
+        used = atomic_load(&mq->nb_queued);
+        for (off = 0; off < used; off++) {
+            if (free_func)
+                mq->free_func(mq->ring + mq->read_idx * mq->elsize);
+            if (++mq->read_idx == mq->nelem)
+                mq->read_idx = 0;
+        }
+        atomic_fetch_sub(&mq->nb_queued, used);
+        pthread_mutex_lock(&mq->lock);
+        pthread_cond_broadcast(&mq->cond_send);
+        pthread_mutex_unlock(&mq->lock);
+        return;
+    }
+
     pthread_mutex_lock(&mq->lock);
     used = av_fifo_size(mq->fifo);
     if (free_func)
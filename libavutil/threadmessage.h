@@ -45,6 +45,31 @@ int av_thread_message_queue_alloc(AVThreadMessageQueue **mq,
                                   unsigned nelem,
                                   unsigned elsize);
 
+/**
+ * The queue is only ever used by one sending and one receiving thread.
+ *
+ * Messages are then passed through a lock-free ring, and a lock is only
+ * taken when a thread has to wait because the queue is full or empty.
+ * av_thread_message_flush() must only be called from the receiving thread,
+ * or while no message is being received.
+ */
+#define AV_THREAD_MESSAGE_QUEUE_FLAG_SPSC (1 << 0)
+
+/**
+ * Allocate a new message queue.
+ *
+ * @param mq      pointer to the message queue
+ * @param nelem   maximum number of elements in the queue
+ * @param elsize  size of each element in the queue
+ * @param flags   a combination of AV_THREAD_MESSAGE_QUEUE_FLAG_*
+ * @return  >=0 for success; <0 for error, in particular AVERROR(ENOSYS) if
+ *          lavu was built without thread support
+ */
+int av_thread_message_queue_alloc2(AVThreadMessageQueue **mq,
+                                   unsigned nelem,
+                                   unsigned elsize,
+                                   unsigned flags);
+
 /**
  * Free a message queue.
  *
@@ -0,0 +1,62 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef AVUTIL_THREADPOOL_H
+#define AVUTIL_THREADPOOL_H
+
+/**
+ * @file
+ * Process-wide thread pool for slice threading.
+ *
+ * By default every codec context and filter graph using slice threading
+ * starts its own worker threads. Once a shared pool is set up with
+ * av_thread_pool_init(), slice threading contexts created afterwards
+ * start no threads of their own. Instead they queue their jobs on the
+ * pool, and any idle pool thread picks them up. Applications running many
+ * codecs and filter graphs concurrently can bound the total number of
+ * threads this way.
+ *
+ * Frame threading in libavcodec keeps using per-context threads.
+ */
+
+/**
+ * Pin each pool thread to one CPU, in the order of the CPUs the process is
+ * allowed to run on. This is only a hint and is ignored on systems where
+ * it is not supported.
+ */
+#define AV_THREAD_POOL_FLAG_AFFINITY (1 << 0)
+
+/**
+ * Start the process-wide thread pool.
+ *
+ * @param nb_threads number of pool threads, 0 for one per CPU
+ * @param flags      a combination of AV_THREAD_POOL_FLAG_*
+ * @return 0 on success, AVERROR(EEXIST) if a pool is already running,
+ *         AVERROR(ENOSYS) if threading is not supported, or another
+ *         negative AVERROR code on failure
+ */
+int av_thread_pool_init(int nb_threads, int flags);
+
+/**
+ * Stop using the process-wide thread pool for new slice threading
+ * contexts. Contexts that already use the pool keep it alive until they
+ * are freed, so this may be called at any time.
+ */
+void av_thread_pool_uninit(void);
+
+#endif /* AVUTIL_THREADPOOL_H */
@@ -107,15 +107,128 @@ int ff_tx_gen_ptwo_revtab(AVTXContext *s)
     return 0;
 }
 
+/**
+ * Transforms with identical parameters share their tables, which are only
+ * read after init. Audio filters typically create one transform per
+ * channel, all of them alike.
+ */
+struct TXPlan {
+    TXPlan *next;
+    int refcount;
+
+    enum AVTXType type;
+    int inv, len;
+    double scale;
+    uint64_t flags;
+
+    av_tx_fn fn;
+    size_t tmp_size;    /* Size of the per-context temporary buffer */
+    AVTXContext tabs;   /* Context holding the tables */
+};
+
+static AVMutex plan_lock = AV_MUTEX_INITIALIZER;
+static TXPlan *plans;
+
+static void free_tables(AVTXContext *s)
+{
+    av_freep(&s->pfatab);
+    av_freep(&s->exptab);
+    av_freep(&s->revtab);
+    av_freep(&s->tmp);
+}
+
+static int init_tables(AVTXContext *s, av_tx_fn *tx, enum AVTXType type,
+                       int inv, int len, const void *scale, uint64_t flags)
+{
+    switch (type) {
+    case AV_TX_FLOAT_FFT:
+    case AV_TX_FLOAT_MDCT:
+        return ff_tx_init_mdct_fft_float(s, tx, type, inv, len, scale, flags);
+    case AV_TX_DOUBLE_FFT:
+    case AV_TX_DOUBLE_MDCT:
+        return ff_tx_init_mdct_fft_double(s, tx, type, inv, len, scale, flags);
+    case AV_TX_INT32_FFT:
+    case AV_TX_INT32_MDCT:
+        return ff_tx_init_mdct_fft_int32(s, tx, type, inv, len, scale, flags);
+    default:
+        return AVERROR(EINVAL);
+    }
+}
+
+/* Must be called with plan_lock held */
+static int get_plan(TXPlan **pplan, enum AVTXType type, int inv, int len,
+                    const void *scale, uint64_t flags)
+{
+    double scale_val = 0.0;
+    TXPlan *plan;
+    int err;
+
+    /* Only MDCTs use the scale */
+    if (type == AV_TX_DOUBLE_MDCT)
+        scale_val = *(const double *)scale;
+    else if (ff_tx_type_is_mdct(type))
+        scale_val = *(const float *)scale;
+
+    for (plan = plans; plan; plan = plan->next) {
+        if (plan->type == type && plan->inv == inv && plan->len == len &&
+            plan->scale == scale_val && plan->flags == flags) {
+            plan->refcount++;
+            *pplan = plan;
+            return 0;
+        }
+    }
+
+    if (!(plan = av_mallocz(sizeof(*plan))))
+        return AVERROR(ENOMEM);
+    if ((err = init_tables(&plan->tabs, &plan->fn, type, inv, len, scale, flags))) {
+        free_tables(&plan->tabs);
+        av_free(plan);
+        return err;
+    }
+    if (plan->tabs.tmp) {
+        size_t sample_size = type == AV_TX_DOUBLE_FFT ||
+                             type == AV_TX_DOUBLE_MDCT ? sizeof(AVComplexDouble) :
+                                                         sizeof(AVComplexFloat);
+        plan->tmp_size = plan->tabs.n * plan->tabs.m * sample_size;
+        av_freep(&plan->tabs.tmp);
+    }
+
+    plan->type     = type;
+    plan->inv      = inv;
+    plan->len      = len;
+    plan->scale    = scale_val;
+    plan->flags    = flags;
+    plan->refcount = 1;
+    plan->next     = plans;
+    plans          = plan;
+
+    *pplan = plan;
+    return 0;
+}
+
+static void release_plan(TXPlan *plan)
+{
+    TXPlan **p;
+
+    ff_mutex_lock(&plan_lock);
+    if (!--plan->refcount) {
+        for (p = &plans; *p != plan; p = &(*p)->next)
+            ;
+        *p = plan->next;
+        free_tables(&plan->tabs);
+        av_free(plan);
+    }
+    ff_mutex_unlock(&plan_lock);
+}
+
 av_cold void av_tx_uninit(AVTXContext **ctx)
 {
     if (!(*ctx))
         return;
 
-    av_free((*ctx)->pfatab);
-    av_free((*ctx)->exptab);
-    av_free((*ctx)->revtab);
     av_free((*ctx)->tmp);
+    if ((*ctx)->plan)
+        release_plan((*ctx)->plan);
 
     av_freep(ctx);
 }
@@ -124,31 +237,25 @@ av_cold int av_tx_init(AVTXContext **ctx, av_tx_fn *tx, enum AVTXType type,
                        int inv, int len, const void *scale, uint64_t flags)
 {
     int err;
+    TXPlan *plan;
     AVTXContext *s = av_mallocz(sizeof(*s));
     if (!s)
         return AVERROR(ENOMEM);
 
-    switch (type) {
-    case AV_TX_FLOAT_FFT:
-    case AV_TX_FLOAT_MDCT:
-        if ((err = ff_tx_init_mdct_fft_float(s, tx, type, inv, len, scale, flags)))
-            goto fail;
-        break;
-    case AV_TX_DOUBLE_FFT:
-    case AV_TX_DOUBLE_MDCT:
-        if ((err = ff_tx_init_mdct_fft_double(s, tx, type, inv, len, scale, flags)))
-            goto fail;
-        break;
-    case AV_TX_INT32_FFT:
-    case AV_TX_INT32_MDCT:
-        if ((err = ff_tx_init_mdct_fft_int32(s, tx, type, inv, len, scale, flags)))
-            goto fail;
-        break;
-    default:
-        err = AVERROR(EINVAL);
+    ff_mutex_lock(&plan_lock);
+    err = get_plan(&plan, type, inv, len, scale, flags);
+    ff_mutex_unlock(&plan_lock);
+    if (err)
+        goto fail;
+
+    *s = plan->tabs;
+    s->plan = plan;
+    if (plan->tmp_size && !(s->tmp = av_malloc(plan->tmp_size))) {
+        err = AVERROR(ENOMEM);
         goto fail;
     }
 
+    *tx  = plan->fn;
     *ctx = s;
 
     return 0;
@@ -158,3 +265,12 @@ fail:
     *tx = NULL;
     return err;
 }
+
+av_cold void ff_txdsp_init(TXDSPContext *c)
+{
+    c->pass_float  = ff_tx_pass_c_float;
+    c->pass_double = ff_tx_pass_c_double;
+
+    if (ARCH_X86)
+        ff_txdsp_init_x86(c);
+}
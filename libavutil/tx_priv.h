@@ -101,6 +101,8 @@ typedef void FFTComplex;
 #define COSTABLE(size) \
     DECLARE_ALIGNED(32, FFTSample, TX_NAME(ff_cos_##size))[size/2]
 
+typedef struct TXPlan TXPlan;
+
 /* Used by asm, reorder with care */
 struct AVTXContext {
     int n;              /* Nptwo part */
@@ -112,8 +114,26 @@ struct AVTXContext {
     FFTComplex *tmp;    /* Temporary buffer needed for all compound transforms */
     int        *pfatab; /* Input/Output mapping for compound transforms */
     int        *revtab; /* Input mapping for power of two transforms */
+
+    TXPlan     *plan;   /* Owner of the tables, shared by identical contexts */
 };
 
+/**
+ * Optimized versions of the split-radix pass in tx_template.c, which
+ * combines the four quarters of z[0...8n-1] using the twiddles
+ * wre[0...2n].
+ */
+typedef struct TXDSPContext {
+    void (*pass_float)(AVComplexFloat *z, const float *wre, unsigned int n);
+    void (*pass_double)(AVComplexDouble *z, const double *wre, unsigned int n);
+} TXDSPContext;
+
+void ff_tx_pass_c_float(AVComplexFloat *z, const float *wre, unsigned int n);
+void ff_tx_pass_c_double(AVComplexDouble *z, const double *wre, unsigned int n);
+
+void ff_txdsp_init(TXDSPContext *c);
+void ff_txdsp_init_x86(TXDSPContext *c);
+
 /* Shared functions */
 int ff_tx_type_is_mdct(enum AVTXType type);
 int ff_tx_gen_compound_mapping(AVTXContext *s);
@@ -277,13 +277,43 @@ PASS(pass)
 #define BUTTERFLIES BUTTERFLIES_BIG
 PASS(pass_big)
 
+#ifndef TX_INT32
+void TX_NAME(ff_tx_pass_c)(FFTComplex *z, const FFTSample *wre, unsigned int n)
+{
+    pass_big(z, wre, n);
+}
+#endif
+
+/* SIMD version of pass(), if there is one for this type and CPU */
+static void (*pass_opt)(FFTComplex *z, const FFTSample *wre, unsigned int n);
+static AVOnce pass_opt_once = AV_ONCE_INIT;
+
+static av_cold void init_pass_opt(void)
+{
+#ifndef TX_INT32
+    TXDSPContext c;
+
+    ff_txdsp_init(&c);
+#ifdef TX_FLOAT
+    if (c.pass_float != ff_tx_pass_c_float)
+        pass_opt = c.pass_float;
+#else
+    if (c.pass_double != ff_tx_pass_c_double)
+        pass_opt = c.pass_double;
+#endif
+#endif
+}
+
 #define DECL_FFT(n,n2,n4)\
 static void fft##n(FFTComplex *z)\
 {\
     fft##n2(z);\
     fft##n4(z+n4*2);\
     fft##n4(z+n4*3);\
-    pass(z,TX_NAME(ff_cos_##n),n4/2);\
+    if (pass_opt)\
+        pass_opt(z,TX_NAME(ff_cos_##n),n4/2);\
+    else\
+        pass(z,TX_NAME(ff_cos_##n),n4/2);\
 }
 
 static void fft2(FFTComplex *z)
@@ -631,6 +661,8 @@ int TX_NAME(ff_tx_init_mdct_fft)(AVTXContext *s, av_tx_fn *tx,
         for (int i = 4; i <= av_log2(m); i++)
             init_cos_tabs(i);
     }
+    if (m >= 32)
+        ff_thread_once(&pass_opt_once, init_pass_opt);
 
     if (is_mdct)
         return gen_mdct_exptab(s, n*m, *((SCALE_TYPE *)scale));
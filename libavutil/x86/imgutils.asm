@@ -51,3 +51,51 @@ cglobal image_copy_plane_uc_from, 6, 7, 4, dst, dst_linesize, src, src_linesize,
     jnz .row_start
 
     RET
+
+; The destination rows must be 16-byte aligned and bw at least 64. The last
+; 64 bytes of each row are copied again with regular stores if bw is not a
+; multiple of 64; they are rewritten with the same data, so the overlap is
+; harmless.
+INIT_XMM sse2
+cglobal image_copy_plane_nt, 6, 7, 4, dst, dst_linesize, src, src_linesize, bw, height, rowpos
+    add dstq, bwq
+    add srcq, bwq
+    neg bwq
+
+.row_start:
+    mov rowposq, bwq
+
+.loop:
+    movu m0, [srcq + rowposq + 0 * mmsize]
+    movu m1, [srcq + rowposq + 1 * mmsize]
+    movu m2, [srcq + rowposq + 2 * mmsize]
+    movu m3, [srcq + rowposq + 3 * mmsize]
+
+    movntdq [dstq + rowposq + 0 * mmsize], m0
+    movntdq [dstq + rowposq + 1 * mmsize], m1
+    movntdq [dstq + rowposq + 2 * mmsize], m2
+    movntdq [dstq + rowposq + 3 * mmsize], m3
+
+    add rowposq, 4 * mmsize
+    cmp rowposq, -4 * mmsize
+    jle .loop
+
+    test rowposq, rowposq
+    jz .row_end
+    movu m0, [srcq - 4 * mmsize]
+    movu m1, [srcq - 3 * mmsize]
+    movu m2, [srcq - 2 * mmsize]
+    movu m3, [srcq - 1 * mmsize]
+    movu [dstq - 4 * mmsize], m0
+    movu [dstq - 3 * mmsize], m1
+    movu [dstq - 2 * mmsize], m2
+    movu [dstq - 1 * mmsize], m3
+
+.row_end:
+    add srcq, src_linesizeq
+    add dstq, dst_linesizeq
+    dec heightd
+    jnz .row_start
+
+    sfence
+    RET
@@ -30,6 +30,9 @@
 void ff_image_copy_plane_uc_from_sse4(uint8_t *dst, ptrdiff_t dst_linesize,
                                       const uint8_t *src, ptrdiff_t src_linesize,
                                       ptrdiff_t bytewidth, int height);
+void ff_image_copy_plane_nt_sse2(uint8_t *dst, ptrdiff_t dst_linesize,
+                                 const uint8_t *src, ptrdiff_t src_linesize,
+                                 ptrdiff_t bytewidth, int height);
 
 int ff_image_copy_plane_uc_from_x86(uint8_t       *dst, ptrdiff_t dst_linesize,
                                     const uint8_t *src, ptrdiff_t src_linesize,
@@ -47,3 +50,19 @@ int ff_image_copy_plane_uc_from_x86(uint8_t       *dst, ptrdiff_t dst_linesize,
 
     return 0;
 }
+
+int ff_image_copy_plane_nt_x86(uint8_t       *dst, ptrdiff_t dst_linesize,
+                               const uint8_t *src, ptrdiff_t src_linesize,
+                               ptrdiff_t bytewidth, int height)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (EXTERNAL_SSE2(cpu_flags) && bytewidth >= 64 &&
+        !((uintptr_t)dst & 15) && !(dst_linesize & 15))
+        ff_image_copy_plane_nt_sse2(dst, dst_linesize, src, src_linesize,
+                                    bytewidth, height);
+    else
+        return AVERROR(ENOSYS);
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+;******************************************************************************
+;* x86-optimized split-radix passes for the power of two transforms in tx
+;*
+;* This file is part of FFmpeg.
+;*
+;* FFmpeg is free software; you can redistribute it and/or
+;* modify it under the terms of the GNU Lesser General Public
+;* License as published by the Free Software Foundation; either
+;* version 2.1 of the License, or (at your option) any later version.
+;*
+;* FFmpeg is distributed in the hope that it will be useful,
+;* but WITHOUT ANY WARRANTY; without even the implied warranty of
+;* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+;* Lesser General Public License for more details.
+;*
+;* You should have received a copy of the GNU Lesser General Public
+;* License along with FFmpeg; if not, write to the Free Software
+;* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+;******************************************************************************
+
+%include "x86util.asm"
+
+SECTION .text
+
+; Each iteration transforms mmsize bytes worth of complex values of each of
+; the four quarters z, z + o1, z + o2 and z + o3, with o1 being 2n complex
+; values. m0 and m1 hold the twiddles wre[k] and wim[-k], each duplicated
+; for the real and the imaginary part. The operations and their order
+; match the TRANSFORM() macro in tx_template.c. The C code special-cases
+; the first butterfly as TRANSFORM_ZERO(), while this uses the table values,
+; which can change the last bit of that butterfly's output.
+;
+; movup%1 rather than movu, which is the load-only lddqu in SSE3 functions.
+;
+; %1 = ps or pd, %2 = shuffle immediate swapping re and im
+%macro PASS_BODY 2
+    movup%1    m2, [zq + o1q*2]        ; a2
+    movup%1    m3, [zq + o3q]          ; a3
+    shufp%1    m4, m2, m2, %2
+    mulp%1     m4, m0
+    mulp%1     m2, m1
+    addsubp%1  m4, m2                  ; a2 * conj(w), with re and im swapped
+    shufp%1    m5, m3, m3, %2
+    mulp%1     m3, m0
+    mulp%1     m5, m1
+    addsubp%1  m3, m5                  ; q = a3 * w
+    shufp%1    m4, m4, m4, %2          ; p = a2 * conj(w)
+    subp%1     m5, m3, m4
+    subp%1     m6, m4, m3
+    addp%1     m3, m4                  ; p + q
+    shufp%1    m5, m5, m5, %2
+    shufp%1    m6, m6, m6, %2
+    movup%1    m0, [zq]                ; a0
+    movup%1    m1, [zq + o1q]          ; a1
+    subp%1     m2, m0, m3
+    addp%1     m0, m3
+    addsubp%1  m4, m1, m6
+    addsubp%1  m1, m5
+    movup%1    [zq], m0
+    movup%1    [zq + o1q], m1
+    movup%1    [zq + o1q*2], m2
+    movup%1    [zq + o3q], m4
+%endmacro
+
+;-----------------------------------------------------------------------------
+; void ff_tx_pass_float(AVComplexFloat *z, const float *wre, unsigned int n)
+;-----------------------------------------------------------------------------
+%macro PASS_FLOAT 0
+cglobal tx_pass_float, 3, 6, 7, z, wre, o1, wim, o3, cnt
+    mov        o1d, o1d
+    lea        wimq, [wreq + o1q*8]    ; wim = wre + 2n
+    shl        o1q, 4                  ; o1 = 2n complex values in bytes
+    lea        o3q, [o1q*2 + o1q]
+    mov        cntq, o1q
+.loop:
+%if mmsize == 32
+    movu       xm0, [wreq]
+    movu       xm1, [wimq - 12]
+    shufps     xm1, xm1, q0123
+    unpcklps   xm2, xm0, xm0
+    unpckhps   xm0, xm0, xm0
+    unpcklps   xm3, xm1, xm1
+    unpckhps   xm1, xm1, xm1
+    vinsertf128 m0, m2, xm0, 1
+    vinsertf128 m1, m3, xm1, 1
+%else
+    movsd      m0, [wreq]
+    movsd      m1, [wimq - 4]
+    unpcklps   m0, m0
+    unpcklps   m1, m1
+    shufps     m1, m1, q1032
+%endif
+    PASS_BODY  s, q2301
+    add        zq, mmsize
+    add        wreq, mmsize/2
+    sub        wimq, mmsize/2
+    sub        cntq, mmsize
+    jg .loop
+    RET
+%endmacro
+
+;-----------------------------------------------------------------------------
+; void ff_tx_pass_double(AVComplexDouble *z, const double *wre, unsigned int n)
+;-----------------------------------------------------------------------------
+%macro PASS_DOUBLE 0
+cglobal tx_pass_double, 3, 6, 7, z, wre, o1, wim, o3, cnt
+    mov        o1d, o1d
+    shl        o1q, 4                  ; wim = wre + 2n
+    lea        wimq, [wreq + o1q]
+    shl        o1q, 1                  ; o1 = 2n complex values in bytes
+    lea        o3q, [o1q*2 + o1q]
+    mov        cntq, o1q
+.loop:
+%if mmsize == 32
+    movu       xm0, [wreq]
+    movu       xm1, [wimq - 8]
+    vinsertf128 m0, m0, xm0, 1
+    vinsertf128 m1, m1, xm1, 1
+    vpermilpd  m0, m0, 1100b
+    vpermilpd  m1, m1, 0011b
+%else
+    movddup    m0, [wreq]
+    movddup    m1, [wimq]
+%endif
+%if mmsize == 32
+    PASS_BODY  d, 0101b
+%else
+    PASS_BODY  d, 01b
+%endif
+    add        zq, mmsize
+    add        wreq, mmsize/2
+    sub        wimq, mmsize/2
+    sub        cntq, mmsize
+    jg .loop
+    RET
+%endmacro
+
+INIT_XMM sse3
+PASS_FLOAT
+PASS_DOUBLE
+%if HAVE_AVX_EXTERNAL
+INIT_YMM avx
+PASS_FLOAT
+PASS_DOUBLE
+%endif
@@ -0,0 +1,43 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+
+#include "libavutil/attributes.h"
+#include "libavutil/cpu.h"
+#include "libavutil/tx_priv.h"
+#include "cpu.h"
+
+void ff_tx_pass_float_sse3(AVComplexFloat *z, const float *wre, unsigned int n);
+void ff_tx_pass_float_avx(AVComplexFloat *z, const float *wre, unsigned int n);
+void ff_tx_pass_double_sse3(AVComplexDouble *z, const double *wre, unsigned int n);
+void ff_tx_pass_double_avx(AVComplexDouble *z, const double *wre, unsigned int n);
+
+av_cold void ff_txdsp_init_x86(TXDSPContext *c)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (EXTERNAL_SSE3(cpu_flags)) {
+        c->pass_float  = ff_tx_pass_float_sse3;
+        c->pass_double = ff_tx_pass_double_sse3;
+    }
+    if (EXTERNAL_AVX_FAST(cpu_flags)) {
+        c->pass_float  = ff_tx_pass_float_avx;
+        c->pass_double = ff_tx_pass_double_avx;
+    }
+}
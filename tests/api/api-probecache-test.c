@@ -0,0 +1,250 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * Probe cache test: the first open with a cache directory misses and stores
+ * an entry, the second one hits it, and a corrupted entry is ignored. The
+ * stream parameters must always match those found without a cache.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libavutil/avstring.h"
+#include "libavutil/bprint.h"
+#include "libavutil/crc.h"
+#include "libavformat/avformat.h"
+#include "libavformat/os_support.h"
+
+enum CacheEvent {
+    CACHE_NONE,
+    CACHE_HIT,
+    CACHE_IGNORED,
+};
+
+static enum CacheEvent cache_event;
+static char cache_entry[1024];
+
+static void log_callback(void *avcl, int level, const char *fmt, va_list vl)
+{
+    static const char hit[]     = "Probe cache hit for ";
+    static const char ignored[] = "Ignoring invalid probe cache entry ";
+    static const char stale[]   = "Ignoring stale probe cache entry ";
+    static const char layout[]  = "Stream layout differs from the probe cache";
+    char line[2048];
+    char *p;
+
+    vsnprintf(line, sizeof(line), fmt, vl);
+    if ((p = strstr(line, "\n")))
+        *p = 0;
+
+    if (av_strstart(line, hit, NULL) && (p = strstr(line, "' in "))) {
+        cache_event = CACHE_HIT;
+        av_strlcpy(cache_entry, p + 5, sizeof(cache_entry));
+    } else if (av_strstart(line, ignored, NULL) ||
+               av_strstart(line, stale, NULL)  ||
+               av_strstart(line, layout, NULL)) {
+        cache_event = CACHE_IGNORED;
+    } else if (level <= AV_LOG_ERROR) {
+        fprintf(stderr, "%s\n", line);
+    }
+}
+
+/* Print everything the probe cache is expected to restore. */
+static void describe(AVBPrint *bp, AVFormatContext *fmt_ctx)
+{
+    int i;
+
+    av_bprintf(bp, "format=%s start_time=%"PRId64" duration=%"PRId64
+               " bit_rate=%"PRId64" nb_streams=%d\n",
+               fmt_ctx->iformat->name, fmt_ctx->start_time, fmt_ctx->duration,
+               fmt_ctx->bit_rate, fmt_ctx->nb_streams);
+
+    for (i = 0; i < fmt_ctx->nb_streams; i++) {
+        AVStream *st = fmt_ctx->streams[i];
+        AVCodecParameters *par = st->codecpar;
+        uint32_t crc = 0;
+
+        if (par->extradata)
+            crc = av_crc(av_crc_get_table(AV_CRC_32_IEEE), 0,
+                         par->extradata, par->extradata_size);
+
+        av_bprintf(bp, "%d: type=%d codec=%d tag=%u format=%d bit_rate=%"PRId64
+                   " profile=%d level=%d %dx%d sar=%d/%d"
+                   " rate=%d channels=%d layout=%"PRIu64" frame_size=%d"
+                   " extradata=%d/%08x time_base=%d/%d r_frame_rate=%d/%d"
+                   " avg_frame_rate=%d/%d start_time=%"PRId64" duration=%"PRId64"\n",
+                   i, par->codec_type, par->codec_id, par->codec_tag,
+                   par->format, par->bit_rate, par->profile, par->level,
+                   par->width, par->height,
+                   par->sample_aspect_ratio.num, par->sample_aspect_ratio.den,
+                   par->sample_rate, par->channels, par->channel_layout,
+                   par->frame_size, par->extradata_size, crc,
+                   st->time_base.num, st->time_base.den,
+                   st->r_frame_rate.num, st->r_frame_rate.den,
+                   st->avg_frame_rate.num, st->avg_frame_rate.den,
+                   st->start_time, st->duration);
+    }
+}
+
+static int open_input(const char *filename, const char *cache_dir,
+                      AVBPrint *bp)
+{
+    AVFormatContext *fmt_ctx = NULL;
+    AVDictionary *opts = NULL;
+    int ret;
+
+    cache_event = CACHE_NONE;
+
+    if (cache_dir)
+        av_dict_set(&opts, "probe_cache", cache_dir, 0);
+    ret = avformat_open_input(&fmt_ctx, filename, NULL, &opts);
+    av_dict_free(&opts);
+    if (ret < 0) {
+        fprintf(stderr, "Cannot open %s: %s\n", filename, av_err2str(ret));
+        return ret;
+    }
+
+    ret = avformat_find_stream_info(fmt_ctx, NULL);
+    if (ret < 0)
+        fprintf(stderr, "Cannot find stream info: %s\n", av_err2str(ret));
+    else
+        describe(bp, fmt_ctx);
+
+    avformat_close_input(&fmt_ctx);
+    return ret;
+}
+
+static int check_open(const char *step, const char *filename,
+                      const char *cache_dir, const char *reference,
+                      enum CacheEvent expected)
+{
+    static const char *const event_names[] = { "none", "hit", "ignored" };
+    AVBPrint bp;
+    int ret;
+
+    av_bprint_init(&bp, 0, AV_BPRINT_SIZE_UNLIMITED);
+    ret = open_input(filename, cache_dir, &bp);
+    if (ret >= 0 && cache_event != expected) {
+        fprintf(stderr, "%s: cache event %s, expected %s\n", step,
+                event_names[cache_event], event_names[expected]);
+        ret = -1;
+    }
+    if (ret >= 0 && strcmp(bp.str, reference)) {
+        fprintf(stderr, "%s: stream parameters differ\nexpected:\n%sgot:\n%s",
+                step, reference, bp.str);
+        ret = -1;
+    }
+    if (ret >= 0)
+        printf("%s: ok\n", step);
+    av_bprint_finalize(&bp, NULL);
+    return ret;
+}
+
+static int corrupt_entry(const char *entry, int truncate)
+{
+    char buf[4096];
+    size_t size;
+    FILE *f;
+
+    if (!(f = fopen(entry, "rb")))
+        return AVERROR(errno);
+    size = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+
+    if (truncate) {
+        /* cut at a line boundary, so that no value is altered */
+        size /= 2;
+        while (size > 0 && buf[size - 1] != '\n')
+            size--;
+    } else {
+        size_t i;
+        for (i = 0; i < size; i++)
+            buf[i] = buf[i] == '\n' ? '\n' : buf[i] ^ 0x5a;
+    }
+
+    if (!(f = fopen(entry, "wb")))
+        return AVERROR(errno);
+    fwrite(buf, 1, size, f);
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    AVBPrint reference;
+    const char *filename, *cache_dir;
+    int i, ret;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <input> <cache directory>\n", argv[0]);
+        return 1;
+    }
+    filename  = argv[1];
+    cache_dir = argv[2];
+
+    av_log_set_callback(log_callback);
+
+    if (mkdir(cache_dir, 0777) < 0 && errno != EEXIST) {
+        fprintf(stderr, "Cannot create %s\n", cache_dir);
+        return 1;
+    }
+
+    av_bprint_init(&reference, 0, AV_BPRINT_SIZE_UNLIMITED);
+
+    /* start without an entry: create one if an earlier run left none, so
+     * that its name is known, and remove it */
+    for (i = 0; i < 2; i++) {
+        if (open_input(filename, cache_dir, &reference) < 0)
+            return 1;
+        if (cache_event == CACHE_HIT)
+            break;
+    }
+    if (cache_event != CACHE_HIT || remove(cache_entry) < 0) {
+        fprintf(stderr, "Cannot clear the probe cache entry\n");
+        return 1;
+    }
+
+    av_bprint_clear(&reference);
+    if (open_input(filename, NULL, &reference) < 0)
+        return 1;
+
+    ret = check_open("miss", filename, cache_dir, reference.str, CACHE_NONE);
+    if (ret >= 0)
+        ret = check_open("hit", filename, cache_dir, reference.str, CACHE_HIT);
+
+    if (ret >= 0)
+        ret = corrupt_entry(cache_entry, 1);
+    if (ret >= 0)
+        ret = check_open("truncated", filename, cache_dir, reference.str, CACHE_IGNORED);
+    if (ret >= 0)
+        ret = check_open("rewritten", filename, cache_dir, reference.str, CACHE_HIT);
+
+    if (ret >= 0)
+        ret = corrupt_entry(cache_entry, 0);
+    if (ret >= 0)
+        ret = check_open("garbage", filename, cache_dir, reference.str, CACHE_IGNORED);
+    if (ret >= 0)
+        ret = check_open("rewritten", filename, cache_dir, reference.str, CACHE_HIT);
+
+    av_bprint_finalize(&reference, NULL);
+    return ret < 0;
+}
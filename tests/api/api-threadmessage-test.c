@@ -22,12 +22,16 @@
  * Thread message API test
  */
 
+#include <string.h>
+
 #include "libavutil/avassert.h"
 #include "libavutil/avstring.h"
 #include "libavutil/frame.h"
 #include "libavutil/threadmessage.h"
 #include "libavutil/thread.h" // not public
 
+static int spsc;
+
 struct sender_data {
     int id;
     pthread_t tid;
@@ -66,7 +70,8 @@ static void *sender_thread(void *arg)
 
     av_log(NULL, AV_LOG_INFO, "sender #%d: workload=%d\n", wd->id, wd->workload);
     for (i = 0; i < wd->workload; i++) {
-        if (rand() % wd->workload < wd->workload / 10) {
+        /* an SPSC queue can only be flushed by the receiver */
+        if (!spsc && rand() % wd->workload < wd->workload / 10) {
             av_log(NULL, AV_LOG_INFO, "sender #%d: flushing the queue\n", wd->id);
             av_thread_message_flush(wd->queue);
         } else {
@@ -171,12 +176,13 @@ int main(int ac, char **av)
     struct receiver_data *receivers;
     AVThreadMessageQueue *queue = NULL;
 
-    if (ac != 8) {
+    if (ac != 8 && !(ac == 9 && !strcmp(av[8], "spsc"))) {
         av_log(NULL, AV_LOG_ERROR, "%s <max_queue_size> "
                "<nb_senders> <sender_min_send> <sender_max_send> "
-               "<nb_receivers> <receiver_min_recv> <receiver_max_recv>\n", av[0]);
+               "<nb_receivers> <receiver_min_recv> <receiver_max_recv> [spsc]\n", av[0]);
         return 1;
     }
+    spsc = ac == 9;
 
     max_queue_size    = atoi(av[1]);
     nb_senders        = atoi(av[2]);
@@ -192,6 +198,10 @@ int main(int ac, char **av)
         av_log(NULL, AV_LOG_ERROR, "negative values not allowed\n");
         return 1;
     }
+    if (spsc && (nb_senders != 1 || nb_receivers != 1)) {
+        av_log(NULL, AV_LOG_ERROR, "spsc needs exactly one sender and one receiver\n");
+        return 1;
+    }
 
     av_log(NULL, AV_LOG_INFO, "qsize:%d / %d senders sending [%d-%d] / "
            "%d receivers receiving [%d-%d]\n", max_queue_size,
@@ -205,7 +215,8 @@ int main(int ac, char **av)
         goto end;
     }
 
-    ret = av_thread_message_queue_alloc(&queue, max_queue_size, sizeof(struct message));
+    ret = av_thread_message_queue_alloc2(&queue, max_queue_size, sizeof(struct message),
+                                         spsc ? AV_THREAD_MESSAGE_QUEUE_FLAG_SPSC : 0);
     if (ret < 0)
         goto end;
 
@@ -0,0 +1,59 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <float.h>
+#include "checkasm.h"
+#include "libavfilter/af_anlmdndsp.h"
+
+#define MAX_K 128
+#define LEN (2 * MAX_K + 1)
+
+static void check_compute_distance_ssd(const AudioNLMDNDSPContext *dsp)
+{
+    LOCAL_ALIGNED_32(float, f1, [LEN]);
+    LOCAL_ALIGNED_32(float, f2, [LEN]);
+    /* odd patch sizes exercise the scalar tail */
+    ptrdiff_t K = MAX_K - (rnd() & 15);
+    float res_ref, res_new;
+    int i;
+
+    declare_func_float(float, const float *f1, const float *f2, ptrdiff_t K);
+
+    for (i = 0; i < LEN; i++) {
+        f1[i] = (rnd() & 0xFFFF) / 32768.0f - 1.0f;
+        f2[i] = (rnd() & 0xFFFF) / 32768.0f - 1.0f;
+    }
+
+    if (check_func(dsp->compute_distance_ssd, "compute_distance_ssd")) {
+        res_ref = call_ref(f1 + MAX_K, f2 + MAX_K, K);
+        res_new = call_new(f1 + MAX_K, f2 + MAX_K, K);
+        if (!float_near_abs_eps(res_ref, res_new, res_ref * 4 * K * FLT_EPSILON))
+            fail();
+        bench_new(f1 + MAX_K, f2 + MAX_K, MAX_K);
+    }
+}
+
+void checkasm_check_af_anlmdn(void)
+{
+    AudioNLMDNDSPContext dsp;
+
+    ff_anlmdn_init(&dsp);
+
+    check_compute_distance_ssd(&dsp);
+    report("compute_distance_ssd");
+}
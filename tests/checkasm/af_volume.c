@@ -0,0 +1,100 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/af_volume.h"
+
+#define LEN 256
+
+static void check_scale_samples_s16(void)
+{
+    LOCAL_ALIGNED_32(int16_t, src,     [LEN]);
+    LOCAL_ALIGNED_32(int16_t, dst_ref, [LEN]);
+    LOCAL_ALIGNED_32(int16_t, dst_new, [LEN]);
+    VolumeContext vol = { 0 };
+    int i, len;
+
+    declare_func(void, uint8_t *dst, const uint8_t *src, int nb_samples,
+                 int volume);
+
+    vol.sample_fmt = AV_SAMPLE_FMT_S16;
+    /* the SIMD version multiplies in 16 bits */
+    vol.volume_i   = rnd() & 0x7FFF;
+    ff_volume_init(&vol);
+    len = FFALIGN(LEN - (rnd() & 31), vol.samples_align);
+
+    for (i = 0; i < LEN; i++)
+        src[i] = rnd();
+    memset(dst_ref, 0, LEN * sizeof(*dst_ref));
+    memset(dst_new, 0, LEN * sizeof(*dst_new));
+
+    if (check_func(vol.scale_samples, "scale_samples_s16")) {
+        call_ref((uint8_t *)dst_ref, (const uint8_t *)src, len, vol.volume_i);
+        call_new((uint8_t *)dst_new, (const uint8_t *)src, len, vol.volume_i);
+        if (memcmp(dst_ref, dst_new, len * sizeof(*dst_ref)))
+            fail();
+        bench_new((uint8_t *)dst_new, (const uint8_t *)src, LEN, vol.volume_i);
+    }
+}
+
+static void check_scale_samples_s32(void)
+{
+    LOCAL_ALIGNED_32(int32_t, src,     [LEN]);
+    LOCAL_ALIGNED_32(int32_t, dst_ref, [LEN]);
+    LOCAL_ALIGNED_32(int32_t, dst_new, [LEN]);
+    VolumeContext vol = { 0 };
+    int i, len;
+
+    declare_func(void, uint8_t *dst, const uint8_t *src, int nb_samples,
+                 int volume);
+
+    vol.sample_fmt = AV_SAMPLE_FMT_S32;
+    vol.volume_i   = rnd() & 0xFFFF;
+    ff_volume_init(&vol);
+    len = FFALIGN(LEN - (rnd() & 31), vol.samples_align);
+
+    for (i = 0; i < LEN; i++)
+        src[i] = rnd();
+    memset(dst_ref, 0, LEN * sizeof(*dst_ref));
+    memset(dst_new, 0, LEN * sizeof(*dst_new));
+
+    if (check_func(vol.scale_samples, "scale_samples_s32")) {
+        call_ref((uint8_t *)dst_ref, (const uint8_t *)src, len, vol.volume_i);
+        call_new((uint8_t *)dst_new, (const uint8_t *)src, len, vol.volume_i);
+        /* The SIMD versions round ties to even through doubles, and the
+         * ssse3 one clips to -INT_MAX, so allow an off-by-one. */
+        for (i = 0; i < len; i++) {
+            if (llabs((int64_t)dst_ref[i] - dst_new[i]) > 1) {
+                fail();
+                break;
+            }
+        }
+        bench_new((uint8_t *)dst_new, (const uint8_t *)src, LEN, vol.volume_i);
+    }
+}
+
+void checkasm_check_af_volume(void)
+{
+    check_scale_samples_s16();
+    report("scale_samples_s16");
+
+    check_scale_samples_s32();
+    report("scale_samples_s32");
+}
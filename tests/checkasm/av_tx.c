@@ -0,0 +1,87 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <float.h>
+#include <string.h>
+
+#include "libavutil/internal.h"
+#include "libavutil/mem.h"
+#include "libavutil/tx_priv.h"
+#include "checkasm.h"
+
+/* pass() combines 8n complex values using 2n + 1 twiddles; these are the
+ * smallest (32-point transform), a medium and the largest n used by tx */
+static const unsigned int pass_sizes[] = { 4, 64, 16384 };
+#define MAX_N 16384
+
+#define randomize(buf, len)                                 \
+    do {                                                    \
+        for (int i = 0; i < len; i++)                       \
+            buf[i] = (int32_t)rnd() / (double)INT32_MAX;    \
+    } while (0)
+
+#define CHECK_PASS(type, AVComplex, n, eps)                                     \
+    do {                                                                        \
+        AVComplex *z_ref = av_malloc_array(8 * MAX_N, sizeof(*z_ref));         \
+        AVComplex *z_new = av_malloc_array(8 * MAX_N, sizeof(*z_new));         \
+        type *wre = av_malloc_array(2 * MAX_N + 1, sizeof(*wre));               \
+        type *ref = (type *)z_ref, *new = (type *)z_new;                        \
+                                                                                \
+        declare_func(void, AVComplex *z, const type *wre, unsigned int n);      \
+                                                                                \
+        if (!z_ref || !z_new || !wre)                                           \
+            fail();                                                             \
+        else {                                                                  \
+            randomize(ref, 16 * n);                                             \
+            randomize(wre, 2 * n + 1);                                          \
+            wre[0] = 1.0; /* the first butterfly assumes a twiddle of 1 */     \
+            wre[2 * n] = 0.0;                                                   \
+            memcpy(new, ref, 16 * n * sizeof(*ref));                            \
+            call_ref(z_ref, wre, n);                                            \
+            call_new(z_new, wre, n);                                            \
+            for (int i = 0; i < 16 * n; i++) {                                  \
+                if (!type##_near_abs_eps(ref[i], new[i], eps)) {                \
+                    fprintf(stderr, "%d: %- .12f - %- .12f = % .12g\n",         \
+                            i, ref[i], new[i], ref[i] - new[i]);                \
+                    fail();                                                     \
+                    break;                                                      \
+                }                                                               \
+            }                                                                   \
+            bench_new(z_new, wre, n);                                           \
+        }                                                                       \
+        av_free(z_ref);                                                         \
+        av_free(z_new);                                                         \
+        av_free(wre);                                                           \
+    } while (0)
+
+void checkasm_check_av_tx(void)
+{
+    TXDSPContext c;
+
+    ff_txdsp_init(&c);
+
+    for (int i = 0; i < FF_ARRAY_ELEMS(pass_sizes); i++) {
+        unsigned int n = pass_sizes[i];
+
+        if (check_func(c.pass_float, "tx_pass_float_%u", n))
+            CHECK_PASS(float, AVComplexFloat, n, 16 * FLT_EPSILON);
+        if (check_func(c.pass_double, "tx_pass_double_%u", n))
+            CHECK_PASS(double, AVComplexDouble, n, 16 * DBL_EPSILON);
+    }
+    report("tx_pass");
+}
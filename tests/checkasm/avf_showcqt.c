@@ -0,0 +1,133 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/avf_showcqt.h"
+
+#define FFT_LEN   1024
+#define CQT_LEN   32
+#define COEFF_MAX 64
+
+static float randf(void)
+{
+    return (float)rnd() / (float)UINT_MAX * 2.0f - 1.0f;
+}
+
+/* Same as cqt_calc() in avf_showcqt.c. checkasm would compare against the
+ * last version that passed, which may expect another coefficient order. */
+static void cqt_calc_c(FFTComplex *dst, const FFTComplex *src,
+                       const Coeffs *coeffs, int len, int fft_len)
+{
+    int k, x, i, j;
+
+    for (k = 0; k < len; k++) {
+        FFTComplex l, r, a = { 0, 0 }, b = { 0, 0 };
+
+        for (x = 0; x < coeffs[k].len; x++) {
+            FFTSample u = coeffs[k].val[x];
+            i = coeffs[k].start + x;
+            j = fft_len - i;
+            a.re += u * src[i].re;
+            a.im += u * src[i].im;
+            b.re += u * src[j].re;
+            b.im += u * src[j].im;
+        }
+
+        l.re = a.re + b.re;
+        l.im = a.im - b.im;
+        r.re = b.im + a.im;
+        r.im = b.re - a.re;
+        dst[k].re = l.re * l.re + l.im * l.im;
+        dst[k].im = r.re * r.re + r.im * r.im;
+    }
+}
+
+static void check_cqt_calc(const ShowCQTContext *s)
+{
+    LOCAL_ALIGNED_32(FFTComplex, src,       [FFT_LEN]);
+    LOCAL_ALIGNED_32(FFTComplex, dst_ref,   [CQT_LEN]);
+    LOCAL_ALIGNED_32(FFTComplex, dst_new,   [CQT_LEN]);
+    LOCAL_ALIGNED_32(float,      val_ref,   [CQT_LEN * COEFF_MAX]);
+    LOCAL_ALIGNED_32(float,      val_new,   [CQT_LEN * COEFF_MAX]);
+    Coeffs coeffs_ref[CQT_LEN], coeffs_new[CQT_LEN];
+    float tol[CQT_LEN];
+    int k, x;
+
+    declare_func(void, FFTComplex *dst, const FFTComplex *src,
+                 const Coeffs *coeffs, int len, int fft_len);
+
+    for (k = 0; k < FFT_LEN; k++) {
+        src[k].re = randf();
+        src[k].im = randf();
+    }
+    for (k = 0; k < CQT_LEN * COEFF_MAX; k++)
+        val_ref[k] = randf();
+    memcpy(val_new, val_ref, CQT_LEN * COEFF_MAX * sizeof(*val_ref));
+
+    for (k = 0; k < CQT_LEN; k++) {
+        /* bins start and end on multiples of the SIMD alignment */
+        int start = (16 + rnd() % 256) & ~(s->cqt_align - 1);
+        int len   = FFALIGN(1 + rnd() % COEFF_MAX, s->cqt_align);
+        float sum = 0.0f;
+
+        len = FFMIN(len, COEFF_MAX);
+        coeffs_ref[k].val   = val_ref + k * COEFF_MAX;
+        coeffs_new[k].val   = val_new + k * COEFF_MAX;
+        coeffs_ref[k].start = coeffs_new[k].start = start;
+        coeffs_ref[k].len   = coeffs_new[k].len   = len;
+        if (s->permute_coeffs)
+            s->permute_coeffs(coeffs_new[k].val, len);
+
+        /* the SIMD versions accumulate in a different order */
+        for (x = 0; x < len; x++) {
+            const FFTComplex *a = &src[start + x], *b = &src[FFT_LEN - start - x];
+            sum += fabsf(coeffs_ref[k].val[x]) *
+                   (fabsf(a->re) + fabsf(a->im) + fabsf(b->re) + fabsf(b->im));
+        }
+        tol[k] = 16 * len * FLT_EPSILON * sum * sum + FLT_EPSILON;
+    }
+    memset(dst_ref, 0, CQT_LEN * sizeof(*dst_ref));
+    memset(dst_new, 0, CQT_LEN * sizeof(*dst_new));
+
+    if (check_func(s->cqt_calc, "cqt_calc")) {
+        cqt_calc_c(dst_ref, src, coeffs_ref, CQT_LEN, FFT_LEN);
+        call_new(dst_new, src, coeffs_new, CQT_LEN, FFT_LEN);
+        for (k = 0; k < CQT_LEN; k++) {
+            if (!float_near_abs_eps(dst_ref[k].re, dst_new[k].re, tol[k]) ||
+                !float_near_abs_eps(dst_ref[k].im, dst_new[k].im, tol[k])) {
+                fail();
+                break;
+            }
+        }
+        bench_new(dst_new, src, coeffs_new, CQT_LEN, FFT_LEN);
+    }
+}
+
+void checkasm_check_avf_showcqt(void)
+{
+    ShowCQTContext s = { 0 };
+
+    ff_showcqt_init(&s);
+
+    check_cqt_calc(&s);
+    report("cqt_calc");
+}
@@ -116,6 +116,7 @@ static const struct {
     #if CONFIG_HEVC_DECODER
         { "hevc_add_res", checkasm_check_hevc_add_res },
         { "hevc_idct", checkasm_check_hevc_idct },
+        { "hevc_pred", checkasm_check_hevc_pred },
         { "hevc_sao", checkasm_check_hevc_sao },
     #endif
     #if CONFIG_HUFFYUV_DECODER
@@ -136,6 +137,9 @@ static const struct {
     #if CONFIG_PIXBLOCKDSP
         { "pixblockdsp", checkasm_check_pixblockdsp },
     #endif
+    #if CONFIG_PRORES_KS_ENCODER
+        { "proresencdsp", checkasm_check_proresencdsp },
+    #endif
     #if CONFIG_UTVIDEO_DECODER
         { "utvideodsp", checkasm_check_utvideodsp },
     #endif
@@ -159,33 +163,106 @@ static const struct {
     #if CONFIG_AFIR_FILTER
         { "af_afir", checkasm_check_afir },
     #endif
+    #if CONFIG_ANLMDN_FILTER
+        { "af_anlmdn", checkasm_check_af_anlmdn },
+    #endif
+    #if CONFIG_VOLUME_FILTER
+        { "af_volume", checkasm_check_af_volume },
+    #endif
+    #if CONFIG_SHOWCQT_FILTER
+        { "avf_showcqt", checkasm_check_avf_showcqt },
+    #endif
+    #if CONFIG_SCENE_SAD
+        { "scene_sad", checkasm_check_scene_sad },
+    #endif
+    #if CONFIG_ATADENOISE_FILTER
+        { "vf_atadenoise", checkasm_check_vf_atadenoise },
+    #endif
     #if CONFIG_BLEND_FILTER
         { "vf_blend", checkasm_check_blend },
     #endif
+    #if CONFIG_BWDIF_FILTER
+        { "vf_bwdif", checkasm_check_vf_bwdif },
+    #endif
     #if CONFIG_COLORSPACE_FILTER
         { "vf_colorspace", checkasm_check_colorspace },
     #endif
+    #if CONFIG_CONVOLUTION_FILTER
+        { "vf_convolution", checkasm_check_vf_convolution },
+    #endif
     #if CONFIG_EQ_FILTER
         { "vf_eq", checkasm_check_vf_eq },
     #endif
+    #if CONFIG_FRAMERATE_FILTER
+        { "vf_framerate", checkasm_check_vf_framerate },
+    #endif
+    #if CONFIG_FSPP_FILTER
+        { "vf_fspp", checkasm_check_vf_fspp },
+    #endif
     #if CONFIG_GBLUR_FILTER
         { "vf_gblur", checkasm_check_vf_gblur },
     #endif
+    #if CONFIG_GRADFUN_FILTER
+        { "vf_gradfun", checkasm_check_vf_gradfun },
+    #endif
     #if CONFIG_HFLIP_FILTER
         { "vf_hflip", checkasm_check_vf_hflip },
     #endif
+    #if CONFIG_IDET_FILTER
+        { "vf_idet", checkasm_check_vf_idet },
+    #endif
+    #if CONFIG_LIMITER_FILTER
+        { "vf_limiter", checkasm_check_vf_limiter },
+    #endif
+    #if CONFIG_MASKEDCLAMP_FILTER
+        { "vf_maskedclamp", checkasm_check_vf_maskedclamp },
+    #endif
+    #if CONFIG_MASKEDMERGE_FILTER
+        { "vf_maskedmerge", checkasm_check_vf_maskedmerge },
+    #endif
     #if CONFIG_NLMEANS_FILTER
         { "vf_nlmeans", checkasm_check_nlmeans },
     #endif
+    #if CONFIG_PP7_FILTER
+        { "vf_pp7", checkasm_check_vf_pp7 },
+    #endif
+    #if CONFIG_PSNR_FILTER
+        { "vf_psnr", checkasm_check_vf_psnr },
+    #endif
+    #if CONFIG_PULLUP_FILTER
+        { "vf_pullup", checkasm_check_vf_pullup },
+    #endif
+    #if CONFIG_SSIM_FILTER
+        { "vf_ssim", checkasm_check_vf_ssim },
+    #endif
+    #if CONFIG_STEREO3D_FILTER
+        { "vf_stereo3d", checkasm_check_vf_stereo3d },
+    #endif
     #if CONFIG_THRESHOLD_FILTER
         { "vf_threshold", checkasm_check_vf_threshold },
     #endif
+    #if CONFIG_TINTERLACE_FILTER
+        { "vf_tinterlace", checkasm_check_vf_tinterlace },
+    #endif
+    #if CONFIG_TRANSPOSE_FILTER
+        { "vf_transpose", checkasm_check_vf_transpose },
+    #endif
+    #if CONFIG_V360_FILTER
+        { "vf_v360", checkasm_check_vf_v360 },
+    #endif
+    #if CONFIG_W3FDIF_FILTER
+        { "vf_w3fdif", checkasm_check_vf_w3fdif },
+    #endif
+    #if CONFIG_YADIF_FILTER
+        { "vf_yadif", checkasm_check_vf_yadif },
+    #endif
 #endif
 #if CONFIG_SWSCALE
     { "sw_rgb", checkasm_check_sw_rgb },
     { "sw_scale", checkasm_check_sw_scale },
 #endif
 #if CONFIG_AVUTIL
+        { "av_tx", checkasm_check_av_tx },
         { "fixed_dsp", checkasm_check_fixed_dsp },
         { "float_dsp", checkasm_check_float_dsp },
 #endif
@@ -259,6 +336,8 @@ static struct {
     const char *current_test_name;
     const char *bench_pattern;
     int bench_pattern_len;
+    int csv;
+    int tsv;
     int num_checked;
     int num_failed;
 
@@ -493,7 +572,12 @@ static void print_benchs(CheckasmFunc *f)
                 CheckasmPerf *p = &v->perf;
                 if (p->iterations) {
                     int decicycles = (10*p->cycles/p->iterations - state.nop_time) / 4;
-                    printf("%s_%s: %d.%d\n", f->name, cpu_suffix(v->cpu), decicycles/10, decicycles%10);
+                    if (state.csv || state.tsv) {
+                        const char sep = state.csv ? ',' : '\t';
+                        printf("%s%c%s%c%d.%d\n", f->name, sep, cpu_suffix(v->cpu), sep,
+                               decicycles/10, decicycles%10);
+                    } else
+                        printf("%s_%s: %d.%d\n", f->name, cpu_suffix(v->cpu), decicycles/10, decicycles%10);
                 }
             } while ((v = v->next));
         }
@@ -615,7 +699,8 @@ static int bench_init_linux(void)
         .exclude_hv     = 1,
     };
 
-    printf("benchmarking with Linux Perf Monitoring API\n");
+    if (!state.csv && !state.tsv)
+        printf("benchmarking with Linux Perf Monitoring API\n");
 
     state.sysfd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
     if (state.sysfd == -1) {
@@ -630,7 +715,8 @@ static int bench_init_linux(void)
 static int bench_init_ffmpeg(void)
 {
 #ifdef AV_READ_TIME
-    printf("benchmarking with native FFmpeg timers\n");
+    if (!state.csv && !state.tsv)
+        printf("benchmarking with native FFmpeg timers\n");
     return 0;
 #else
     fprintf(stderr, "checkasm: --bench is not supported on your system\n");
@@ -650,7 +736,10 @@ static int bench_init(void)
         return ret;
 
     state.nop_time = measure_nop_time();
-    printf("nop: %d.%d\n", state.nop_time/10, state.nop_time%10);
+    if (state.csv || state.tsv)
+        printf("name%cversion%ccycles\n", state.csv ? ',' : '\t', state.csv ? ',' : '\t');
+    else
+        printf("nop: %d.%d\n", state.nop_time/10, state.nop_time%10);
     return 0;
 }
 
@@ -679,8 +768,6 @@ int main(int argc, char *argv[])
 
     while (argc > 1) {
         if (!strncmp(argv[1], "--bench", 7)) {
-            if (bench_init() < 0)
-                return 1;
             if (argv[1][7] == '=') {
                 state.bench_pattern = argv[1] + 8;
                 state.bench_pattern_len = strlen(state.bench_pattern);
@@ -688,6 +775,12 @@ int main(int argc, char *argv[])
                 state.bench_pattern = "";
         } else if (!strncmp(argv[1], "--test=", 7)) {
             state.test_name = argv[1] + 7;
+        } else if (!strcmp(argv[1], "--csv")) {
+            state.csv = 1;
+            state.tsv = 0;
+        } else if (!strcmp(argv[1], "--tsv")) {
+            state.csv = 0;
+            state.tsv = 1;
         } else if (!strcmp(argv[1], "--verbose") || !strcmp(argv[1], "-v")) {
             state.verbose = 1;
         } else {
@@ -698,6 +791,9 @@ int main(int argc, char *argv[])
         argv++;
     }
 
+    if (state.bench_pattern && bench_init() < 0)
+        return 1;
+
     fprintf(stderr, "checkasm: using random seed %u\n", seed);
     av_lfg_init(&checkasm_lfg, seed);
 
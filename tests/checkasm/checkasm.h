@@ -40,9 +40,13 @@
 #include "libavutil/timer.h"
 
 void checkasm_check_aacpsdsp(void);
+void checkasm_check_af_anlmdn(void);
+void checkasm_check_af_volume(void);
 void checkasm_check_afir(void);
 void checkasm_check_alacdsp(void);
 void checkasm_check_audiodsp(void);
+void checkasm_check_av_tx(void);
+void checkasm_check_avf_showcqt(void);
 void checkasm_check_blend(void);
 void checkasm_check_blockdsp(void);
 void checkasm_check_bswapdsp(void);
@@ -58,6 +62,7 @@ void checkasm_check_h264pred(void);
 void checkasm_check_h264qpel(void);
 void checkasm_check_hevc_add_res(void);
 void checkasm_check_hevc_idct(void);
+void checkasm_check_hevc_pred(void);
 void checkasm_check_hevc_sao(void);
 void checkasm_check_huffyuvdsp(void);
 void checkasm_check_jpeg2000dsp(void);
@@ -66,17 +71,39 @@ void checkasm_check_llviddspenc(void);
 void checkasm_check_nlmeans(void);
 void checkasm_check_opusdsp(void);
 void checkasm_check_pixblockdsp(void);
+void checkasm_check_proresencdsp(void);
 void checkasm_check_sbrdsp(void);
+void checkasm_check_scene_sad(void);
 void checkasm_check_synth_filter(void);
 void checkasm_check_sw_rgb(void);
 void checkasm_check_sw_scale(void);
 void checkasm_check_utvideodsp(void);
 void checkasm_check_v210dec(void);
 void checkasm_check_v210enc(void);
+void checkasm_check_vf_atadenoise(void);
+void checkasm_check_vf_bwdif(void);
+void checkasm_check_vf_convolution(void);
 void checkasm_check_vf_eq(void);
+void checkasm_check_vf_framerate(void);
+void checkasm_check_vf_fspp(void);
 void checkasm_check_vf_gblur(void);
+void checkasm_check_vf_gradfun(void);
 void checkasm_check_vf_hflip(void);
+void checkasm_check_vf_idet(void);
+void checkasm_check_vf_limiter(void);
+void checkasm_check_vf_maskedclamp(void);
+void checkasm_check_vf_maskedmerge(void);
+void checkasm_check_vf_pp7(void);
+void checkasm_check_vf_psnr(void);
+void checkasm_check_vf_pullup(void);
+void checkasm_check_vf_ssim(void);
+void checkasm_check_vf_stereo3d(void);
 void checkasm_check_vf_threshold(void);
+void checkasm_check_vf_tinterlace(void);
+void checkasm_check_vf_transpose(void);
+void checkasm_check_vf_v360(void);
+void checkasm_check_vf_w3fdif(void);
+void checkasm_check_vf_yadif(void);
 void checkasm_check_vp8dsp(void);
 void checkasm_check_vp9dsp(void);
 void checkasm_check_videodsp(void);
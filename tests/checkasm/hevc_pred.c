@@ -0,0 +1,175 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "libavutil/intreadwrite.h"
+
+#include "libavcodec/hevcpred.h"
+
+#include "checkasm.h"
+
+#define SIZEOF_PIXEL ((bit_depth + 7) / 8)
+#define MAX_SIZE 32
+/* the stride is given in pixels */
+#define STRIDE MAX_SIZE
+#define BUF_SIZE (STRIDE * MAX_SIZE * 2)
+/* room for the corner sample, 2 * size neighbours and overreads */
+#define EDGE_SIZE (4 * MAX_SIZE)
+
+#define randomize_edges(top, left, size)                        \
+    do {                                                        \
+        int k;                                                  \
+        for (k = 0; k < size; k++) {                            \
+            int t = rnd() & ((1 << bit_depth) - 1);             \
+            int l = rnd() & ((1 << bit_depth) - 1);             \
+            if (bit_depth == 8) {                               \
+                top[k]  = t;                                    \
+                left[k] = l;                                    \
+            } else {                                            \
+                AV_WN16A(top  + 2 * k, t);                      \
+                AV_WN16A(left + 2 * k, l);                      \
+            }                                                   \
+        }                                                       \
+        /* top[-1] and left[-1] are the same corner sample */   \
+        memcpy(left, top, SIZEOF_PIXEL);                        \
+    } while (0)
+
+static void check_pred_planar(HEVCPredContext *h, uint8_t *top, uint8_t *left,
+                              int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [BUF_SIZE]);
+    int i;
+
+    declare_func(void, uint8_t *src, const uint8_t *top,
+                 const uint8_t *left, ptrdiff_t stride);
+
+    for (i = 0; i < 4; i++) {
+        int size = 4 << i;
+
+        if (check_func(h->pred_planar[i], "hevc_pred_planar_%dx%d_%d",
+                       size, size, bit_depth)) {
+            memset(dst0, 0, BUF_SIZE);
+            memset(dst1, 0, BUF_SIZE);
+            call_ref(dst0, top, left, STRIDE);
+            call_new(dst1, top, left, STRIDE);
+            if (memcmp(dst0, dst1, BUF_SIZE))
+                fail();
+            bench_new(dst1, top, left, STRIDE);
+        }
+    }
+}
+
+static void check_pred_dc(HEVCPredContext *h, uint8_t *top, uint8_t *left,
+                          int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [BUF_SIZE]);
+    int log2_size, c_idx;
+
+    declare_func(void, uint8_t *src, const uint8_t *top, const uint8_t *left,
+                 ptrdiff_t stride, int log2_size, int c_idx);
+
+    for (log2_size = 2; log2_size <= 5; log2_size++) {
+        for (c_idx = 0; c_idx <= 1; c_idx++) {
+            int size = 1 << log2_size;
+
+            if (check_func(h->pred_dc, "hevc_pred_dc_%dx%d_%s_%d", size, size,
+                           c_idx ? "chroma" : "luma", bit_depth)) {
+                memset(dst0, 0, BUF_SIZE);
+                memset(dst1, 0, BUF_SIZE);
+                call_ref(dst0, top, left, STRIDE, log2_size, c_idx);
+                call_new(dst1, top, left, STRIDE, log2_size, c_idx);
+                if (memcmp(dst0, dst1, BUF_SIZE))
+                    fail();
+                bench_new(dst1, top, left, STRIDE, log2_size, c_idx);
+            }
+        }
+    }
+}
+
+static void check_pred_angular(HEVCPredContext *h, uint8_t *top, uint8_t *left,
+                               int bit_depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, dst0, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst1, [BUF_SIZE]);
+    int i, mode;
+
+    declare_func(void, uint8_t *src, const uint8_t *top, const uint8_t *left,
+                 ptrdiff_t stride, int c_idx, int mode);
+
+    for (i = 0; i < 4; i++) {
+        int size = 4 << i;
+
+        for (mode = 2; mode <= 34; mode++) {
+            if (check_func(h->pred_angular[i], "hevc_pred_angular_%dx%d_%d_%d",
+                           size, size, mode, bit_depth)) {
+                memset(dst0, 0, BUF_SIZE);
+                memset(dst1, 0, BUF_SIZE);
+                call_ref(dst0, top, left, STRIDE, 0, mode);
+                call_new(dst1, top, left, STRIDE, 0, mode);
+                if (memcmp(dst0, dst1, BUF_SIZE))
+                    fail();
+                bench_new(dst1, top, left, STRIDE, 0, mode);
+            }
+        }
+    }
+}
+
+void checkasm_check_hevc_pred(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, top_buf,  [EDGE_SIZE * 2]);
+    LOCAL_ALIGNED_32(uint8_t, left_buf, [EDGE_SIZE * 2]);
+    int bit_depth;
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        /* the functions are called with top/left pointing just past the
+         * corner sample, as in the decoder */
+        uint8_t *top  = top_buf  + SIZEOF_PIXEL;
+        uint8_t *left = left_buf + SIZEOF_PIXEL;
+        HEVCPredContext h;
+
+        randomize_edges(top_buf, left_buf, EDGE_SIZE);
+        ff_hevc_pred_init(&h, bit_depth);
+        check_pred_planar(&h, top, left, bit_depth);
+    }
+    report("pred_planar");
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        uint8_t *top  = top_buf  + SIZEOF_PIXEL;
+        uint8_t *left = left_buf + SIZEOF_PIXEL;
+        HEVCPredContext h;
+
+        randomize_edges(top_buf, left_buf, EDGE_SIZE);
+        ff_hevc_pred_init(&h, bit_depth);
+        check_pred_dc(&h, top, left, bit_depth);
+    }
+    report("pred_dc");
+
+    for (bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+        uint8_t *top  = top_buf  + SIZEOF_PIXEL;
+        uint8_t *left = left_buf + SIZEOF_PIXEL;
+        HEVCPredContext h;
+
+        randomize_edges(top_buf, left_buf, EDGE_SIZE);
+        ff_hevc_pred_init(&h, bit_depth);
+        check_pred_angular(&h, top, left, bit_depth);
+    }
+    report("pred_angular");
+}
@@ -101,6 +101,30 @@ static void check_sub_left_pred(LLVidEncDSPContext *c)
     }
 }
 
+static void check_sum_abs_int8(LLVidEncDSPContext *c)
+{
+    int i;
+    LOCAL_ALIGNED_32(uint8_t, src, [MAX_STRIDE + 4]);
+
+    declare_func(int, const uint8_t *src, intptr_t w);
+
+    randomize_buffers(src, MAX_STRIDE + 4);
+    /* make sure the extreme values are covered */
+    src[1] = 0x80;
+    src[2] = 0x7f;
+
+    if (check_func(c->sum_abs_int8, "sum_abs_int8")) {
+        for (i = 0; i < 5; i++) {
+            /* the PNG encoder passes the unaligned data after the filter byte */
+            if (call_ref(src + 1, planes[i].w) != call_new(src + 1, planes[i].w))
+                fail();
+            if (call_ref(src, planes[i].s) != call_new(src, planes[i].s))
+                fail();
+        }
+        bench_new(src + 1, planes[4].w);
+    }
+}
+
 void checkasm_check_llviddspenc(void)
 {
     LLVidEncDSPContext c;
@@ -111,4 +135,7 @@ void checkasm_check_llviddspenc(void)
 
     check_sub_left_pred(&c);
     report("sub_left_predict");
+
+    check_sum_abs_int8(&c);
+    report("sum_abs_int8");
 }
@@ -0,0 +1,70 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+
+#include "libavcodec/proresencdsp.h"
+#include "libavutil/mem.h"
+
+#include "checkasm.h"
+
+/* 8 macroblocks of 4 blocks, the largest slice of the encoder */
+#define MAX_BLOCKS 32
+
+static void check_quantize(ProresEncDSPContext *c)
+{
+    LOCAL_ALIGNED_16(int16_t, src,  [MAX_BLOCKS * 64]);
+    LOCAL_ALIGNED_16(int16_t, dst0, [MAX_BLOCKS * 64]);
+    LOCAL_ALIGNED_16(int16_t, dst1, [MAX_BLOCKS * 64]);
+    int16_t qmat[64];
+    int i, nb_blocks;
+
+    declare_func(int, int16_t *dst, const int16_t *src, const int16_t *qmat,
+                 int nb_blocks);
+
+    for (i = 0; i < MAX_BLOCKS * 64; i++)
+        src[i] = rnd();
+    /* quantizer 1 to 127 times the matrix entries used by the encoder */
+    for (i = 0; i < 64; i++)
+        qmat[i] = (2 + rnd() % 62) * (1 + rnd() % 127);
+
+    if (check_func(c->quantize, "prores_quantize")) {
+        for (nb_blocks = 1; nb_blocks <= MAX_BLOCKS; nb_blocks <<= 1) {
+            int err0, err1;
+
+            memset(dst0, 0, MAX_BLOCKS * 64 * sizeof(*dst0));
+            memset(dst1, 0, MAX_BLOCKS * 64 * sizeof(*dst1));
+            err0 = call_ref(dst0, src, qmat, nb_blocks);
+            err1 = call_new(dst1, src, qmat, nb_blocks);
+            if (err0 != err1 ||
+                memcmp(dst0, dst1, MAX_BLOCKS * 64 * sizeof(*dst0)))
+                fail();
+        }
+        bench_new(dst1, src, qmat, MAX_BLOCKS);
+    }
+}
+
+void checkasm_check_proresencdsp(void)
+{
+    ProresEncDSPContext c;
+
+    ff_proresencdsp_init(&c);
+
+    check_quantize(&c);
+    report("quantize");
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/scene_sad.h"
+
+#define WIDTH 256
+#define HEIGHT 16
+#define STRIDE (WIDTH * 2 + 32)
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+static void check_scene_sad(int depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src1, [STRIDE * HEIGHT]);
+    LOCAL_ALIGNED_32(uint8_t, src2, [STRIDE * HEIGHT]);
+    /* widths that are not a multiple of the SIMD width exercise the tail */
+    ptrdiff_t width = WIDTH - (rnd() & 31);
+    uint64_t sum_ref, sum_new;
+
+    declare_func(void, const uint8_t *src1, ptrdiff_t stride1,
+                 const uint8_t *src2, ptrdiff_t stride2,
+                 ptrdiff_t width, ptrdiff_t height, uint64_t *sum);
+
+    randomize_buffers(src1, STRIDE * HEIGHT);
+    randomize_buffers(src2, STRIDE * HEIGHT);
+
+    if (check_func(ff_scene_sad_get_fn(depth), "scene_sad%d", depth)) {
+        call_ref(src1, STRIDE, src2, STRIDE, width, HEIGHT, &sum_ref);
+        call_new(src1, STRIDE, src2, STRIDE, width, HEIGHT, &sum_new);
+        if (sum_ref != sum_new)
+            fail();
+        bench_new(src1, STRIDE, src2, STRIDE, WIDTH, HEIGHT, &sum_new);
+    }
+}
+
+void checkasm_check_scene_sad(void)
+{
+    check_scene_sad(8);
+    report("scene_sad8");
+
+    check_scene_sad(16);
+    report("scene_sad16");
+}
@@ -0,0 +1,84 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/atadenoise.h"
+#include "libavutil/common.h"
+#include "libavutil/intreadwrite.h"
+
+#define WIDTH 256
+#define FRAMES 9
+#define BUF_SIZE (WIDTH * 2 + 32)
+
+static void check_filter_row(int depth, int algorithm)
+{
+    LOCAL_ALIGNED_32(uint8_t, frames,  [FRAMES], [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [BUF_SIZE]);
+    const uint8_t *srcf[FRAMES];
+    int max = (1 << depth) - 1;
+    int mid = FRAMES / 2 + 1;
+    int thra = rnd() % (max / 8 + 1);
+    int thrb = thra + rnd() % (max / 4 + 1);
+    ATADenoiseDSPContext dsp;
+    int i, j;
+
+    declare_func(void, const uint8_t *src, uint8_t *dst,
+                 const uint8_t **srcf, int w, int mid, int size,
+                 int thra, int thrb);
+
+    /* similar frames, so that the filter averages over a varying number
+     * of them */
+    for (j = 0; j < BUF_SIZE / 2; j++) {
+        int v = rnd() & max;
+        for (i = 0; i < FRAMES; i++) {
+            int p = av_clip(v + (int)(rnd() % 17) - 8, 0, max);
+            if (depth > 8)
+                AV_WN16A(&frames[i][2 * j], p);
+            else
+                frames[i][j] = p;
+        }
+    }
+    for (i = 0; i < FRAMES; i++)
+        srcf[i] = frames[i];
+
+    memset(dst_ref, 0, BUF_SIZE);
+    memset(dst_new, 0, BUF_SIZE);
+    ff_atadenoise_init(&dsp, depth, algorithm);
+
+    if (check_func(dsp.filter_row, "atadenoise_filter_row%d%s", depth,
+                   algorithm == SERIAL ? "_serial" : "")) {
+        call_ref(srcf[mid], dst_ref, srcf, WIDTH, mid, FRAMES, thra, thrb);
+        call_new(srcf[mid], dst_new, srcf, WIDTH, mid, FRAMES, thra, thrb);
+        if (memcmp(dst_ref, dst_new, WIDTH * (depth > 8 ? 2 : 1)))
+            fail();
+        bench_new(srcf[mid], dst_new, srcf, WIDTH, mid, FRAMES, thra, thrb);
+    }
+}
+
+void checkasm_check_vf_atadenoise(void)
+{
+    check_filter_row(8, PARALLEL);
+    check_filter_row(8, SERIAL);
+    report("atadenoise_filter_row8");
+
+    check_filter_row(16, PARALLEL);
+    check_filter_row(16, SERIAL);
+    report("atadenoise_filter_row16");
+}
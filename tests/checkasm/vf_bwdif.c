@@ -0,0 +1,99 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/bwdif.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/pixdesc.h"
+
+#define WIDTH 256
+#define STRIDE (WIDTH + 32)
+/* the line filter reads up to four lines above and below */
+#define LINES 9
+#define MID (LINES / 2)
+
+static void randomize_lines(uint16_t *buf, int size, int depth)
+{
+    int j;
+
+    if (depth > 8) {
+        for (j = 0; j < size; j++)
+            buf[j] = rnd() & ((1 << depth) - 1);
+    } else {
+        uint8_t *buf8 = (uint8_t *)buf;
+        for (j = 0; j < size * 2; j++)
+            buf8[j] = rnd() & 0xFF;
+    }
+}
+
+static void check_filter_line(enum AVPixelFormat pix_fmt)
+{
+    LOCAL_ALIGNED_32(uint16_t, prev,    [LINES * STRIDE]);
+    LOCAL_ALIGNED_32(uint16_t, cur,     [LINES * STRIDE]);
+    LOCAL_ALIGNED_32(uint16_t, next,    [LINES * STRIDE]);
+    LOCAL_ALIGNED_32(uint16_t, dst_ref, [STRIDE]);
+    LOCAL_ALIGNED_32(uint16_t, dst_new, [STRIDE]);
+    BWDIFContext s = { { 0 } };
+    int depth, bpp, refs, off, clip_max, parity;
+
+    declare_func(void, void *dst, void *prev, void *cur, void *next,
+                 int w, int prefs, int mrefs, int prefs2, int mrefs2,
+                 int prefs3, int mrefs3, int prefs4, int mrefs4,
+                 int parity, int clip_max);
+
+    s.yadif.csp = av_pix_fmt_desc_get(pix_fmt);
+    depth    = s.yadif.csp->comp[0].depth;
+    bpp      = depth > 8 ? 2 : 1;
+    clip_max = (1 << depth) - 1;
+    /* line strides are given in pixels */
+    refs     = STRIDE * 2 / bpp;
+    off      = MID * STRIDE * 2;
+    ff_bwdif_init(&s);
+
+    randomize_lines(prev, LINES * STRIDE, depth);
+    randomize_lines(cur,  LINES * STRIDE, depth);
+    randomize_lines(next, LINES * STRIDE, depth);
+
+    if (check_func(s.filter_line, "bwdif_filter_line_%dbit", depth)) {
+        for (parity = 0; parity < 2; parity++) {
+            memset(dst_ref, 0, STRIDE * 2);
+            memset(dst_new, 0, STRIDE * 2);
+            call_ref(dst_ref, (uint8_t *)prev + off, (uint8_t *)cur + off,
+                     (uint8_t *)next + off, WIDTH, refs, -refs, 2 * refs, -2 * refs,
+                     3 * refs, -3 * refs, 4 * refs, -4 * refs, parity, clip_max);
+            call_new(dst_new, (uint8_t *)prev + off, (uint8_t *)cur + off,
+                     (uint8_t *)next + off, WIDTH, refs, -refs, 2 * refs, -2 * refs,
+                     3 * refs, -3 * refs, 4 * refs, -4 * refs, parity, clip_max);
+            if (memcmp(dst_ref, dst_new, WIDTH * bpp))
+                fail();
+        }
+        bench_new(dst_new, (uint8_t *)prev + off, (uint8_t *)cur + off,
+                  (uint8_t *)next + off, WIDTH, refs, -refs, 2 * refs, -2 * refs,
+                  3 * refs, -3 * refs, 4 * refs, -4 * refs, 0, clip_max);
+    }
+}
+
+void checkasm_check_vf_bwdif(void)
+{
+    check_filter_line(AV_PIX_FMT_YUV420P);
+    report("bwdif_filter_line_8bit");
+
+    check_filter_line(AV_PIX_FMT_YUV420P12);
+    report("bwdif_filter_line_12bit");
+}
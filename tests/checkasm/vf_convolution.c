@@ -0,0 +1,75 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/convolution.h"
+#include "libavutil/common.h"
+
+#define WIDTH 512
+#define STRIDE (WIDTH + 2)
+
+static void check_filter_3x3(const ConvolutionContext *s)
+{
+    LOCAL_ALIGNED_32(uint8_t, src,     [3 * STRIDE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [WIDTH]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [WIDTH]);
+    const uint8_t *c[9];
+    int matrix[9];
+    const int width = WIDTH - (rnd() & 15);
+    float rdiv, bias;
+    int i, sum = 0;
+
+    declare_func(void, uint8_t *dst, int width,
+                 float rdiv, float bias, const int *const matrix,
+                 const uint8_t *c[], int peak, int radius,
+                 int dstride, int stride);
+
+    for (i = 0; i < 3 * STRIDE; i++)
+        src[i] = rnd();
+    for (i = 0; i < 9; i++) {
+        matrix[i] = (int)(rnd() % 33) - 16;
+        sum += matrix[i];
+        c[i] = src + (i / 3) * STRIDE + i % 3;
+    }
+    rdiv = 1.f / (sum ? sum : 1);
+    bias = (int)(rnd() % 65) - 32;
+    memset(dst_ref, 0, WIDTH);
+    memset(dst_new, 0, WIDTH);
+
+    if (check_func(s->filter[0], "filter_3x3")) {
+        call_ref(dst_ref, width, rdiv, bias, matrix, c, 255, 1, WIDTH, STRIDE);
+        call_new(dst_new, width, rdiv, bias, matrix, c, 255, 1, WIDTH, STRIDE);
+        if (memcmp(dst_ref, dst_new, WIDTH))
+            fail();
+        bench_new(dst_new, WIDTH, rdiv, bias, matrix, c, 255, 1, WIDTH, STRIDE);
+    }
+}
+
+void checkasm_check_vf_convolution(void)
+{
+    ConvolutionContext s = { 0 };
+
+    s.mode[0]          = MATRIX_SQUARE;
+    s.size[0]          = 3;
+    s.matrix_length[0] = 9;
+    ff_convolution_init(&s, 8);
+
+    check_filter_3x3(&s);
+    report("filter_3x3");
+}
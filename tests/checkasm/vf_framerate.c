@@ -0,0 +1,81 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/framerate.h"
+
+#define WIDTH 256
+#define HEIGHT 16
+#define STRIDE (WIDTH * 2 + 32)
+
+#define randomize_buffers(buf, size, mask)          \
+    do {                                            \
+        int j;                                      \
+        uint16_t *tmp_buf = (uint16_t *)buf;        \
+        for (j = 0; j < size / 2; j++)              \
+            tmp_buf[j] = rnd() & mask;              \
+    } while (0)
+
+static void check_blend(int bitdepth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src1,    [STRIDE * HEIGHT]);
+    LOCAL_ALIGNED_32(uint8_t, src2,    [STRIDE * HEIGHT]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [STRIDE * HEIGHT]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [STRIDE * HEIGHT]);
+    const int width = bitdepth == 8 ? WIDTH : WIDTH * 2;
+    FrameRateContext s = { .bitdepth = bitdepth };
+    int factor1, factor2;
+
+    declare_func(void, const uint8_t *src1, ptrdiff_t src1_linesize,
+                 const uint8_t *src2, ptrdiff_t src2_linesize,
+                 uint8_t *dst, ptrdiff_t dst_linesize,
+                 ptrdiff_t width, ptrdiff_t height,
+                 int factor1, int factor2, int half);
+
+    ff_framerate_init(&s);
+
+    /* the filter only blends with both factors in (0, blend_factor_max) */
+    factor2 = 1 + rnd() % (s.blend_factor_max - 1);
+    factor1 = s.blend_factor_max - factor2;
+
+    randomize_buffers(src1, STRIDE * HEIGHT, bitdepth == 8 ? 0xFFFF : (1 << bitdepth) - 1);
+    randomize_buffers(src2, STRIDE * HEIGHT, bitdepth == 8 ? 0xFFFF : (1 << bitdepth) - 1);
+    memset(dst_ref, 0, STRIDE * HEIGHT);
+    memset(dst_new, 0, STRIDE * HEIGHT);
+
+    if (check_func(s.blend, "blend_frames%d", bitdepth == 8 ? 8 : 16)) {
+        call_ref(src1, STRIDE, src2, STRIDE, dst_ref, STRIDE, width, HEIGHT,
+                 factor1, factor2, s.blend_factor_max >> 1);
+        call_new(src1, STRIDE, src2, STRIDE, dst_new, STRIDE, width, HEIGHT,
+                 factor1, factor2, s.blend_factor_max >> 1);
+        if (memcmp(dst_ref, dst_new, STRIDE * HEIGHT))
+            fail();
+        bench_new(src1, STRIDE, src2, STRIDE, dst_new, STRIDE, width, HEIGHT,
+                  factor1, factor2, s.blend_factor_max >> 1);
+    }
+}
+
+void checkasm_check_vf_framerate(void)
+{
+    check_blend(8);
+    report("blend_frames8");
+
+    check_blend(12);
+    report("blend_frames16");
+}
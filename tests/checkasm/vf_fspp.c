@@ -0,0 +1,112 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/vf_fspp.h"
+
+#define WIDTH 64
+#define HEIGHT 8
+#define SRC_STRIDE (WIDTH + 16)
+#define SRC_SIZE (SRC_STRIDE * (16 + HEIGHT))
+#define DST_STRIDE (WIDTH + 32)
+
+/* Keep the rounded results within [-256, 511]. Outside of that range
+ * the C code wraps instead of saturating like packuswb. */
+#define randomize_coeffs(buf, size)            \
+    do {                                       \
+        int j;                                 \
+        for (j = 0; j < size; j++)             \
+            buf[j] = (rnd() & 0x1FFF) - 0x1000;\
+    } while (0)
+
+static void check_store_slice(void (*store)(uint8_t *dst, int16_t *src,
+                                            ptrdiff_t dst_stride, ptrdiff_t src_stride,
+                                            ptrdiff_t width, ptrdiff_t height,
+                                            ptrdiff_t log2_scale),
+                              const char *name, int src_offset)
+{
+    LOCAL_ALIGNED_32(int16_t, src_ref, [SRC_SIZE]);
+    LOCAL_ALIGNED_32(int16_t, src_new, [SRC_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [DST_STRIDE * HEIGHT]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [DST_STRIDE * HEIGHT]);
+    /* both versions round the width up to a multiple of 8 */
+    int width = WIDTH - (rnd() & 7);
+    /* log2_count is 4 or 5 */
+    int log2_scale = rnd() & 1;
+
+    declare_func_emms(AV_CPU_FLAG_MMX, void, uint8_t *dst, int16_t *src,
+                      ptrdiff_t dst_stride, ptrdiff_t src_stride,
+                      ptrdiff_t width, ptrdiff_t height, ptrdiff_t log2_scale);
+
+    randomize_coeffs(src_ref, SRC_SIZE);
+    memcpy(src_new, src_ref, SRC_SIZE * sizeof(*src_ref));
+    memset(dst_ref, 0, DST_STRIDE * HEIGHT);
+    memset(dst_new, 0, DST_STRIDE * HEIGHT);
+
+    if (check_func(store, "fspp_%s", name)) {
+        call_ref(dst_ref, src_ref + src_offset, DST_STRIDE, SRC_STRIDE, width, HEIGHT, log2_scale);
+        call_new(dst_new, src_new + src_offset, DST_STRIDE, SRC_STRIDE, width, HEIGHT, log2_scale);
+        if (memcmp(dst_ref, dst_new, DST_STRIDE * HEIGHT) ||
+            memcmp(src_ref, src_new, SRC_SIZE * sizeof(*src_ref)))
+            fail();
+        bench_new(dst_new, src_new + src_offset, DST_STRIDE, SRC_STRIDE, WIDTH, HEIGHT, log2_scale);
+    }
+}
+
+static void check_mul_thrmat(const FSPPContext *fspp)
+{
+    LOCAL_ALIGNED_16(int16_t, thr_noq, [64]);
+    LOCAL_ALIGNED_16(int16_t, thr_ref, [64]);
+    LOCAL_ALIGNED_16(int16_t, thr_new, [64]);
+    int q = 1 + rnd() % 31;
+    int i;
+
+    declare_func_emms(AV_CPU_FLAG_MMX, void, int16_t *thr_adr_noq, int16_t *thr_adr, int q);
+
+    for (i = 0; i < 64; i++)
+        thr_noq[i] = rnd();
+    memset(thr_ref, 0, 64 * sizeof(*thr_ref));
+    memset(thr_new, 0, 64 * sizeof(*thr_new));
+
+    if (check_func(fspp->mul_thrmat, "fspp_mul_thrmat")) {
+        call_ref(thr_noq, thr_ref, q);
+        call_new(thr_noq, thr_new, q);
+        if (memcmp(thr_ref, thr_new, 64 * sizeof(*thr_ref)))
+            fail();
+        bench_new(thr_noq, thr_new, q);
+    }
+}
+
+void checkasm_check_vf_fspp(void)
+{
+    FSPPContext fspp;
+
+    ff_fspp_init(&fspp);
+
+    /* store_slice reads one slice and clears it and the one 8 lines above */
+    check_store_slice(fspp.store_slice, "store_slice", 8 * SRC_STRIDE);
+    report("store_slice");
+
+    /* store_slice2 adds the slice 16 lines below and clears that one */
+    check_store_slice(fspp.store_slice2, "store_slice2", 0);
+    report("store_slice2");
+
+    check_mul_thrmat(&fspp);
+    report("mul_thrmat");
+}
@@ -0,0 +1,113 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/gradfun.h"
+#include "libavutil/common.h"
+
+#define WIDTH 256
+#define STRIDE (WIDTH + 32)
+
+#define randomize_buffers(buf, size, mask)    \
+    do {                                      \
+        int j;                                \
+        for (j = 0; j < size; j++)            \
+            buf[j] = rnd() & mask;            \
+    } while (0)
+
+static void check_filter_line(const GradFunContext *gf)
+{
+    LOCAL_ALIGNED_32(uint8_t,  src,     [WIDTH + 8]);
+    LOCAL_ALIGNED_32(uint8_t,  dst_ref, [WIDTH + 8]);
+    LOCAL_ALIGNED_32(uint8_t,  dst_new, [WIDTH + 8]);
+    LOCAL_ALIGNED_32(uint16_t, dc,      [WIDTH / 2 + 8]);
+    LOCAL_ALIGNED_16(uint16_t, dithers, [8]);
+    /* The MMXEXT version restarts the dither pattern for its scalar tail,
+     * which only matches the C code if width % 8 < 4. */
+    int width = WIDTH + (rnd() & 3);
+    /* The SIMD versions scale delta by 4 in 16 bits, which fits for
+     * strength <= 32, i.e. thresh >= 1024. */
+    int thresh = 1024 + rnd() % (64250 - 1024);
+    int i;
+
+    declare_func_emms(AV_CPU_FLAG_MMX, void, uint8_t *dst, const uint8_t *src,
+                      const uint16_t *dc, int width, int thresh,
+                      const uint16_t *dithers);
+
+    randomize_buffers(src, WIDTH + 8, 0xFF);
+    randomize_buffers(dithers, 8, 0x7F);
+    /* keep the blurred value close to the source, so that the gradient
+     * actually gets smoothed instead of left untouched */
+    for (i = 0; i < WIDTH / 2 + 8; i++)
+        dc[i] = av_clip((src[2 * i] << 7) + (rnd() & 0x7FF) - 0x400, 0, 255 << 7);
+    memset(dst_ref, 0, WIDTH + 8);
+    memset(dst_new, 0, WIDTH + 8);
+
+    if (check_func(gf->filter_line, "gradfun_filter_line")) {
+        call_ref(dst_ref, src, dc, width, thresh, dithers);
+        call_new(dst_new, src, dc, width, thresh, dithers);
+        if (memcmp(dst_ref, dst_new, WIDTH + 8))
+            fail();
+        bench_new(dst_new, src, dc, WIDTH, thresh, dithers);
+    }
+}
+
+static void check_blur_line(const GradFunContext *gf, int unaligned)
+{
+    LOCAL_ALIGNED_32(uint8_t,  src,     [2 * STRIDE + 1]);
+    LOCAL_ALIGNED_32(uint16_t, buf1,    [WIDTH / 2]);
+    LOCAL_ALIGNED_32(uint16_t, buf_ref, [WIDTH / 2]);
+    LOCAL_ALIGNED_32(uint16_t, buf_new, [WIDTH / 2]);
+    LOCAL_ALIGNED_32(uint16_t, dc_ref,  [WIDTH / 2]);
+    LOCAL_ALIGNED_32(uint16_t, dc_new,  [WIDTH / 2]);
+    /* the filter pads the blur buffers to a multiple of 8 entries */
+    const int width = WIDTH / 2;
+
+    declare_func(void, uint16_t *dc, uint16_t *buf, const uint16_t *buf1,
+                 const uint8_t *src, int src_linesize, int width);
+
+    randomize_buffers(src, 2 * STRIDE + 1, 0xFF);
+    randomize_buffers(buf1, WIDTH / 2, 0x7FFF);
+    randomize_buffers(buf_ref, WIDTH / 2, 0x7FFF);
+    memcpy(buf_new, buf_ref, WIDTH / 2 * sizeof(*buf_ref));
+
+    if (check_func(gf->blur_line, "gradfun_blur_line_%s",
+                   unaligned ? "unaligned" : "aligned")) {
+        call_ref(dc_ref, buf_ref, buf1, src + unaligned, STRIDE, width);
+        call_new(dc_new, buf_new, buf1, src + unaligned, STRIDE, width);
+        if (memcmp(buf_ref, buf_new, width * sizeof(*buf_ref)) ||
+            memcmp(dc_ref,  dc_new,  width * sizeof(*dc_ref)))
+            fail();
+        bench_new(dc_new, buf_new, buf1, src + unaligned, STRIDE, width);
+    }
+}
+
+void checkasm_check_vf_gradfun(void)
+{
+    GradFunContext gf;
+
+    ff_gradfun_init(&gf);
+
+    check_filter_line(&gf);
+    report("filter_line");
+
+    check_blur_line(&gf, 0);
+    check_blur_line(&gf, 1);
+    report("blur_line");
+}
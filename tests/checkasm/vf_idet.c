@@ -0,0 +1,68 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/vf_idet.h"
+
+#define WIDTH 256
+#define BUF_SIZE (WIDTH * 2 + 32)
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+static void check_filter_line(int for_16b)
+{
+    LOCAL_ALIGNED_32(uint8_t, a, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, b, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, c, [BUF_SIZE]);
+    /* odd widths exercise the C fallback for the tail */
+    int w = WIDTH - (rnd() & 15);
+    IDETContext idet;
+    int res_ref, res_new;
+
+    declare_func_emms(AV_CPU_FLAG_MMX, int, const uint8_t *a, const uint8_t *b,
+                      const uint8_t *c, int w);
+
+    randomize_buffers(a, BUF_SIZE);
+    randomize_buffers(b, BUF_SIZE);
+    randomize_buffers(c, BUF_SIZE);
+    ff_idet_init(&idet, for_16b);
+
+    if (check_func(idet.filter_line, "idet_filter_line%s", for_16b ? "_16bit" : "")) {
+        res_ref = call_ref(a, b, c, w);
+        res_new = call_new(a, b, c, w);
+        if (res_ref != res_new)
+            fail();
+        bench_new(a, b, c, WIDTH);
+    }
+}
+
+void checkasm_check_vf_idet(void)
+{
+    check_filter_line(0);
+    report("filter_line");
+
+    check_filter_line(1);
+    report("filter_line_16bit");
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/limiter.h"
+#include "libavutil/intreadwrite.h"
+
+#define WIDTH 256
+#define HEIGHT 16
+#define STRIDE (WIDTH * 2 + 32)
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+static void check_limiter(int depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src,     [STRIDE * HEIGHT]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [STRIDE * HEIGHT]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [STRIDE * HEIGHT]);
+    int max = (1 << depth) - 1;
+    int lo  = rnd() % (max + 1);
+    int hi  = lo + rnd() % (max + 1 - lo);
+    LimiterDSPContext dsp;
+
+    declare_func(void, const uint8_t *src, uint8_t *dst,
+                 ptrdiff_t slinesize, ptrdiff_t dlinesize,
+                 int w, int h, int min, int max);
+
+    memset(dst_ref, 0, STRIDE * HEIGHT);
+    memset(dst_new, 0, STRIDE * HEIGHT);
+    randomize_buffers(src, STRIDE * HEIGHT);
+    ff_limiter_init(&dsp, depth);
+
+    if (check_func(dsp.limiter, "limiter%d", depth)) {
+        call_ref(src, dst_ref, STRIDE, STRIDE, WIDTH, HEIGHT, lo, hi);
+        call_new(src, dst_new, STRIDE, STRIDE, WIDTH, HEIGHT, lo, hi);
+        if (memcmp(dst_ref, dst_new, STRIDE * HEIGHT))
+            fail();
+        bench_new(src, dst_new, STRIDE, STRIDE, WIDTH, HEIGHT, lo, hi);
+    }
+}
+
+void checkasm_check_vf_limiter(void)
+{
+    check_limiter(8);
+    report("limiter8");
+
+    check_limiter(16);
+    report("limiter16");
+}
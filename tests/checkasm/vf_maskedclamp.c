@@ -0,0 +1,76 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/maskedclamp.h"
+#include "libavutil/intreadwrite.h"
+
+#define WIDTH 256
+#define BUF_SIZE (WIDTH * 2)
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+static void check_maskedclamp(int depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src,     [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dark,    [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, bright,  [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [BUF_SIZE]);
+    int max = (1 << depth) - 1;
+    int undershoot = rnd() % (max + 1);
+    int overshoot  = rnd() % (max + 1);
+    MaskedClampDSPContext dsp;
+
+    declare_func(void, const uint8_t *bsrc, uint8_t *dst,
+                 const uint8_t *darksrc, const uint8_t *brightsrc,
+                 int w, int undershoot, int overshoot);
+
+    memset(dst_ref, 0, BUF_SIZE);
+    memset(dst_new, 0, BUF_SIZE);
+    randomize_buffers(src,    BUF_SIZE);
+    randomize_buffers(dark,   BUF_SIZE);
+    randomize_buffers(bright, BUF_SIZE);
+    ff_maskedclamp_init(&dsp, depth);
+
+    if (check_func(dsp.maskedclamp, "maskedclamp%d", depth)) {
+        int w = depth > 8 ? WIDTH : BUF_SIZE;
+
+        call_ref(src, dst_ref, dark, bright, w, undershoot, overshoot);
+        call_new(src, dst_new, dark, bright, w, undershoot, overshoot);
+        if (memcmp(dst_ref, dst_new, BUF_SIZE))
+            fail();
+        bench_new(src, dst_new, dark, bright, w, undershoot, overshoot);
+    }
+}
+
+void checkasm_check_vf_maskedclamp(void)
+{
+    check_maskedclamp(8);
+    report("maskedclamp8");
+
+    check_maskedclamp(16);
+    report("maskedclamp16");
+}
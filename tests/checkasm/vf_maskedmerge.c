@@ -0,0 +1,78 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/maskedmerge.h"
+#include "libavutil/intreadwrite.h"
+
+#define WIDTH 256
+#define HEIGHT 16
+#define STRIDE (WIDTH + 32)
+#define BUF_SIZE (STRIDE * HEIGHT)
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+static void check_maskedmerge(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, base,    [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, overlay, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, mask,    [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [BUF_SIZE]);
+    MaskedMergeContext s;
+
+    declare_func(void, const uint8_t *bsrc, const uint8_t *osrc,
+                 const uint8_t *msrc, uint8_t *dst,
+                 ptrdiff_t blinesize, ptrdiff_t olinesize,
+                 ptrdiff_t mlinesize, ptrdiff_t dlinesize,
+                 int w, int h, int half, int shift);
+
+    memset(dst_ref, 0, BUF_SIZE);
+    memset(dst_new, 0, BUF_SIZE);
+    randomize_buffers(base,    BUF_SIZE);
+    randomize_buffers(overlay, BUF_SIZE);
+    randomize_buffers(mask,    BUF_SIZE);
+
+    s.depth = 8;
+    s.half  = 128;
+    ff_maskedmerge_init(&s);
+
+    if (check_func(s.maskedmerge, "maskedmerge8")) {
+        call_ref(base, overlay, mask, dst_ref, STRIDE, STRIDE, STRIDE, STRIDE,
+                 WIDTH, HEIGHT, s.half, s.depth);
+        call_new(base, overlay, mask, dst_new, STRIDE, STRIDE, STRIDE, STRIDE,
+                 WIDTH, HEIGHT, s.half, s.depth);
+        if (memcmp(dst_ref, dst_new, BUF_SIZE))
+            fail();
+        bench_new(base, overlay, mask, dst_new, STRIDE, STRIDE, STRIDE, STRIDE,
+                  WIDTH, HEIGHT, s.half, s.depth);
+    }
+}
+
+void checkasm_check_vf_maskedmerge(void)
+{
+    check_maskedmerge();
+    report("maskedmerge8");
+}
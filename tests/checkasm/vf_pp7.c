@@ -0,0 +1,55 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/vf_pp7.h"
+
+static void check_dctB(const PP7Context *pp7)
+{
+    LOCAL_ALIGNED_16(int16_t, src,     [4 * 7]);
+    LOCAL_ALIGNED_16(int16_t, dst_ref, [4 * 4]);
+    LOCAL_ALIGNED_16(int16_t, dst_new, [4 * 4]);
+    int i;
+
+    declare_func_emms(AV_CPU_FLAG_MMX, void, int16_t *dst, int16_t *src);
+
+    /* outputs of the first DCT pass over 8-bit pixels */
+    for (i = 0; i < 4 * 7; i++)
+        src[i] = (rnd() & 0xFFF) - 0x800;
+    memset(dst_ref, 0, 4 * 4 * sizeof(*dst_ref));
+    memset(dst_new, 0, 4 * 4 * sizeof(*dst_new));
+
+    if (check_func(pp7->dctB, "pp7_dctB")) {
+        call_ref(dst_ref, src);
+        call_new(dst_new, src);
+        if (memcmp(dst_ref, dst_new, 4 * 4 * sizeof(*dst_ref)))
+            fail();
+        bench_new(dst_new, src);
+    }
+}
+
+void checkasm_check_vf_pp7(void)
+{
+    PP7Context pp7;
+
+    ff_pp7_init(&pp7);
+
+    check_dctB(&pp7);
+    report("dctB");
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/psnr.h"
+#include "libavutil/intreadwrite.h"
+
+#define WIDTH 1024
+#define BUF_SIZE (WIDTH * 2)
+
+#define randomize_buffers(buf, size, mask)         \
+    do {                                           \
+        int j;                                     \
+        uint16_t *tmp_buf = (uint16_t *)buf;       \
+        for (j = 0; j < size / 2; j++)             \
+            tmp_buf[j] = rnd() & (mask);           \
+    } while (0)
+
+static void check_sse_line(int bpp)
+{
+    LOCAL_ALIGNED_32(uint8_t, buf, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, ref, [BUF_SIZE]);
+    /* odd widths exercise the tail handling */
+    int w = WIDTH - 1 - (rnd() & 15);
+    uint64_t res_ref, res_new;
+    PSNRDSPContext dsp;
+
+    declare_func(uint64_t, const uint8_t *buf, const uint8_t *ref, int w);
+
+    randomize_buffers(buf, BUF_SIZE, bpp > 8 ? (1 << bpp) - 1 : 0xFFFF);
+    randomize_buffers(ref, BUF_SIZE, bpp > 8 ? (1 << bpp) - 1 : 0xFFFF);
+    ff_psnr_init(&dsp, bpp);
+
+    if (check_func(dsp.sse_line, "sse_line_%dbit", bpp > 8 ? 16 : 8)) {
+        res_ref = call_ref(buf, ref, w);
+        res_new = call_new(buf, ref, w);
+        if (res_ref != res_new)
+            fail();
+        bench_new(buf, ref, WIDTH);
+    }
+}
+
+void checkasm_check_vf_psnr(void)
+{
+    check_sse_line(8);
+    report("sse_line_8bit");
+
+    check_sse_line(14);
+    report("sse_line_16bit");
+}
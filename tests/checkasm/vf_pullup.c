@@ -0,0 +1,70 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/vf_pullup.h"
+
+/* the metrics look at an 8x4 block plus one line above and below */
+#define STRIDE 32
+#define BUF_SIZE (STRIDE * 6)
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+static void check_metric(int (*metric)(const uint8_t *a, const uint8_t *b, ptrdiff_t s),
+                         const char *name)
+{
+    LOCAL_ALIGNED_32(uint8_t, a, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, b, [BUF_SIZE]);
+    int res_ref, res_new;
+
+    declare_func_emms(AV_CPU_FLAG_MMX, int, const uint8_t *a, const uint8_t *b, ptrdiff_t s);
+
+    randomize_buffers(a, BUF_SIZE);
+    randomize_buffers(b, BUF_SIZE);
+
+    if (check_func(metric, "pullup_filter_%s", name)) {
+        res_ref = call_ref(a + STRIDE, b + STRIDE, STRIDE);
+        res_new = call_new(a + STRIDE, b + STRIDE, STRIDE);
+        if (res_ref != res_new)
+            fail();
+        bench_new(a + STRIDE, b + STRIDE, STRIDE);
+    }
+}
+
+void checkasm_check_vf_pullup(void)
+{
+    PullupContext s;
+
+    ff_pullup_init(&s);
+
+    check_metric(s.diff, "diff");
+    report("diff");
+
+    check_metric(s.comb, "comb");
+    report("comb");
+
+    check_metric(s.var, "var");
+    report("var");
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/ssim.h"
+#include "libavutil/intreadwrite.h"
+
+#define BLOCKS 64
+#define STRIDE (BLOCKS * 4 + 32)
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+static void check_ssim_4x4_line(const SSIMDSPContext *dsp)
+{
+    LOCAL_ALIGNED_32(uint8_t, buf, [STRIDE * 4]);
+    LOCAL_ALIGNED_32(uint8_t, ref, [STRIDE * 4]);
+    LOCAL_ALIGNED_32(int, sums_ref, [BLOCKS + 4], [4]);
+    LOCAL_ALIGNED_32(int, sums_new, [BLOCKS + 4], [4]);
+    int w = BLOCKS - (rnd() & 3);
+
+    declare_func(void, const uint8_t *buf, ptrdiff_t buf_stride,
+                 const uint8_t *ref, ptrdiff_t ref_stride,
+                 int (*sums)[4], int w);
+
+    randomize_buffers(buf, STRIDE * 4);
+    randomize_buffers(ref, STRIDE * 4);
+    memset(sums_ref, 0, sizeof(*sums_ref) * (BLOCKS + 4));
+    memset(sums_new, 0, sizeof(*sums_new) * (BLOCKS + 4));
+
+    if (check_func(dsp->ssim_4x4_line, "ssim_4x4_line")) {
+        call_ref(buf, STRIDE, ref, STRIDE, sums_ref, w);
+        call_new(buf, STRIDE, ref, STRIDE, sums_new, w);
+        if (memcmp(sums_ref, sums_new, sizeof(*sums_ref) * w))
+            fail();
+        bench_new(buf, STRIDE, ref, STRIDE, sums_new, BLOCKS);
+    }
+}
+
+static void check_ssim_end_line(const SSIMDSPContext *dsp)
+{
+    LOCAL_ALIGNED_32(uint8_t, buf, [STRIDE * 8]);
+    LOCAL_ALIGNED_32(uint8_t, ref, [STRIDE * 8]);
+    LOCAL_ALIGNED_32(int, sum0, [BLOCKS + 4], [4]);
+    LOCAL_ALIGNED_32(int, sum1, [BLOCKS + 4], [4]);
+    int w = BLOCKS - (rnd() & 3);
+    double res_ref, res_new;
+
+    declare_func(double, const int (*sum0)[4], const int (*sum1)[4], int w);
+
+    /* sums of real 4x4 blocks, made with the bit exact ssim_4x4_line(), as
+     * independent random sums can give variances that no pixels have */
+    randomize_buffers(buf, STRIDE * 8);
+    randomize_buffers(ref, STRIDE * 8);
+    dsp->ssim_4x4_line(buf, STRIDE, ref, STRIDE, sum0, BLOCKS + 1);
+    dsp->ssim_4x4_line(buf + 4 * STRIDE, STRIDE, ref + 4 * STRIDE, STRIDE,
+                       sum1, BLOCKS + 1);
+
+    if (check_func(dsp->ssim_end_line, "ssim_end_line")) {
+        res_ref = call_ref((const int (*)[4])sum0, (const int (*)[4])sum1, w);
+        res_new = call_new((const int (*)[4])sum0, (const int (*)[4])sum1, w);
+        if (!double_near_abs_eps(res_ref, res_new, 1e-5 * w))
+            fail();
+        bench_new((const int (*)[4])sum0, (const int (*)[4])sum1, BLOCKS);
+    }
+}
+
+void checkasm_check_vf_ssim(void)
+{
+    SSIMDSPContext dsp;
+
+    ff_ssim_init(&dsp);
+
+    check_ssim_4x4_line(&dsp);
+    report("ssim_4x4_line");
+
+    check_ssim_end_line(&dsp);
+    report("ssim_end_line");
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/stereo3d.h"
+#include "libavutil/intreadwrite.h"
+
+#define WIDTH 64
+#define HEIGHT 8
+#define STRIDE (WIDTH * 3 + 32)
+#define BUF_SIZE (STRIDE * HEIGHT)
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+void checkasm_check_vf_stereo3d(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, lsrc,    [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, rsrc,    [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [BUF_SIZE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [BUF_SIZE]);
+    int matrix[3][6];
+    Stereo3DDSPContext dsp;
+    int i, j;
+
+    declare_func(void, uint8_t *dst, uint8_t *lsrc, uint8_t *rsrc,
+                 ptrdiff_t dst_linesize, ptrdiff_t l_linesize, ptrdiff_t r_linesize,
+                 int width, int height,
+                 const int *ana_matrix_r, const int *ana_matrix_g, const int *ana_matrix_b);
+
+    /* the coefficients of the anaglyph modes are 16.16 fixed point values
+     * between -1 and 1 */
+    for (i = 0; i < 3; i++)
+        for (j = 0; j < 6; j++)
+            matrix[i][j] = (int)(rnd() % 131073) - 65536;
+
+    memset(dst_ref, 0, BUF_SIZE);
+    memset(dst_new, 0, BUF_SIZE);
+    randomize_buffers(lsrc, BUF_SIZE);
+    randomize_buffers(rsrc, BUF_SIZE);
+    ff_stereo3d_init(&dsp);
+
+    if (check_func(dsp.anaglyph, "anaglyph")) {
+        call_ref(dst_ref, lsrc, rsrc, STRIDE, STRIDE, STRIDE, WIDTH, HEIGHT,
+                 matrix[0], matrix[1], matrix[2]);
+        call_new(dst_new, lsrc, rsrc, STRIDE, STRIDE, STRIDE, WIDTH, HEIGHT,
+                 matrix[0], matrix[1], matrix[2]);
+        if (memcmp(dst_ref, dst_new, BUF_SIZE))
+            fail();
+        bench_new(dst_new, lsrc, rsrc, STRIDE, STRIDE, STRIDE, WIDTH, HEIGHT,
+                  matrix[0], matrix[1], matrix[2]);
+    }
+    report("anaglyph");
+}
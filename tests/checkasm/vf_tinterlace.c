@@ -0,0 +1,76 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/tinterlace.h"
+#include "libavutil/intreadwrite.h"
+
+#define WIDTH 64
+/* the SIMD versions process whole vectors and may write past the width */
+#define STRIDE (WIDTH * 2 + 128)
+
+static void check_lowpass_line(int depth, int complex)
+{
+    LOCAL_ALIGNED_32(uint8_t, src,     [5 * STRIDE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [STRIDE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [STRIDE]);
+    TInterlaceContext s = { 0 };
+    const int bps = (depth + 7) >> 3;
+    const int clip_max = (1 << depth) - 1;
+    const int width = WIDTH - (rnd() & 15);
+    const uint8_t *cur = src + 2 * STRIDE;
+    int i;
+
+    declare_func(void, uint8_t *dstp, ptrdiff_t width, const uint8_t *srcp,
+                 ptrdiff_t mref, ptrdiff_t pref, int clip_max);
+
+    s.flags = complex ? TINTERLACE_FLAG_CVLPF : TINTERLACE_FLAG_VLPF;
+    s.csp   = av_pix_fmt_desc_get(depth > 8 ? AV_PIX_FMT_YUV420P12 : AV_PIX_FMT_YUV420P);
+    ff_tinterlace_init(&s);
+
+    if (bps == 1) {
+        for (i = 0; i < 5 * STRIDE; i++)
+            src[i] = rnd();
+    } else {
+        for (i = 0; i < 5 * STRIDE; i += 2)
+            AV_WN16A(src + i, rnd() & clip_max);
+    }
+    memset(dst_ref, 0, STRIDE);
+    memset(dst_new, 0, STRIDE);
+
+    if (check_func(s.lowpass_line, "lowpass_line%s_%d",
+                   complex ? "_complex" : "", depth)) {
+        call_ref(dst_ref, width, cur, -STRIDE, STRIDE, clip_max);
+        call_new(dst_new, width, cur, -STRIDE, STRIDE, clip_max);
+        if (memcmp(dst_ref, dst_new, width * bps))
+            fail();
+        bench_new(dst_new, WIDTH, cur, -STRIDE, STRIDE, clip_max);
+    }
+}
+
+void checkasm_check_vf_tinterlace(void)
+{
+    check_lowpass_line(8,  0);
+    check_lowpass_line(12, 0);
+    report("lowpass_line");
+
+    check_lowpass_line(8,  1);
+    check_lowpass_line(12, 1);
+    report("lowpass_line_complex");
+}
@@ -0,0 +1,139 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/v360.h"
+#include "libavutil/intreadwrite.h"
+
+#define IN_W  64
+#define IN_H  16
+#define WIDTH 64
+/* the SIMD versions gather whole dwords and process up to 8 pixels at once */
+#define PAD   8
+
+static float randf(void)
+{
+    return (rnd() & 0xFFFF) / 65535.f;
+}
+
+static void lagrange_coeffs(float t, float *coeffs)
+{
+    coeffs[0] = (t - 1.f) * (t - 2.f) * 0.5f;
+    coeffs[1] = -t * (t - 2.f);
+    coeffs[2] =  t * (t - 1.f) * 0.5f;
+}
+
+/* kernels shaped like the ones the filter computes for each window size */
+static void fill_kernel(int16_t *ker, int ws)
+{
+    const float du = randf(), dv = randf();
+    float du_coeffs[3], dv_coeffs[3];
+    int i, j;
+
+    switch (ws) {
+    case 2:
+        ker[0] = lrintf((1.f - du) * (1.f - dv) * 16385.f);
+        ker[1] = lrintf(       du  * (1.f - dv) * 16385.f);
+        ker[2] = lrintf((1.f - du) *        dv  * 16385.f);
+        ker[3] = lrintf(       du  *        dv  * 16385.f);
+        break;
+    case 3:
+        lagrange_coeffs(du, du_coeffs);
+        lagrange_coeffs(dv, dv_coeffs);
+        for (i = 0; i < 3; i++)
+            for (j = 0; j < 3; j++)
+                ker[i * 3 + j] = lrintf(du_coeffs[j] * dv_coeffs[i] * 16385.f);
+        break;
+    case 4:
+        for (i = 0; i < 16; i++)
+            ker[i] = (int)(rnd() % 2048) - 512;
+        break;
+    }
+}
+
+static void check_remap_line(int ws, int interp, int depth)
+{
+    LOCAL_ALIGNED_32(uint8_t, src,     [IN_W * IN_H * 2 + 4]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [(WIDTH + PAD) * 2]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [(WIDTH + PAD) * 2]);
+    LOCAL_ALIGNED_32(int16_t, u,       [(WIDTH + PAD) * 16]);
+    LOCAL_ALIGNED_32(int16_t, v,       [(WIDTH + PAD) * 16]);
+    LOCAL_ALIGNED_32(int16_t, ker,     [(WIDTH + PAD) * 16]);
+    V360Context s = { .interp = interp };
+    const int bps = depth > 8 ? 2 : 1;
+    const int in_linesize = IN_W * bps;
+    const int width = WIDTH - (rnd() & 7);
+    int i;
+
+    declare_func(void, uint8_t *dst, int width, const uint8_t *const src,
+                 ptrdiff_t in_linesize, const int16_t *const u,
+                 const int16_t *const v, const int16_t *const ker);
+
+    ff_v360_init(&s, depth);
+
+    for (i = 0; i < IN_W * IN_H; i++) {
+        unsigned r = rnd();
+        if (bps == 1)
+            src[i] = r;
+        else
+            /* The AVX2 version truncates instead of clipping the few
+             * bilinear results that round above 65535. */
+            AV_WN16A(src + 2 * i, FFMIN(r & 0xFFFF, 0xFFF0));
+    }
+    memset(u,   0, (WIDTH + PAD) * 16 * sizeof(*u));
+    memset(v,   0, (WIDTH + PAD) * 16 * sizeof(*v));
+    memset(ker, 0, (WIDTH + PAD) * 16 * sizeof(*ker));
+    for (i = 0; i < width * ws * ws; i++) {
+        u[i] = rnd() % IN_W;
+        v[i] = rnd() % IN_H;
+    }
+    if (ws > 1)
+        for (i = 0; i < width; i++)
+            fill_kernel(ker + i * ws * ws, ws);
+    memset(dst_ref, 0, (WIDTH + PAD) * 2);
+    memset(dst_new, 0, (WIDTH + PAD) * 2);
+
+    if (check_func(s.remap_line, "remap%d_%dbit_line", ws, bps * 8)) {
+        call_ref(dst_ref, width, src, in_linesize, u, v, ker);
+        call_new(dst_new, width, src, in_linesize, u, v, ker);
+        if (memcmp(dst_ref, dst_new, width * bps))
+            fail();
+        bench_new(dst_new, WIDTH, src, in_linesize, u, v, ker);
+    }
+}
+
+void checkasm_check_vf_v360(void)
+{
+    check_remap_line(1, NEAREST,   8);
+    check_remap_line(1, NEAREST,   16);
+    report("remap1");
+
+    check_remap_line(2, BILINEAR,  8);
+    check_remap_line(2, BILINEAR,  16);
+    report("remap2");
+
+    check_remap_line(3, LAGRANGE9, 8);
+    check_remap_line(3, LAGRANGE9, 16);
+    report("remap3");
+
+    check_remap_line(4, BICUBIC,   8);
+    check_remap_line(4, BICUBIC,   16);
+    report("remap4");
+}
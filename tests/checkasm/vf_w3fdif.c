@@ -0,0 +1,151 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/w3fdif.h"
+#include "libavutil/intreadwrite.h"
+
+#define WIDTH 256
+#define LINES 5
+
+#define randomize_buffers(buf, size)      \
+    do {                                  \
+        int j;                            \
+        uint8_t *tmp_buf = (uint8_t *)buf;\
+        for (j = 0; j < size; j++)        \
+            tmp_buf[j] = rnd() & 0xFF;    \
+    } while (0)
+
+/* the coefficients used by the filter */
+static const int16_t coef_lf[2][4] = {{ 16384, 16384,     0,    0},
+                                      {  -852, 17236, 17236, -852}};
+static const int16_t coef_hf[2][5] = {{ -2048,  4096, -2048,     0,    0},
+                                      {  1016, -3801,  5570, -3801, 1016}};
+
+static void check_low(const W3FDIFDSPContext *dsp, uint8_t *cur[LINES],
+                      int complex)
+{
+    LOCAL_ALIGNED_32(int32_t, work_ref, [WIDTH]);
+    LOCAL_ALIGNED_32(int32_t, work_new, [WIDTH]);
+    uint8_t *lines[LINES];
+
+    declare_func(void, int32_t *work_line, uint8_t *in_lines_cur[4],
+                 const int16_t *coef, int linesize);
+
+    memset(work_ref, 0, WIDTH * sizeof(*work_ref));
+    memset(work_new, 0, WIDTH * sizeof(*work_new));
+
+    if (check_func(complex ? dsp->filter_complex_low : dsp->filter_simple_low,
+                   "w3fdif_%s_low", complex ? "complex" : "simple")) {
+        /* the C versions advance the line pointers */
+        memcpy(lines, cur, sizeof(lines));
+        call_ref(work_ref, lines, coef_lf[complex], WIDTH);
+        memcpy(lines, cur, sizeof(lines));
+        call_new(work_new, lines, coef_lf[complex], WIDTH);
+        if (memcmp(work_ref, work_new, WIDTH * sizeof(*work_ref)))
+            fail();
+        memcpy(lines, cur, sizeof(lines));
+        bench_new(work_new, lines, coef_lf[complex], WIDTH);
+    }
+}
+
+static void check_high(const W3FDIFDSPContext *dsp, uint8_t *cur[LINES],
+                       uint8_t *adj[LINES], int complex)
+{
+    LOCAL_ALIGNED_32(int32_t, work_ref, [WIDTH]);
+    LOCAL_ALIGNED_32(int32_t, work_new, [WIDTH]);
+    uint8_t *lines_cur[LINES], *lines_adj[LINES];
+    int i;
+
+    declare_func(void, int32_t *work_line, uint8_t *in_lines_cur[5],
+                 uint8_t *in_lines_adj[5], const int16_t *coef, int linesize);
+
+    /* the high frequency part is added to the low frequency one */
+    for (i = 0; i < WIDTH; i++)
+        work_ref[i] = work_new[i] = (int)(rnd() % (255 * 32768));
+
+    if (check_func(complex ? dsp->filter_complex_high : dsp->filter_simple_high,
+                   "w3fdif_%s_high", complex ? "complex" : "simple")) {
+        memcpy(lines_cur, cur, sizeof(lines_cur));
+        memcpy(lines_adj, adj, sizeof(lines_adj));
+        call_ref(work_ref, lines_cur, lines_adj, coef_hf[complex], WIDTH);
+        memcpy(lines_cur, cur, sizeof(lines_cur));
+        memcpy(lines_adj, adj, sizeof(lines_adj));
+        call_new(work_new, lines_cur, lines_adj, coef_hf[complex], WIDTH);
+        if (memcmp(work_ref, work_new, WIDTH * sizeof(*work_ref)))
+            fail();
+        memcpy(lines_cur, cur, sizeof(lines_cur));
+        memcpy(lines_adj, adj, sizeof(lines_adj));
+        bench_new(work_new, lines_cur, lines_adj, coef_hf[complex], WIDTH);
+    }
+}
+
+static void check_scale(const W3FDIFDSPContext *dsp)
+{
+    LOCAL_ALIGNED_32(int32_t, work, [WIDTH]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [WIDTH]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [WIDTH]);
+    int max = 255 * 256 * 128;
+    int i;
+
+    declare_func(void, uint8_t *out_pixel, const int32_t *work_pixel,
+                 int linesize, int max);
+
+    /* include values outside of the valid range, which are clipped */
+    for (i = 0; i < WIDTH; i++)
+        work[i] = (int)(rnd() % (2 * max)) - max / 2;
+    memset(dst_ref, 0, WIDTH);
+    memset(dst_new, 0, WIDTH);
+
+    if (check_func(dsp->filter_scale, "w3fdif_scale")) {
+        call_ref(dst_ref, work, WIDTH, max);
+        call_new(dst_new, work, WIDTH, max);
+        if (memcmp(dst_ref, dst_new, WIDTH))
+            fail();
+        bench_new(dst_new, work, WIDTH, max);
+    }
+}
+
+void checkasm_check_vf_w3fdif(void)
+{
+    LOCAL_ALIGNED_32(uint8_t, cur_buf, [LINES], [WIDTH]);
+    LOCAL_ALIGNED_32(uint8_t, adj_buf, [LINES], [WIDTH]);
+    uint8_t *cur[LINES], *adj[LINES];
+    W3FDIFDSPContext dsp;
+    int i;
+
+    randomize_buffers(cur_buf, LINES * WIDTH);
+    randomize_buffers(adj_buf, LINES * WIDTH);
+    for (i = 0; i < LINES; i++) {
+        cur[i] = cur_buf[i];
+        adj[i] = adj_buf[i];
+    }
+    ff_w3fdif_init(&dsp, 8);
+
+    check_low(&dsp, cur, 0);
+    check_low(&dsp, cur, 1);
+    report("w3fdif_low");
+
+    check_high(&dsp, cur, adj, 0);
+    check_high(&dsp, cur, adj, 1);
+    report("w3fdif_high");
+
+    check_scale(&dsp);
+    report("w3fdif_scale");
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with FFmpeg; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "checkasm.h"
+#include "libavfilter/yadif.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/pixdesc.h"
+
+#define WIDTH 256
+#define STRIDE (WIDTH * 2 + 64)
+/* the line filters read up to two lines above and below, and up to three
+ * pixels to the left and right */
+#define LINES 5
+#define OFFSET 3
+
+static void randomize_lines(uint8_t *buf, int size, int depth)
+{
+    int j;
+
+    if (depth > 8) {
+        for (j = 0; j < size / 2; j++)
+            AV_WN16A(buf + 2 * j, rnd() & ((1 << depth) - 1));
+    } else {
+        for (j = 0; j < size; j++)
+            buf[j] = rnd() & 0xFF;
+    }
+}
+
+static void check_filter_line(enum AVPixelFormat pix_fmt)
+{
+    LOCAL_ALIGNED_32(uint8_t, prev,    [LINES * STRIDE]);
+    LOCAL_ALIGNED_32(uint8_t, cur,     [LINES * STRIDE]);
+    LOCAL_ALIGNED_32(uint8_t, next,    [LINES * STRIDE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_ref, [STRIDE]);
+    LOCAL_ALIGNED_32(uint8_t, dst_new, [STRIDE]);
+    YADIFContext s = { 0 };
+    int depth, bpp, off, parity, mode;
+
+    declare_func(void, void *dst, void *prev, void *cur, void *next,
+                 int w, int prefs, int mrefs, int parity, int mode);
+
+    s.csp = av_pix_fmt_desc_get(pix_fmt);
+    depth = s.csp->comp[0].depth;
+    bpp   = depth > 8 ? 2 : 1;
+    off   = 2 * STRIDE + OFFSET * bpp;
+    ff_yadif_init(&s);
+
+    randomize_lines(prev, LINES * STRIDE, depth);
+    randomize_lines(cur,  LINES * STRIDE, depth);
+    randomize_lines(next, LINES * STRIDE, depth);
+
+    if (check_func(s.filter_line, "yadif_filter_line_%dbit", depth)) {
+        for (parity = 0; parity < 2; parity++) {
+            for (mode = 0; mode < 4; mode += 2) {
+                memset(dst_ref, 0, STRIDE);
+                memset(dst_new, 0, STRIDE);
+                call_ref(dst_ref + OFFSET * bpp, prev + off, cur + off, next + off,
+                         WIDTH - 2 * OFFSET, STRIDE, -STRIDE, parity, mode);
+                call_new(dst_new + OFFSET * bpp, prev + off, cur + off, next + off,
+                         WIDTH - 2 * OFFSET, STRIDE, -STRIDE, parity, mode);
+                if (memcmp(dst_ref + OFFSET * bpp, dst_new + OFFSET * bpp,
+                           (WIDTH - 2 * OFFSET) * bpp))
+                    fail();
+            }
+        }
+        bench_new(dst_new + OFFSET * bpp, prev + off, cur + off, next + off,
+                  WIDTH - 2 * OFFSET, STRIDE, -STRIDE, 0, 0);
+    }
+}
+
+void checkasm_check_vf_yadif(void)
+{
+    check_filter_line(AV_PIX_FMT_YUV420P);
+    report("yadif_filter_line_8bit");
+
+    check_filter_line(AV_PIX_FMT_YUV420P10);
+    report("yadif_filter_line_10bit");
+
+    check_filter_line(AV_PIX_FMT_YUV420P16);
+    report("yadif_filter_line_16bit");
+}
@@ -21,6 +21,11 @@ fate-api-seek: $(APITESTSDIR)/api-seek-test$(EXESUF) fate-lavf-flv
 fate-api-seek: CMD = run $(APITESTSDIR)/api-seek-test$(EXESUF) $(TARGET_PATH)/tests/data/lavf/lavf.flv 0 720
 fate-api-seek: CMP = null
 
+FATE_API_LIBAVFORMAT-$(call ENCDEC2, MPEG4, MP2, MATROSKA) += fate-api-probecache
+fate-api-probecache: $(APITESTSDIR)/api-probecache-test$(EXESUF) fate-lavf-mkv
+fate-api-probecache: CMD = run $(APITESTSDIR)/api-probecache-test$(EXESUF) $(TARGET_PATH)/tests/data/lavf/lavf.mkv $(TARGET_PATH)/tests/data/probecache
+fate-api-probecache: CMP = null
+
 FATE_API_SAMPLES_LIBAVFORMAT-$(call DEMDEC, IMAGE2, PNG) += fate-api-png-codec-param
 fate-api-png-codec-param: $(APITESTSDIR)/api-codec-param-test$(EXESUF)
 fate-api-png-codec-param: CMD = run $(APITESTSDIR)/api-codec-param-test$(EXESUF) $(TARGET_SAMPLES)/png1/lena-rgba.png
@@ -34,6 +39,11 @@ fate-api-threadmessage: $(APITESTSDIR)/api-threadmessage-test$(EXESUF)
 fate-api-threadmessage: CMD = run $(APITESTSDIR)/api-threadmessage-test$(EXESUF) 3 10 30 50 2 20 40
 fate-api-threadmessage: CMP = null
 
+FATE_API-$(HAVE_THREADS) += fate-api-threadmessage-spsc
+fate-api-threadmessage-spsc: $(APITESTSDIR)/api-threadmessage-test$(EXESUF)
+fate-api-threadmessage-spsc: CMD = run $(APITESTSDIR)/api-threadmessage-test$(EXESUF) 10 1 30 50 1 20 40 spsc
+fate-api-threadmessage-spsc: CMP = null
+
 FATE_API_SAMPLES-$(CONFIG_AVFORMAT) += $(FATE_API_SAMPLES_LIBAVFORMAT-yes)
 
 ifdef SAMPLES
@@ -1,7 +1,11 @@
 FATE_CHECKASM = fate-checkasm-aacpsdsp                                  \
                 fate-checkasm-af_afir                                   \
+                fate-checkasm-af_anlmdn                                 \
+                fate-checkasm-af_volume                                 \
                 fate-checkasm-alacdsp                                   \
                 fate-checkasm-audiodsp                                  \
+                fate-checkasm-av_tx                                     \
+                fate-checkasm-avf_showcqt                               \
                 fate-checkasm-blockdsp                                  \
                 fate-checkasm-bswapdsp                                  \
                 fate-checkasm-exrdsp                                    \
@@ -15,24 +19,47 @@ FATE_CHECKASM = fate-checkasm-aacpsdsp                                  \
                 fate-checkasm-h264qpel                                  \
                 fate-checkasm-hevc_add_res                              \
                 fate-checkasm-hevc_idct                                 \
+                fate-checkasm-hevc_pred                                 \
                 fate-checkasm-hevc_sao                                  \
                 fate-checkasm-jpeg2000dsp                               \
                 fate-checkasm-llviddsp                                  \
                 fate-checkasm-llviddspenc                               \
                 fate-checkasm-opusdsp                                   \
                 fate-checkasm-pixblockdsp                               \
+                fate-checkasm-proresencdsp                              \
                 fate-checkasm-sbrdsp                                    \
+                fate-checkasm-scene_sad                                 \
                 fate-checkasm-synth_filter                              \
                 fate-checkasm-sw_rgb                                    \
                 fate-checkasm-sw_scale                                  \
                 fate-checkasm-v210dec                                   \
                 fate-checkasm-v210enc                                   \
+                fate-checkasm-vf_atadenoise                             \
                 fate-checkasm-vf_blend                                  \
+                fate-checkasm-vf_bwdif                                  \
                 fate-checkasm-vf_colorspace                             \
+                fate-checkasm-vf_convolution                            \
                 fate-checkasm-vf_eq                                     \
+                fate-checkasm-vf_framerate                              \
+                fate-checkasm-vf_fspp                                   \
                 fate-checkasm-vf_gblur                                  \
+                fate-checkasm-vf_gradfun                                \
                 fate-checkasm-vf_hflip                                  \
+                fate-checkasm-vf_idet                                   \
+                fate-checkasm-vf_limiter                                \
+                fate-checkasm-vf_maskedclamp                            \
+                fate-checkasm-vf_maskedmerge                            \
+                fate-checkasm-vf_pp7                                    \
+                fate-checkasm-vf_psnr                                   \
+                fate-checkasm-vf_pullup                                 \
+                fate-checkasm-vf_ssim                                   \
+                fate-checkasm-vf_stereo3d                               \
                 fate-checkasm-vf_threshold                              \
+                fate-checkasm-vf_tinterlace                             \
+                fate-checkasm-vf_transpose                              \
+                fate-checkasm-vf_v360                                   \
+                fate-checkasm-vf_w3fdif                                 \
+                fate-checkasm-vf_yadif                                  \
                 fate-checkasm-videodsp                                  \
                 fate-checkasm-vp8dsp                                    \
                 fate-checkasm-vp9dsp                                    \
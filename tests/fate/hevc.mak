@@ -230,7 +230,22 @@ FATE_HEVC_LARGE += fate-hevc-conformance-$(1)
 fate-hevc-conformance-$(1): CMD = framecrc -flags unaligned -i $(TARGET_SAMPLES)/hevc-conformance/$(1).bit -pix_fmt yuv444p12le
 endef
 
+# streams without WPP, with the in-loop filters run on the slice threads
+HEVC_SAMPLES_PARALLEL_FILTER =  \
+    DBLK_A_SONY_3               \
+    DBLK_E_VIXS_2               \
+    SAO_A_MediaTek_4            \
+    SLICES_A_Rovi_3             \
+    TILES_A_Cisco_2             \
+
+define FATE_HEVC_TEST_PARALLEL_FILTER
+FATE_HEVC += fate-hevc-conformance-parallel-filter-$(1)
+fate-hevc-conformance-parallel-filter-$(1): CMD = framecrc -flags unaligned -vsync drop -threads 4 -thread_type slice -parallel_filter 1 -i $(TARGET_SAMPLES)/hevc-conformance/$(1).bit -pix_fmt yuv420p
+fate-hevc-conformance-parallel-filter-$(1): REF = $(SRC_PATH)/tests/ref/fate/hevc-conformance-$(1)
+endef
+
 $(foreach N,$(HEVC_SAMPLES),$(eval $(call FATE_HEVC_TEST,$(N))))
+$(foreach N,$(HEVC_SAMPLES_PARALLEL_FILTER),$(eval $(call FATE_HEVC_TEST_PARALLEL_FILTER,$(N))))
 $(foreach N,$(HEVC_SAMPLES_10BIT),$(eval $(call FATE_HEVC_TEST_10BIT,$(N))))
 $(foreach N,$(HEVC_SAMPLES_422_10BIT),$(eval $(call FATE_HEVC_TEST_422_10BIT,$(N))))
 $(foreach N,$(HEVC_SAMPLES_422_10BIN),$(eval $(call FATE_HEVC_TEST_422_10BIN,$(N))))
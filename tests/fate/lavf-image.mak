@@ -5,6 +5,12 @@ FATE_LAVF_IMAGES-$(call ENCDEC,  DPX,            IMAGE2)             += gbrp12le
 FATE_LAVF_IMAGES-$(call ENCDEC,  DPX,            IMAGE2)             += rgb48le.dpx
 FATE_LAVF_IMAGES-$(call ENCDEC,  DPX,            IMAGE2)             += rgb48le_10.dpx
 FATE_LAVF_IMAGES-$(call ENCDEC,  DPX,            IMAGE2)             += rgba64le.dpx
+FATE_LAVF_IMAGES-$(call ENCDEC,  EXR,            IMAGE2)             += gbrpf32le.exr
+FATE_LAVF_IMAGES-$(call ENCDEC,  EXR,            IMAGE2)             += gbrapf32le_half_piz.exr
+FATE_LAVF_IMAGES-$(call ENCDEC,  EXR,            IMAGE2)             += gbrpf32le_half_rle.exr
+FATE_LAVF_IMAGES-$(call ENCDEC,  EXR,            IMAGE2)             += gbrpf32le_zip1.exr
+FATE_LAVF_IMAGES-$(call ENCDEC,  EXR,            IMAGE2)             += gbrapf32le_half_zip16.exr
+FATE_LAVF_IMAGES-$(call ENCDEC,  EXR,            IMAGE2)             += gbrapf32le_half_piz_slices.exr
 FATE_LAVF_IMAGES-$(call ENCDEC,  MJPEG,          IMAGE2)             += jpg
 FATE_LAVF_IMAGES-$(call ENCDEC,  PAM,            IMAGE2)             += pam
 FATE_LAVF_IMAGES-$(call ENCDEC,  PAM,            IMAGE2)             += rgba.pam
@@ -45,6 +51,12 @@ fate-lavf-gbrp12le.dpx: CMD = lavf_image "-pix_fmt gbrp12le" "-pix_fmt gbrp12le"
 fate-lavf-rgb48le.dpx: CMD = lavf_image "-pix_fmt rgb48le"
 fate-lavf-rgb48le_10.dpx: CMD = lavf_image "-pix_fmt rgb48le -bits_per_raw_sample 10" "-pix_fmt rgb48le"
 fate-lavf-rgba64le.dpx: CMD = lavf_image "-pix_fmt rgba64le"
+fate-lavf-gbrpf32le.exr: CMD = lavf_image "-pix_fmt gbrpf32le" "-pix_fmt gbrpf32le"
+fate-lavf-gbrapf32le_half_piz.exr: CMD = lavf_image "-pix_fmt gbrapf32le -format half -compression piz" "-pix_fmt gbrapf32le"
+fate-lavf-gbrpf32le_half_rle.exr: CMD = lavf_image "-pix_fmt gbrpf32le -format half -compression rle" "-pix_fmt gbrpf32le"
+fate-lavf-gbrpf32le_zip1.exr: CMD = lavf_image "-pix_fmt gbrpf32le -compression zip1" "-pix_fmt gbrpf32le"
+fate-lavf-gbrapf32le_half_zip16.exr: CMD = lavf_image "-pix_fmt gbrapf32le -format half -compression zip16" "-pix_fmt gbrapf32le"
+fate-lavf-gbrapf32le_half_piz_slices.exr: CMD = lavf_image "-pix_fmt gbrapf32le -format half -compression piz -threads 4 -thread_type slice" "-pix_fmt gbrapf32le"
 fate-lavf-rgba.pam: CMD = lavf_image "-pix_fmt rgba"
 fate-lavf-gray.pam: CMD = lavf_image "-pix_fmt gray"
 fate-lavf-gray16be.pam: CMD = lavf_image "-pix_fmt gray16be" "-pix_fmt gray16be"
@@ -3,6 +3,15 @@ fate-avpacket: libavcodec/tests/avpacket$(EXESUF)
 fate-avpacket: CMD = run libavcodec/tests/avpacket$(EXESUF)
 fate-avpacket: CMP = null
 
+FATE_LIBAVCODEC-$(CONFIG_GOLOMB) += fate-bitstream fate-bitstream-cached
+fate-bitstream: libavcodec/tests/bitstream$(EXESUF)
+fate-bitstream: CMD = run libavcodec/tests/bitstream$(EXESUF)
+fate-bitstream: CMP = null
+
+fate-bitstream-cached: libavcodec/tests/bitstream-cached$(EXESUF)
+fate-bitstream-cached: CMD = run libavcodec/tests/bitstream-cached$(EXESUF)
+fate-bitstream-cached: CMP = null
+
 FATE_LIBAVCODEC-$(CONFIG_CABAC) += fate-cabac
 fate-cabac: libavcodec/tests/cabac$(EXESUF)
 fate-cabac: CMD = run libavcodec/tests/cabac$(EXESUF)